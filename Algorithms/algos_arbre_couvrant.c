@@ -0,0 +1,501 @@
+/* algos_arbre_couvrant.c Minimum spanning forests: Kruskal, Prim (heap and matrix), Boruvka */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "algos_arbre_couvrant.h"
+#include "FilePriorite.h"
+#include "UnionFind.h"
+#include "Parallele.h"
+#include "Instrumentation.h"
+
+#define TRI_SEUIL_PARALLELE 65536 /* fewer edges are sorted on one thread */
+
+/* Order-preserving map of a weight to an unsigned key */
+static inline uint32_t cle_poids(int poids) {
+    return (uint32_t)poids ^ 0x80000000u;
+}
+
+static ArbreCouvrant *arbre_creer(int n) {
+    ArbreCouvrant *a = (ArbreCouvrant *)calloc(1, sizeof(ArbreCouvrant));
+    if (!a) return NULL;
+    a->aretes = (TripletArc *)malloc((n > 1 ? (size_t)n - 1 : 1) * sizeof(TripletArc));
+    if (!a->aretes) {
+        free(a);
+        return NULL;
+    }
+    a->nb_sommets = n;
+    a->nb_composantes = n;
+    return a;
+}
+
+static void arbre_ajouter(ArbreCouvrant *a, int u, int v, int poids) {
+    TripletArc *t = &a->aretes[a->nb_aretes++];
+    t->u = u;
+    t->v = v;
+    t->poids = poids;
+    a->poids_total += poids;
+    a->nb_composantes--;
+}
+
+void arbre_couvrant_detruire(ArbreCouvrant *a) {
+    if (!a) return;
+    free(a->aretes);
+    free(a);
+}
+
+/* ---------- Edge list of a snapshot ---------- */
+
+typedef struct {
+    int nb;
+    int *u;
+    int *v;
+    int *poids;
+} ListeAretes;
+
+static void aretes_liberer(ListeAretes *l) {
+    free(l->u);
+    free(l->v);
+    free(l->poids);
+}
+
+/* Each edge once (u < v) for a non oriented snapshot, every arc but the
+   loops for an oriented one */
+static int aretes_extraire(const GrapheCSR *g, ListeAretes *l) {
+    int n = graphe_csr_ordre(g), nb = 0;
+    for (int u = 0; u < n; ++u)
+        for (int k = g->debut[u]; k < g->debut[u + 1]; ++k)
+            if (g->oriente ? g->dest[k] != u : g->dest[k] > u) nb++;
+    size_t taille = (nb > 0 ? (size_t)nb : 1) * sizeof(int);
+    l->nb = nb;
+    l->u = (int *)malloc(taille);
+    l->v = (int *)malloc(taille);
+    l->poids = (int *)malloc(taille);
+    if (!l->u || !l->v || !l->poids) {
+        aretes_liberer(l);
+        return 0;
+    }
+    int i = 0;
+    for (int u = 0; u < n; ++u)
+        for (int k = g->debut[u]; k < g->debut[u + 1]; ++k)
+            if (g->oriente ? g->dest[k] != u : g->dest[k] > u) {
+                l->u[i] = u;
+                l->v[i] = g->dest[k];
+                l->poids[i] = g->poids[k];
+                i++;
+            }
+    return 1;
+}
+
+/* ---------- Kruskal ---------- */
+
+/* LSD radix sort of (cle, indice) by cle, 8 bits per pass; the passes on
+   digits equal in every key are skipped. Each thread histograms then
+   scatters its own slice, the slices keeping their order, so every pass
+   is stable. */
+typedef struct {
+    uint32_t *cle[2];
+    int *indice[2];
+    int nb;
+    int decalages[4];
+    int nb_passes;
+    int *compteurs;  /* 256 per thread */
+    BarriereParallele barriere;
+} EtatTri;
+
+static void tache_tri(int id, int nb, void *arg) {
+    EtatTri *e = (EtatTri *)arg;
+    int debut = (int)((long long)e->nb * id / nb);
+    int fin = (int)((long long)e->nb * (id + 1) / nb);
+    int *h = e->compteurs + 256 * id;
+    for (int p = 0; p < e->nb_passes; ++p) {
+        const uint32_t *cs = e->cle[p & 1];
+        const int *is = e->indice[p & 1];
+        uint32_t *cd = e->cle[(p + 1) & 1];
+        int *id_dst = e->indice[(p + 1) & 1];
+        int dec = e->decalages[p];
+        memset(h, 0, 256 * sizeof(int));
+        for (int i = debut; i < fin; ++i) h[(cs[i] >> dec) & 255]++;
+        parallele_barriere_attendre(&e->barriere);
+        if (id == 0) {
+            int total = 0;
+            for (int d = 0; d < 256; ++d)
+                for (int t = 0; t < nb; ++t) {
+                    int c = e->compteurs[256 * t + d];
+                    e->compteurs[256 * t + d] = total;
+                    total += c;
+                }
+        }
+        parallele_barriere_attendre(&e->barriere);
+        for (int i = debut; i < fin; ++i) {
+            int pos = h[(cs[i] >> dec) & 255]++;
+            cd[pos] = cs[i];
+            id_dst[pos] = is[i];
+        }
+        parallele_barriere_attendre(&e->barriere);
+    }
+}
+
+/* Indices of the edges by increasing weight, NULL on error */
+static int *trier_aretes(const ListeAretes *l, int nb_threads) {
+    int m = l->nb;
+    size_t taille = (m > 0 ? (size_t)m : 1);
+    EtatTri e;
+    memset(&e, 0, sizeof(e));
+    e.nb = m;
+    e.cle[0] = (uint32_t *)malloc(taille * sizeof(uint32_t));
+    e.cle[1] = (uint32_t *)malloc(taille * sizeof(uint32_t));
+    e.indice[0] = (int *)malloc(taille * sizeof(int));
+    e.indice[1] = (int *)malloc(taille * sizeof(int));
+    nb_threads = m < TRI_SEUIL_PARALLELE ? 1 : parallele_resoudre_nb_threads(nb_threads);
+    e.compteurs = (int *)malloc((size_t)nb_threads * 256 * sizeof(int));
+    int ok = e.cle[0] && e.cle[1] && e.indice[0] && e.indice[1] && e.compteurs;
+    if (ok) {
+        uint32_t et = 0xffffffffu, ou = 0;
+        for (int i = 0; i < m; ++i) {
+            uint32_t c = cle_poids(l->poids[i]);
+            e.cle[0][i] = c;
+            e.indice[0][i] = i;
+            et &= c;
+            ou |= c;
+        }
+        for (int dec = 0; dec < 32; dec += 8)
+            if (((et ^ ou) >> dec) & 255) e.decalages[e.nb_passes++] = dec;
+        if (e.nb_passes > 0) {
+            ok = parallele_barriere_init(&e.barriere, nb_threads);
+            if (ok) {
+                ok = parallele_executer(nb_threads, tache_tri, &e);
+                parallele_barriere_detruire(&e.barriere);
+            }
+        }
+    }
+    int *resultat = ok ? e.indice[e.nb_passes & 1] : NULL;
+    free(e.cle[0]);
+    free(e.cle[1]);
+    if (e.indice[0] != resultat) free(e.indice[0]);
+    if (e.indice[1] != resultat) free(e.indice[1]);
+    free(e.compteurs);
+    return resultat;
+}
+
+ArbreCouvrant *arbre_couvrant_kruskal_csr(const GrapheCSR *g, int nb_threads) {
+    if (!g || !graphe_csr_est_value(g)) return NULL;
+    int n = graphe_csr_ordre(g);
+    ListeAretes l;
+    if (!aretes_extraire(g, &l)) return NULL;
+    ArbreCouvrant *a = arbre_creer(n);
+    UnionFind *uf = union_find_creer(n);
+    INSTR_PHASE_DEBUT(tri, "arbre_couvrant_kruskal/tri");
+    int *ordre = a && uf ? trier_aretes(&l, nb_threads) : NULL;
+    INSTR_PHASE_FIN(tri);
+    if (ordre) {
+        INSTR_PHASE_DEBUT(fusion, "arbre_couvrant_kruskal/fusion");
+        for (int i = 0; i < l.nb && union_find_nb_classes(uf) > 1; ++i) {
+            int k = ordre[i];
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (union_find_unir(uf, l.u[k], l.v[k])) arbre_ajouter(a, l.u[k], l.v[k], l.poids[k]);
+        }
+        INSTR_PHASE_FIN(fusion);
+    } else {
+        arbre_couvrant_detruire(a);
+        a = NULL;
+    }
+    free(ordre);
+    union_find_detruire(uf);
+    aretes_liberer(&l);
+    return a;
+}
+
+ArbreCouvrant *arbre_couvrant_kruskal(GrapheValueListe *g, int nb_threads) {
+    INSTR_PHASE_DEBUT(gel, "arbre_couvrant_kruskal/gel");
+    GrapheCSR *c = graphe_csr_depuis_value_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return NULL;
+    ArbreCouvrant *a = arbre_couvrant_kruskal_csr(c, nb_threads);
+    graphe_csr_detruire(c);
+    return a;
+}
+
+/* ---------- Prim ---------- */
+
+static void prim_relacher(FilePriorite *file, const unsigned char *dans_arbre, int *lien,
+                          int u, const ArcValueListe *arc) {
+    for (; arc; arc = arc->suivant) {
+        int v = arc->dest;
+        INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+        if (dans_arbre[v]) continue;
+        if (!file_priorite_contient(file, v) || arc->poids < file->cle[v]) {
+            file_priorite_inserer(file, v, arc->poids);
+            lien[v] = u;
+        }
+    }
+}
+
+ArbreCouvrant *arbre_couvrant_prim(GrapheValueListe *g) {
+    if (!g) return NULL;
+    int n = graphe_value_liste_ordre(g);
+    int oriente = graphe_value_liste_est_oriente(g);
+    int predecesseurs = oriente && !graphe_value_liste_predecesseurs_actifs(g);
+    if (predecesseurs && !graphe_value_liste_activer_predecesseurs(g)) return NULL;
+
+    ArbreCouvrant *a = arbre_creer(n);
+    FilePriorite *file = file_priorite_creer(n > 0 ? n : 1);
+    unsigned char *dans_arbre = (unsigned char *)calloc(n > 0 ? n : 1, 1);
+    int *lien = (int *)malloc((n > 0 ? (size_t)n : 1) * sizeof(int));
+    if (!a || !file || !dans_arbre || !lien) {
+        arbre_couvrant_detruire(a);
+        a = NULL;
+    } else {
+        INSTR_PHASE_DEBUT(phase, "arbre_couvrant_prim");
+        /* one tree per component, each grown from its smallest vertex */
+        for (int racine = 0; racine < n; ++racine) {
+            if (dans_arbre[racine]) continue;
+            lien[racine] = -1;
+            file_priorite_inserer(file, racine, 0);
+            while (!file_priorite_est_vide(file)) {
+                int poids;
+                int u = file_priorite_extraire_min(file, &poids);
+                dans_arbre[u] = 1;
+                if (lien[u] >= 0) arbre_ajouter(a, lien[u], u, poids);
+                prim_relacher(file, dans_arbre, lien, u, graphe_value_liste_voisins(g, u));
+                if (oriente) prim_relacher(file, dans_arbre, lien, u, graphe_value_liste_predecesseurs(g, u));
+            }
+        }
+        INSTR_PHASE_FIN(phase);
+    }
+
+    file_priorite_detruire(file);
+    free(dans_arbre);
+    free(lien);
+    if (predecesseurs) graphe_value_liste_desactiver_predecesseurs(g);
+    return a;
+}
+
+/* Lightest of u -> v and v -> u, 0 without any (weights go up to INT_MAX) */
+static inline int poids_arete_matrice(const GrapheValueMatrice *g, int oriente, int u, int v) {
+    int r = graphe_value_matrice_obtenir_poids(g, u, v);
+    if (oriente) {
+        int w = graphe_value_matrice_obtenir_poids(g, v, u);
+        if (w > 0 && (r <= 0 || w < r)) r = w;
+    }
+    return r > 0 ? r : 0;
+}
+
+ArbreCouvrant *arbre_couvrant_prim_matrice(const GrapheValueMatrice *g) {
+    if (!g) return NULL;
+    int n = graphe_value_matrice_ordre(g);
+    int oriente = graphe_value_matrice_est_oriente(g);
+    ArbreCouvrant *a = arbre_creer(n);
+    int *cle = (int *)malloc((n > 0 ? (size_t)n : 1) * sizeof(int));
+    int *lien = (int *)malloc((n > 0 ? (size_t)n : 1) * sizeof(int));
+    /* vertices not yet in a tree, kept packed so each scan shrinks */
+    int *restants = (int *)malloc((n > 0 ? (size_t)n : 1) * sizeof(int));
+    if (!a || !cle || !lien || !restants) {
+        arbre_couvrant_detruire(a);
+        free(cle);
+        free(lien);
+        free(restants);
+        return NULL;
+    }
+
+    INSTR_PHASE_DEBUT(phase, "arbre_couvrant_prim_matrice");
+    /* lien[v] = -1: no edge from the trees reaches v yet, cle[v] unused */
+    for (int v = 0; v < n; ++v) {
+        cle[v] = 0;
+        lien[v] = -1;
+        restants[v] = v;
+    }
+    int nb_restants = n;
+    while (nb_restants > 0) {
+        /* lightest edge into the tree; a new tree starts when there is none */
+        int meilleur = 0;
+        for (int i = 1; i < nb_restants; ++i) {
+            int v = restants[i], m = restants[meilleur];
+            if (lien[v] < 0 ? lien[m] < 0 && v < m
+                            : lien[m] < 0 || cle[v] < cle[m] || (cle[v] == cle[m] && v < m))
+                meilleur = i;
+        }
+        int u = restants[meilleur];
+        restants[meilleur] = restants[--nb_restants];
+        if (lien[u] >= 0) arbre_ajouter(a, lien[u], u, cle[u]);
+        for (int i = 0; i < nb_restants; ++i) {
+            int v = restants[i];
+            int w = poids_arete_matrice(g, oriente, u, v);
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (w > 0 && (lien[v] < 0 || w < cle[v])) {
+                cle[v] = w;
+                lien[v] = u;
+            }
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    free(cle);
+    free(lien);
+    free(restants);
+    return a;
+}
+
+/* ---------- Boruvka ---------- */
+
+/* Threads own a fixed slice of the edge list and keep it compacted to
+   the edges still joining two components. */
+typedef struct {
+    ListeAretes *l;
+    int n;
+    int *composante;     /* representative of each vertex for the round */
+    uint64_t *meilleure; /* per representative: (weight key << 32) | edge, UINT64_MAX = none */
+    UnionFind *uf;
+    ArbreCouvrant *a;
+    int *vivantes;       /* live edges at the start of each slice */
+    int fini;
+    BarriereParallele barriere;
+} EtatBoruvka;
+
+/* Read-only walk to the root, the parents only change while thread 0
+   merges, between two barriers */
+static int racine(const UnionFind *uf, int x) {
+    while (uf->parent[x] != x) x = uf->parent[x];
+    return x;
+}
+
+static void tache_boruvka(int id, int nb, void *arg) {
+    EtatBoruvka *e = (EtatBoruvka *)arg;
+    ListeAretes *l = e->l;
+    int debut = (int)((long long)l->nb * id / nb);
+    int v_debut = (int)((long long)e->n * id / nb);
+    int v_fin = (int)((long long)e->n * (id + 1) / nb);
+    for (;;) {
+        for (int v = v_debut; v < v_fin; ++v) e->meilleure[v] = UINT64_MAX;
+        parallele_barriere_attendre(&e->barriere);
+
+        int k = debut;
+        for (int i = debut; i < debut + e->vivantes[id]; ++i) {
+            int cu = e->composante[l->u[i]], cv = e->composante[l->v[i]];
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (cu == cv) continue;
+            l->u[k] = l->u[i];
+            l->v[k] = l->v[i];
+            l->poids[k] = l->poids[i];
+            uint64_t c = (uint64_t)cle_poids(l->poids[k]) << 32 | (uint32_t)k;
+            parallele_min_atomique_u64(&e->meilleure[cu], c);
+            parallele_min_atomique_u64(&e->meilleure[cv], c);
+            k++;
+        }
+        e->vivantes[id] = k - debut;
+        parallele_barriere_attendre(&e->barriere);
+
+        if (id == 0) {
+            int fusions = 0;
+            for (int v = 0; v < e->n; ++v) {
+                if (e->composante[v] != v || e->meilleure[v] == UINT64_MAX) continue;
+                int i = (int)(uint32_t)e->meilleure[v];
+                /* both ends may pick the same edge: the second union fails */
+                if (union_find_unir(e->uf, l->u[i], l->v[i])) {
+                    arbre_ajouter(e->a, l->u[i], l->v[i], l->poids[i]);
+                    fusions++;
+                }
+            }
+            e->fini = fusions == 0;
+        }
+        parallele_barriere_attendre(&e->barriere);
+        if (e->fini) break;
+
+        for (int v = v_debut; v < v_fin; ++v) e->composante[v] = racine(e->uf, v);
+        parallele_barriere_attendre(&e->barriere);
+    }
+}
+
+ArbreCouvrant *arbre_couvrant_boruvka_csr(const GrapheCSR *g, int nb_threads) {
+    if (!g || !graphe_csr_est_value(g)) return NULL;
+    int n = graphe_csr_ordre(g);
+    ListeAretes l;
+    if (!aretes_extraire(g, &l)) return NULL;
+    nb_threads = parallele_resoudre_nb_threads(nb_threads);
+
+    EtatBoruvka e;
+    memset(&e, 0, sizeof(e));
+    e.l = &l;
+    e.n = n;
+    e.a = arbre_creer(n);
+    e.uf = union_find_creer(n);
+    e.composante = (int *)malloc((n > 0 ? (size_t)n : 1) * sizeof(int));
+    e.meilleure = (uint64_t *)malloc((n > 0 ? (size_t)n : 1) * sizeof(uint64_t));
+    e.vivantes = (int *)malloc((size_t)nb_threads * sizeof(int));
+    int ok = e.a && e.uf && e.composante && e.meilleure && e.vivantes;
+    if (ok) {
+        for (int v = 0; v < n; ++v) e.composante[v] = v;
+        for (int t = 0; t < nb_threads; ++t)
+            e.vivantes[t] = (int)((long long)l.nb * (t + 1) / nb_threads - (long long)l.nb * t / nb_threads);
+        ok = parallele_barriere_init(&e.barriere, nb_threads);
+    }
+    if (ok) {
+        INSTR_PHASE_DEBUT(phase, "arbre_couvrant_boruvka");
+        ok = parallele_executer(nb_threads, tache_boruvka, &e);
+        INSTR_PHASE_FIN(phase);
+        parallele_barriere_detruire(&e.barriere);
+    }
+    if (!ok) {
+        arbre_couvrant_detruire(e.a);
+        e.a = NULL;
+    }
+    union_find_detruire(e.uf);
+    free(e.composante);
+    free(e.meilleure);
+    free(e.vivantes);
+    aretes_liberer(&l);
+    return e.a;
+}
+
+ArbreCouvrant *arbre_couvrant_boruvka(GrapheValueListe *g, int nb_threads) {
+    INSTR_PHASE_DEBUT(gel, "arbre_couvrant_boruvka/gel");
+    GrapheCSR *c = graphe_csr_depuis_value_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return NULL;
+    ArbreCouvrant *a = arbre_couvrant_boruvka_csr(c, nb_threads);
+    graphe_csr_detruire(c);
+    return a;
+}
+
+/* ---------- Engine choice ---------- */
+
+MoteurArbre arbre_couvrant_moteur_conseille(int nb_sommets, long long nb_aretes, int nb_threads) {
+    /* threads beyond the processors only add synchronization */
+    int processeurs = parallele_nb_threads_defaut();
+    nb_threads = parallele_resoudre_nb_threads(nb_threads);
+    if (nb_threads > processeurs) nb_threads = processeurs;
+    if (nb_sommets <= 0) return ARBRE_KRUSKAL;
+    /* half the pairs or more: the matrix scan reads no more than the lists */
+    if (nb_aretes >= (long long)nb_sommets * (nb_sommets - 1) / 4) return ARBRE_PRIM_MATRICE;
+    /* from about 32 neighbors per vertex, the heap stays small next to
+       the edges Kruskal has to sort */
+    if (2 * nb_aretes >= 32LL * nb_sommets) return ARBRE_PRIM;
+    /* the sort runs on all the threads but the union-find pass does not */
+    if (nb_threads >= 4 && nb_aretes >= (1LL << 20)) return ARBRE_BORUVKA;
+    return ARBRE_KRUSKAL;
+}
+
+const char *arbre_couvrant_nom_moteur(MoteurArbre m) {
+    switch (m) {
+    case ARBRE_KRUSKAL:      return "kruskal";
+    case ARBRE_PRIM:         return "prim";
+    case ARBRE_PRIM_MATRICE: return "prim_matrice";
+    case ARBRE_BORUVKA:      return "boruvka";
+    }
+    return "?";
+}
+
+ArbreCouvrant *arbre_couvrant(GrapheValueListe *g, int nb_threads) {
+    if (!g) return NULL;
+    int n = graphe_value_liste_ordre(g);
+    long long m = 0;
+    for (int v = 0; v < n; ++v) m += graphe_value_liste_degre_sortant(g, v);
+    if (!graphe_value_liste_est_oriente(g)) m /= 2;
+    switch (arbre_couvrant_moteur_conseille(n, m, nb_threads)) {
+    case ARBRE_BORUVKA:      return arbre_couvrant_boruvka(g, nb_threads);
+    case ARBRE_PRIM:
+    case ARBRE_PRIM_MATRICE: return arbre_couvrant_prim(g);
+    case ARBRE_KRUSKAL:      break;
+    }
+    return arbre_couvrant_kruskal(g, nb_threads);
+}
@@ -0,0 +1,65 @@
+/* algos_arbre_couvrant.h */
+#ifndef ALGOS_ARBRE_COUVRANT_H
+#define ALGOS_ARBRE_COUVRANT_H
+
+#include "GrapheValueListe.h"
+#include "GrapheValueMatrice.h"
+#include "GrapheCSR.h"
+
+/* Minimum spanning forests: one minimum spanning tree per connected
+   component. Arcs of oriented graphs are taken as edges, whatever their
+   direction. All engines give the same total weight; the edges
+   themselves may differ between engines when weights are tied.
+
+   - Kruskal: the edges sorted by weight (LSD radix sort, each pass
+     shared between nb_threads threads), then added in that order unless
+     a UnionFind says they close a cycle. O(E + V alpha(V)) after the sort.
+   - Prim with the 4-ary heap, on the adjacency lists: O(E log V).
+   - Prim with an array scan, on the weight matrix: O(V^2), no heap and
+     no edge list, best when the graph is dense.
+   - Boruvka: each round every component picks its lightest outgoing edge
+     (ties broken by edge position, so no cycle can form) and the
+     components merge; at least half of them disappear per round. The
+     edge scan of a round is shared between nb_threads threads.
+
+   nb_threads <= 0 means one thread per processor. The list versions of
+   Kruskal and Boruvka freeze the graph to CSR first. */
+
+typedef struct {
+    int nb_sommets;
+    int nb_composantes;   /* trees of the forest, isolated vertices included */
+    int nb_aretes;        /* nb_sommets - nb_composantes */
+    long long poids_total;
+    TripletArc *aretes;   /* edges of the forest (u, v, poids) */
+} ArbreCouvrant;
+
+typedef enum {
+    ARBRE_KRUSKAL = 0,
+    ARBRE_PRIM,           /* heap, adjacency lists */
+    ARBRE_PRIM_MATRICE,   /* array scan, weight matrix */
+    ARBRE_BORUVKA
+} MoteurArbre;
+
+/* NULL on error (memory, thread creation, unweighted snapshot) */
+ArbreCouvrant *arbre_couvrant_kruskal_csr(const GrapheCSR *g, int nb_threads);
+ArbreCouvrant *arbre_couvrant_kruskal(GrapheValueListe *g, int nb_threads);
+/* Enables the predecessor lists of an oriented graph for the run */
+ArbreCouvrant *arbre_couvrant_prim(GrapheValueListe *g);
+ArbreCouvrant *arbre_couvrant_prim_matrice(const GrapheValueMatrice *g);
+ArbreCouvrant *arbre_couvrant_boruvka_csr(const GrapheCSR *g, int nb_threads);
+ArbreCouvrant *arbre_couvrant_boruvka(GrapheValueListe *g, int nb_threads);
+void arbre_couvrant_detruire(ArbreCouvrant *a);
+
+/* Engine for nb_sommets vertices and nb_aretes edges, from the
+   measurements of bench_arbre_couvrant: the matrix scan from half of
+   the pairs on, the heap from about 32 neighbors per vertex, Boruvka
+   for large sparse graphs when 4 processors or more are used, Kruskal
+   otherwise. nb_threads is capped to the processors. */
+MoteurArbre arbre_couvrant_moteur_conseille(int nb_sommets, long long nb_aretes, int nb_threads);
+const char *arbre_couvrant_nom_moteur(MoteurArbre m);
+
+/* The engine arbre_couvrant_moteur_conseille picks (the heap Prim
+   when it suggests the matrix) */
+ArbreCouvrant *arbre_couvrant(GrapheValueListe *g, int nb_threads);
+
+#endif /* ALGOS_ARBRE_COUVRANT_H */
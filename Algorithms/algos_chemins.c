@@ -0,0 +1,387 @@
+/* algos_chemins.c */
+#include <stdlib.h>
+#include <string.h>
+#include "algos_chemins.h"
+#include "FilePriorite.h"
+#include "Instrumentation.h"
+
+#define INF 1000000000
+
+#define AVANT   0 /* search from the source, along the arcs */
+#define ARRIERE 1 /* search from the target, against the arcs */
+
+struct ContexteChemin {
+    GrapheValueListe *g;
+    int capacite;
+    int predecesseurs_temporaires; /* enabled by the context */
+    /* a vertex holds valid values only if epoque[v] == epoque_courante,
+       so a query resets just the vertices it touches */
+    unsigned *epoque;
+    unsigned epoque_courante;
+    int *dist[2];
+    int *pred[2];          /* pred[ARRIERE][v] = next vertex towards the target */
+    unsigned char *regle;  /* bit 1 << side: settled by that search */
+    FilePriorite *file[2];
+    int *sommets;          /* path of the last query */
+};
+
+static void contexte_liberer_tableaux(ContexteChemin *c) {
+    free(c->epoque);
+    for (int s = 0; s < 2; ++s) {
+        free(c->dist[s]);
+        free(c->pred[s]);
+        file_priorite_detruire(c->file[s]);
+        c->dist[s] = c->pred[s] = NULL;
+        c->file[s] = NULL;
+    }
+    free(c->regle);
+    free(c->sommets);
+    c->epoque = NULL;
+    c->regle = NULL;
+    c->sommets = NULL;
+    c->capacite = 0;
+}
+
+static int contexte_allouer(ContexteChemin *c, int capacite) {
+    contexte_liberer_tableaux(c);
+    c->epoque = (unsigned *)calloc(capacite, sizeof(unsigned));
+    c->regle = (unsigned char *)malloc(capacite);
+    c->sommets = (int *)malloc(capacite * sizeof(int));
+    int ok = c->epoque && c->regle && c->sommets;
+    for (int s = 0; s < 2; ++s) {
+        c->dist[s] = (int *)malloc(capacite * sizeof(int));
+        c->pred[s] = (int *)malloc(capacite * sizeof(int));
+        c->file[s] = file_priorite_creer(capacite);
+        ok = ok && c->dist[s] && c->pred[s] && c->file[s];
+    }
+    if (!ok) {
+        contexte_liberer_tableaux(c);
+        return 0;
+    }
+    c->capacite = capacite;
+    c->epoque_courante = 0;
+    return 1;
+}
+
+ContexteChemin *contexte_chemin_creer(GrapheValueListe *g) {
+    if (!g) return NULL;
+    ContexteChemin *c = (ContexteChemin *)calloc(1, sizeof(ContexteChemin));
+    if (!c) return NULL;
+    c->g = g;
+    int n = graphe_value_liste_ordre(g);
+    if (!contexte_allouer(c, n > 0 ? n : 1)) {
+        free(c);
+        return NULL;
+    }
+    if (graphe_value_liste_est_oriente(g) && !graphe_value_liste_predecesseurs_actifs(g)) {
+        if (!graphe_value_liste_activer_predecesseurs(g)) {
+            contexte_chemin_detruire(c);
+            return NULL;
+        }
+        c->predecesseurs_temporaires = 1;
+    }
+    return c;
+}
+
+void contexte_chemin_detruire(ContexteChemin *c) {
+    if (!c) return;
+    if (c->predecesseurs_temporaires) graphe_value_liste_desactiver_predecesseurs(c->g);
+    contexte_liberer_tableaux(c);
+    free(c);
+}
+
+/* Starts a query: follows the order of the graph and opens a new epoch */
+static int contexte_preparer(ContexteChemin *c) {
+    int n = graphe_value_liste_ordre(c->g);
+    if (n > c->capacite) {
+        int capacite = c->capacite * 2 > n ? c->capacite * 2 : n;
+        if (!contexte_allouer(c, capacite)) return 0;
+    }
+    if (graphe_value_liste_est_oriente(c->g) && !graphe_value_liste_predecesseurs_actifs(c->g)) {
+        if (!graphe_value_liste_activer_predecesseurs(c->g)) return 0;
+        c->predecesseurs_temporaires = 1;
+    }
+    if (++c->epoque_courante == 0) {
+        memset(c->epoque, 0, c->capacite * sizeof(unsigned));
+        c->epoque_courante = 1;
+    }
+    file_priorite_vider(c->file[AVANT]);
+    file_priorite_vider(c->file[ARRIERE]);
+    return 1;
+}
+
+static void toucher(ContexteChemin *c, int v) {
+    if (c->epoque[v] == c->epoque_courante) return;
+    c->epoque[v] = c->epoque_courante;
+    c->dist[AVANT][v] = c->dist[ARRIERE][v] = INF;
+    c->pred[AVANT][v] = c->pred[ARRIERE][v] = -1;
+    c->regle[v] = 0;
+}
+
+static void chemin_vider(Chemin *chemin) {
+    chemin->distance = INF;
+    chemin->nb_sommets = 0;
+    chemin->sommets = NULL;
+    chemin->nb_regles = 0;
+}
+
+/* source .. milieu by the forward predecessors, then milieu .. target by
+   the backward ones */
+static void chemin_construire(ContexteChemin *c, int milieu, int distance, Chemin *chemin) {
+    int k = 0;
+    for (int v = milieu; v != -1; v = c->pred[AVANT][v]) c->sommets[k++] = v;
+    for (int i = 0, j = k - 1; i < j; ++i, --j) {
+        int t = c->sommets[i];
+        c->sommets[i] = c->sommets[j];
+        c->sommets[j] = t;
+    }
+    for (int v = c->pred[ARRIERE][milieu]; v != -1; v = c->pred[ARRIERE][v]) c->sommets[k++] = v;
+    chemin->distance = distance;
+    chemin->nb_sommets = k;
+    chemin->sommets = c->sommets;
+}
+
+/* ---------- Bidirectional Dijkstra ---------- */
+
+int chemin_bidirectionnel(ContexteChemin *c, int source, int cible, Chemin *chemin) {
+    if (!chemin) return 0;
+    chemin_vider(chemin);
+    if (!c) return 0;
+    int n = graphe_value_liste_ordre(c->g);
+    if (source < 0 || source >= n || cible < 0 || cible >= n) return 0;
+    if (!contexte_preparer(c)) return 0;
+
+    INSTR_PHASE_DEBUT(phase, "chemin_bidirectionnel");
+    int oriente = graphe_value_liste_est_oriente(c->g);
+    toucher(c, source);
+    toucher(c, cible);
+    c->dist[AVANT][source] = 0;
+    c->dist[ARRIERE][cible] = 0;
+    file_priorite_inserer(c->file[AVANT], source, 0);
+    file_priorite_inserer(c->file[ARRIERE], cible, 0);
+
+    /* best path through a vertex reached from both sides */
+    int meilleur = source == cible ? 0 : INF;
+    int milieu = source == cible ? source : -1;
+
+    while (!file_priorite_est_vide(c->file[AVANT]) && !file_priorite_est_vide(c->file[ARRIERE])) {
+        FilePriorite *fa = c->file[AVANT], *fr = c->file[ARRIERE];
+        if (fa->cle[file_priorite_min(fa)] + fr->cle[file_priorite_min(fr)] >= meilleur) break;
+
+        int cote = fa->taille <= fr->taille ? AVANT : ARRIERE;
+        int autre = 1 - cote;
+        int d;
+        int u = file_priorite_extraire_min(c->file[cote], &d);
+        c->regle[u] |= 1 << cote;
+        chemin->nb_regles++;
+
+        ArcValueListe *arc = cote == AVANT || !oriente ? graphe_value_liste_voisins(c->g, u)
+                                                       : graphe_value_liste_predecesseurs(c->g, u);
+        for (; arc; arc = arc->suivant) {
+            int v = arc->dest;
+            int nd = d + arc->poids;
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            toucher(c, v);
+            if (!(c->regle[v] & (1 << cote)) && nd < c->dist[cote][v]) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                c->dist[cote][v] = nd;
+                c->pred[cote][v] = u;
+                file_priorite_inserer(c->file[cote], v, nd);
+            }
+            if (c->dist[autre][v] < INF && c->dist[cote][v] + c->dist[autre][v] < meilleur) {
+                meilleur = c->dist[cote][v] + c->dist[autre][v];
+                milieu = v;
+            }
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    if (milieu < 0) return 0;
+    chemin_construire(c, milieu, meilleur, chemin);
+    return 1;
+}
+
+/* ---------- A* ---------- */
+
+/* dist[ARRIERE] is free here and caches the heuristic of each vertex,
+   computed when the vertex is first reached */
+int chemin_a_etoile(ContexteChemin *c, int source, int cible, HeuristiqueChemin heuristique,
+                    void *donnees, Chemin *chemin) {
+    if (!chemin) return 0;
+    chemin_vider(chemin);
+    if (!c) return 0;
+    int n = graphe_value_liste_ordre(c->g);
+    if (source < 0 || source >= n || cible < 0 || cible >= n) return 0;
+    if (!contexte_preparer(c)) return 0;
+
+    INSTR_PHASE_DEBUT(phase, "chemin_a_etoile");
+    int *dist = c->dist[AVANT];
+    int *estimation = c->dist[ARRIERE];
+    FilePriorite *file = c->file[AVANT];
+    int trouve = 0;
+
+    toucher(c, source);
+    dist[source] = 0;
+    estimation[source] = heuristique ? heuristique(source, cible, donnees) : 0;
+    if (estimation[source] < 0) estimation[source] = 0;
+    if (estimation[source] < INF) file_priorite_inserer(file, source, estimation[source]);
+
+    while (!file_priorite_est_vide(file)) {
+        int u = file_priorite_extraire_min(file, NULL);
+        chemin->nb_regles++;
+        if (u == cible) {
+            trouve = 1;
+            break;
+        }
+        for (ArcValueListe *arc = graphe_value_liste_voisins(c->g, u); arc; arc = arc->suivant) {
+            int v = arc->dest;
+            int nd = dist[u] + arc->poids;
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            toucher(c, v);
+            if (nd >= dist[v]) continue;
+            if (dist[v] == INF) {
+                int h = heuristique ? heuristique(v, cible, donnees) : 0;
+                estimation[v] = h < 0 ? 0 : h;
+            }
+            if (estimation[v] >= INF) continue; /* cannot reach the target */
+            INSTR_COMPTER(STAT_RELAXATIONS, 1);
+            dist[v] = nd;
+            c->pred[AVANT][v] = u;
+            /* a vertex settled already goes back to the heap, which only
+               happens with an inconsistent heuristic */
+            file_priorite_inserer(file, v, nd + estimation[v]);
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    if (!trouve) return 0;
+    chemin_construire(c, cible, dist[cible], chemin);
+    return 1;
+}
+
+/* ---------- ALT landmarks ---------- */
+
+/* Full Dijkstra along (AVANT) or against (ARRIERE) the arcs; with
+   non-negative weights a settled vertex is never improved again */
+static void distances_depuis(GrapheValueListe *g, int source, int sens, int *dist,
+                             FilePriorite *file) {
+    int n = graphe_value_liste_ordre(g);
+    int oriente = graphe_value_liste_est_oriente(g);
+    for (int v = 0; v < n; ++v) dist[v] = INF;
+    dist[source] = 0;
+    file_priorite_vider(file);
+    file_priorite_inserer(file, source, 0);
+    while (!file_priorite_est_vide(file)) {
+        int d;
+        int u = file_priorite_extraire_min(file, &d);
+        ArcValueListe *arc = sens == AVANT || !oriente ? graphe_value_liste_voisins(g, u)
+                                                       : graphe_value_liste_predecesseurs(g, u);
+        for (; arc; arc = arc->suivant) {
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (d + arc->poids < dist[arc->dest]) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                dist[arc->dest] = d + arc->poids;
+                file_priorite_inserer(file, arc->dest, dist[arc->dest]);
+            }
+        }
+    }
+}
+
+/* Vertex with the largest finite value of proche[], -1 if all are 0 or INF */
+static int plus_eloigne(const int *proche, int n) {
+    int meilleur = -1;
+    for (int v = 0; v < n; ++v)
+        if (proche[v] < INF && proche[v] > 0 && (meilleur < 0 || proche[v] > proche[meilleur]))
+            meilleur = v;
+    return meilleur;
+}
+
+ReperesALT *reperes_alt_creer(GrapheValueListe *g, int nb_reperes) {
+    if (!g || nb_reperes <= 0) return NULL;
+    int n = graphe_value_liste_ordre(g);
+    if (n <= 0) return NULL;
+    if (nb_reperes > n) nb_reperes = n;
+    int oriente = graphe_value_liste_est_oriente(g);
+    int temporaire = oriente && !graphe_value_liste_predecesseurs_actifs(g);
+
+    ReperesALT *r = (ReperesALT *)calloc(1, sizeof(ReperesALT));
+    int *proche = (int *)malloc(n * sizeof(int));
+    FilePriorite *file = file_priorite_creer(n);
+    if (!r || !proche || !file) goto echec;
+    r->nb_sommets = n;
+    r->reperes = (int *)malloc(nb_reperes * sizeof(int));
+    r->dist_depuis = (int *)malloc((size_t)nb_reperes * n * sizeof(int));
+    r->dist_vers = oriente ? (int *)malloc((size_t)nb_reperes * n * sizeof(int)) : r->dist_depuis;
+    if (!r->reperes || !r->dist_depuis || !r->dist_vers) goto echec;
+    if (temporaire && !graphe_value_liste_activer_predecesseurs(g)) {
+        temporaire = 0;
+        goto echec;
+    }
+
+    INSTR_PHASE_DEBUT(phase, "reperes_alt_creer");
+    distances_depuis(g, 0, AVANT, proche, file);
+    int repere = plus_eloigne(proche, n);
+    if (repere < 0) repere = 0;
+    for (int v = 0; v < n; ++v) proche[v] = INF;
+    while (r->nb_reperes < nb_reperes) {
+        int k = r->nb_reperes++;
+        int *depuis = r->dist_depuis + (size_t)k * n;
+        int *vers = r->dist_vers + (size_t)k * n;
+        r->reperes[k] = repere;
+        distances_depuis(g, repere, AVANT, depuis, file);
+        if (oriente) distances_depuis(g, repere, ARRIERE, vers, file);
+        for (int v = 0; v < n; ++v)
+            if (depuis[v] < proche[v]) proche[v] = depuis[v];
+        proche[repere] = 0;
+        repere = plus_eloigne(proche, n);
+        if (repere < 0) break; /* every vertex reachable is a landmark */
+    }
+    INSTR_PHASE_FIN(phase);
+
+    if (temporaire) graphe_value_liste_desactiver_predecesseurs(g);
+    file_priorite_detruire(file);
+    free(proche);
+    return r;
+
+echec:
+    if (temporaire) graphe_value_liste_desactiver_predecesseurs(g);
+    file_priorite_detruire(file);
+    free(proche);
+    reperes_alt_detruire(r);
+    return NULL;
+}
+
+void reperes_alt_detruire(ReperesALT *r) {
+    if (!r) return;
+    if (r->dist_vers != r->dist_depuis) free(r->dist_vers);
+    free(r->dist_depuis);
+    free(r->reperes);
+    free(r);
+}
+
+int reperes_alt_heuristique(int v, int cible, void *donnees) {
+    const ReperesALT *r = (const ReperesALT *)donnees;
+    int n = r->nb_sommets;
+    if (v >= n || cible >= n) return 0; /* vertex added after the landmarks */
+    int h = 0;
+    for (int k = 0; k < r->nb_reperes; ++k) {
+        const int *depuis = r->dist_depuis + (size_t)k * n;
+        const int *vers = r->dist_vers + (size_t)k * n;
+        /* d(v, t) >= d(L, t) - d(L, v); L reaching v but not t, or t
+           reaching L but not v, means v cannot reach t */
+        if (depuis[v] < INF) {
+            if (depuis[cible] == INF) return INF;
+            if (depuis[cible] - depuis[v] > h) h = depuis[cible] - depuis[v];
+        }
+        /* d(v, t) >= d(v, L) - d(t, L) */
+        if (vers[cible] < INF) {
+            if (vers[v] == INF) return INF;
+            if (vers[v] - vers[cible] > h) h = vers[v] - vers[cible];
+        }
+    }
+    return h;
+}
+
+int chemin_alt(ContexteChemin *c, const ReperesALT *r, int source, int cible, Chemin *chemin) {
+    return chemin_a_etoile(c, source, cible, r ? reperes_alt_heuristique : NULL, (void *)r, chemin);
+}
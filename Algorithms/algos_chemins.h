@@ -0,0 +1,79 @@
+/* algos_chemins.h */
+#ifndef ALGOS_CHEMINS_H
+#define ALGOS_CHEMINS_H
+
+#include "GrapheValueListe.h"
+
+/* Point-to-point shortest paths on GrapheValueListe (non-negative weights).
+   The searches stop as soon as the target distance is known, so a query
+   near the source only touches its surroundings.
+
+   A ContexteChemin holds the per-vertex arrays and the heaps of the
+   queries on one graph: it is created once and reused, each query only
+   resets the vertices it touched. The graph may change between two
+   queries (the arrays follow its order). On oriented graphs the
+   bidirectional search walks the predecessor lists, which the context
+   enables if they were not and disables again when it is destroyed.
+
+   The distance is the one of dijkstra(); with ties the path may be a
+   different shortest path than the one of its pred[]. */
+
+typedef struct ContexteChemin ContexteChemin;
+
+typedef struct {
+    int distance;   /* 1000000000 = unreachable */
+    int nb_sommets; /* vertices of the path, source and target included (0 if none) */
+    int *sommets;   /* source .. target, owned by the context: valid until its next query */
+    int nb_regles;  /* vertices settled by the search, both directions together */
+} Chemin;
+
+ContexteChemin *contexte_chemin_creer(GrapheValueListe *g);
+void contexte_chemin_detruire(ContexteChemin *c);
+
+/* Lower bound of the distance from v to cible. It must never exceed the
+   real distance (admissible); it need not be consistent, a vertex is then
+   settled again when a shorter path to it shows up. */
+typedef int (*HeuristiqueChemin)(int v, int cible, void *donnees);
+
+/* The functions below return 1 when cible is reachable, 0 otherwise (bad
+   vertex, memory): chemin then has distance 1000000000 and no vertices. */
+
+/* Bidirectional Dijkstra: a forward search from source and a backward one
+   from cible, always advancing the smaller heap, until the two minimum
+   keys add up to the best meeting found */
+int chemin_bidirectionnel(ContexteChemin *c, int source, int cible, Chemin *chemin);
+
+/* A*: vertices are settled by distance + heuristique(v, cible), the search
+   ends when cible is settled. heuristique = NULL gives Dijkstra stopped at
+   the target. */
+int chemin_a_etoile(ContexteChemin *c, int source, int cible, HeuristiqueChemin heuristique,
+                    void *donnees, Chemin *chemin);
+
+/* ---------- ALT landmarks ---------- */
+
+/* Distances from and to a few landmarks, precomputed with full Dijkstras
+   (two per landmark on an oriented graph). With the triangle inequality,
+   d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L) for every
+   landmark L. Landmarks are chosen far apart: the first is the vertex
+   farthest from vertex 0, each next one maximizes its distance to the
+   closest landmark already chosen. The tables describe the graph at
+   creation time: rebuild them after the weights or arcs change. */
+typedef struct {
+    int nb_reperes;
+    int nb_sommets;
+    int *reperes;     /* the landmark vertices */
+    int *dist_depuis; /* dist_depuis[k * nb_sommets + v] = d(reperes[k], v) */
+    int *dist_vers;   /* dist_vers[k * nb_sommets + v] = d(v, reperes[k]),
+                         same array as dist_depuis on a non oriented graph */
+} ReperesALT;
+
+ReperesALT *reperes_alt_creer(GrapheValueListe *g, int nb_reperes); /* NULL on error */
+void reperes_alt_detruire(ReperesALT *r);
+
+/* HeuristiqueChemin over the landmarks (donnees = the ReperesALT) */
+int reperes_alt_heuristique(int v, int cible, void *donnees);
+
+/* A* with the landmark heuristic */
+int chemin_alt(ContexteChemin *c, const ReperesALT *r, int source, int cible, Chemin *chemin);
+
+#endif /* ALGOS_CHEMINS_H */
@@ -0,0 +1,869 @@
+/* algos_contraction.c Contraction hierarchies: preprocessing, queries, files */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "algos_contraction.h"
+#include "Octets.h"
+#include "FilePriorite.h"
+#include "Parallele.h"
+#include "Instrumentation.h"
+
+#define INF 1000000000
+
+#define TAILLE_BLOC 64 /* vertices taken at once by a thread */
+
+#define AVANT   0 /* query: upward search from the source */
+#define ARRIERE 1 /* query: upward search from the target, against the arcs */
+
+#define ACTIF     0
+#define EN_COURS  1 /* in the independent set of this round */
+#define CONTRACTE 2
+
+/* ---------- Remaining graph during the contraction ---------- */
+
+/* Arcs between vertices not contracted yet, one entry per neighbor */
+typedef struct {
+    int *voisin;
+    int *poids;
+    int *milieu; /* bypassed vertex, -1 = original arc */
+    int taille;
+    int capacite;
+} ListeCH;
+
+/* Adds the arc or lowers the weight of the one already there; 0 if out of memory */
+static int liste_ajouter(ListeCH *l, int v, int poids, int milieu) {
+    for (int i = 0; i < l->taille; ++i) {
+        if (l->voisin[i] != v) continue;
+        if (poids < l->poids[i]) {
+            l->poids[i] = poids;
+            l->milieu[i] = milieu;
+        }
+        return 1;
+    }
+    if (l->taille == l->capacite) {
+        int capacite = l->capacite ? 2 * l->capacite : 4;
+        int *voisin = (int *)realloc(l->voisin, capacite * sizeof(int));
+        if (voisin) l->voisin = voisin;
+        int *poids_ = (int *)realloc(l->poids, capacite * sizeof(int));
+        if (poids_) l->poids = poids_;
+        int *milieu_ = (int *)realloc(l->milieu, capacite * sizeof(int));
+        if (milieu_) l->milieu = milieu_;
+        if (!voisin || !poids_ || !milieu_) return 0;
+        l->capacite = capacite;
+    }
+    l->voisin[l->taille] = v;
+    l->poids[l->taille] = poids;
+    l->milieu[l->taille] = milieu;
+    l->taille++;
+    return 1;
+}
+
+static void liste_retirer(ListeCH *l, int v) {
+    for (int i = 0; i < l->taille; ++i) {
+        if (l->voisin[i] != v) continue;
+        l->taille--;
+        l->voisin[i] = l->voisin[l->taille];
+        l->poids[i] = l->poids[l->taille];
+        l->milieu[i] = l->milieu[l->taille];
+        return;
+    }
+}
+
+static void liste_liberer(ListeCH *l) {
+    free(l->voisin);
+    free(l->poids);
+    free(l->milieu);
+}
+
+typedef struct {
+    int u;
+    int w;
+    int poids;
+} Raccourci;
+
+/* Scratch space of one thread */
+typedef struct {
+    int *dist;
+    unsigned *epoque;
+    unsigned *cible; /* cible[w] == epoque_courante: w is a target of the search */
+    unsigned epoque_courante;
+    FilePriorite *file;
+    Raccourci *raccourcis; /* found during the current round */
+    int nb_raccourcis;
+    int capacite;
+    int erreur;
+} Travailleur;
+
+typedef struct {
+    int n;
+    int oriente;
+    /* a non oriented graph has entrants == sortants, each edge in both lists */
+    ListeCH *sortants;
+    ListeCH *entrants;
+    unsigned char *etat;
+    int *priorite;
+    int *voisins_contractes;
+    int *niveau; /* depth in the hierarchy built so far */
+
+    Travailleur *travailleurs;
+    int nb_threads;
+
+    /* work of the current parallel step */
+    const int *sommets;
+    int nb_sommets;
+    int prochain;
+    unsigned char *choisi;
+    int *thread_de;         /* set member i: thread that contracted it */
+    int *premier_raccourci; /* and where its shortcuts start in that thread's buffer */
+    int *nb_raccourcis;
+} EtatCH;
+
+static int travailleur_garder(Travailleur *t, int u, int w, int poids) {
+    if (t->nb_raccourcis == t->capacite) {
+        int capacite = t->capacite ? 2 * t->capacite : 256;
+        Raccourci *r = (Raccourci *)realloc(t->raccourcis, capacite * sizeof(Raccourci));
+        if (!r) return 0;
+        t->raccourcis = r;
+        t->capacite = capacite;
+    }
+    t->raccourcis[t->nb_raccourcis].u = u;
+    t->raccourcis[t->nb_raccourcis].w = w;
+    t->raccourcis[t->nb_raccourcis].poids = poids;
+    t->nb_raccourcis++;
+    return 1;
+}
+
+/* Local Dijkstra from source over the active vertices other than exclu,
+   until the targets are settled, the distances exceed borne or
+   HIERARCHIE_TEMOINS_MAX vertices are settled. Stopping early only costs
+   extra shortcuts. */
+static void chercher_temoins(const EtatCH *e, Travailleur *t, int source, int exclu, int borne,
+                             int nb_cibles) {
+    file_priorite_vider(t->file);
+    t->epoque[source] = t->epoque_courante;
+    t->dist[source] = 0;
+    file_priorite_inserer(t->file, source, 0);
+    int regles = 0;
+    while (!file_priorite_est_vide(t->file)) {
+        int d;
+        int u = file_priorite_extraire_min(t->file, &d);
+        if (d > borne || ++regles > HIERARCHIE_TEMOINS_MAX) break;
+        if (t->cible[u] == t->epoque_courante && --nb_cibles == 0) break;
+        const ListeCH *l = &e->sortants[u];
+        for (int i = 0; i < l->taille; ++i) {
+            int x = l->voisin[i];
+            if (x == exclu || e->etat[x] != ACTIF) continue;
+            int nd = d + l->poids[i];
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (t->epoque[x] != t->epoque_courante || nd < t->dist[x]) {
+                t->epoque[x] = t->epoque_courante;
+                t->dist[x] = nd;
+                file_priorite_inserer(t->file, x, nd);
+            }
+        }
+    }
+}
+
+/* Shortcuts needed to remove v: u -> w for each in-neighbor u and
+   out-neighbor w without a witness path as short as the one through v
+   (pairs taken once on a non oriented graph). They are kept in t when
+   garder is set. Returns their number, -1 if out of memory. */
+static int simuler_contraction(const EtatCH *e, Travailleur *t, int v, int garder) {
+    const ListeCH *entree = &e->entrants[v], *sortie = &e->sortants[v];
+    int nb = 0;
+    for (int i = 0; i < entree->taille; ++i) {
+        int u = entree->voisin[i], duv = entree->poids[i];
+        if (e->etat[u] != ACTIF) continue;
+        if (++t->epoque_courante == 0) {
+            memset(t->epoque, 0, e->n * sizeof(unsigned));
+            memset(t->cible, 0, e->n * sizeof(unsigned));
+            t->epoque_courante = 1;
+        }
+        int borne = -1, nb_cibles = 0;
+        for (int j = 0; j < sortie->taille; ++j) {
+            int w = sortie->voisin[j];
+            if (w == u || (!e->oriente && w < u) || e->etat[w] != ACTIF) continue;
+            if (duv + sortie->poids[j] > borne) borne = duv + sortie->poids[j];
+            t->cible[w] = t->epoque_courante;
+            nb_cibles++;
+        }
+        if (nb_cibles == 0) continue;
+        chercher_temoins(e, t, u, v, borne, nb_cibles);
+        for (int j = 0; j < sortie->taille; ++j) {
+            int w = sortie->voisin[j];
+            if (w == u || (!e->oriente && w < u) || e->etat[w] != ACTIF) continue;
+            int d = duv + sortie->poids[j];
+            if (t->epoque[w] == t->epoque_courante && t->dist[w] <= d) continue;
+            nb++;
+            if (garder && !travailleur_garder(t, u, w, d)) return -1;
+        }
+    }
+    return nb;
+}
+
+static int calculer_priorite(const EtatCH *e, Travailleur *t, int v) {
+    int raccourcis = simuler_contraction(e, t, v, 0);
+    int arcs = e->sortants[v].taille + (e->oriente ? e->entrants[v].taille : 0);
+    return 2 * (raccourcis - arcs) + e->voisins_contractes[v] + e->niveau[v];
+}
+
+static void tache_priorites(int id, int nb, void *arg) {
+    (void)nb;
+    EtatCH *e = (EtatCH *)arg;
+    int debut, fin;
+    while (parallele_prendre_bloc(&e->prochain, e->nb_sommets, TAILLE_BLOC, &debut, &fin))
+        for (int i = debut; i < fin; ++i)
+            e->priorite[e->sommets[i]] = calculer_priorite(e, &e->travailleurs[id], e->sommets[i]);
+}
+
+/* (priority, index) smaller than that of every active neighbor */
+static int minimum_local(const EtatCH *e, int v) {
+    int p = e->priorite[v];
+    for (int s = 0; s < (e->oriente ? 2 : 1); ++s) {
+        const ListeCH *l = s == 0 ? &e->sortants[v] : &e->entrants[v];
+        for (int i = 0; i < l->taille; ++i) {
+            int x = l->voisin[i];
+            if (e->etat[x] != ACTIF) continue;
+            if (e->priorite[x] < p || (e->priorite[x] == p && x < v)) return 0;
+        }
+    }
+    return 1;
+}
+
+static void tache_selection(int id, int nb, void *arg) {
+    (void)id;
+    (void)nb;
+    EtatCH *e = (EtatCH *)arg;
+    int debut, fin;
+    while (parallele_prendre_bloc(&e->prochain, e->nb_sommets, TAILLE_BLOC, &debut, &fin))
+        for (int i = debut; i < fin; ++i)
+            e->choisi[i] = (unsigned char)minimum_local(e, e->sommets[i]);
+}
+
+static void tache_contraction(int id, int nb, void *arg) {
+    (void)nb;
+    EtatCH *e = (EtatCH *)arg;
+    Travailleur *t = &e->travailleurs[id];
+    int debut, fin;
+    while (parallele_prendre_bloc(&e->prochain, e->nb_sommets, TAILLE_BLOC, &debut, &fin)) {
+        for (int i = debut; i < fin; ++i) {
+            e->thread_de[i] = id;
+            e->premier_raccourci[i] = t->nb_raccourcis;
+            if (simuler_contraction(e, t, e->sommets[i], 1) < 0) t->erreur = 1;
+            e->nb_raccourcis[i] = t->nb_raccourcis - e->premier_raccourci[i];
+        }
+    }
+}
+
+static int executer(EtatCH *e, TacheParallele tache, const int *sommets, int nb) {
+    e->sommets = sommets;
+    e->nb_sommets = nb;
+    e->prochain = 0;
+    int nb_threads = e->nb_threads;
+    if (nb < nb_threads * TAILLE_BLOC) nb_threads = (nb + TAILLE_BLOC - 1) / TAILLE_BLOC;
+    if (nb_threads < 1) nb_threads = 1;
+    return parallele_executer(nb_threads, tache, e);
+}
+
+/* ---------- Hierarchy ---------- */
+
+/* One CSR row per vertex from its lists, frozen when it was contracted */
+static GrapheCSR *geler(const ListeCH *listes, int n, int **milieu) {
+    long long m = 0;
+    for (int v = 0; v < n; ++v) m += listes[v].taille;
+    if (m > 2147483647LL) return NULL;
+    GrapheCSR *c = (GrapheCSR *)calloc(1, sizeof(GrapheCSR));
+    if (!c) return NULL;
+    c->nb_sommets = n;
+    c->nb_arcs = (int)m;
+    c->oriente = 1;
+    c->debut = (int *)malloc((n + 1) * sizeof(int));
+    c->dest = (int *)malloc((m + 1) * sizeof(int));
+    c->poids = (int *)malloc((m + 1) * sizeof(int));
+    *milieu = (int *)malloc((m + 1) * sizeof(int));
+    if (!c->debut || !c->dest || !c->poids || !*milieu) {
+        free(*milieu);
+        *milieu = NULL;
+        graphe_csr_detruire(c);
+        return NULL;
+    }
+    int k = 0;
+    for (int v = 0; v < n; ++v) {
+        c->debut[v] = k;
+        const ListeCH *l = &listes[v];
+        if (l->taille == 0) continue;
+        memcpy(c->dest + k, l->voisin, l->taille * sizeof(int));
+        memcpy(c->poids + k, l->poids, l->taille * sizeof(int));
+        memcpy(*milieu + k, l->milieu, l->taille * sizeof(int));
+        k += l->taille;
+    }
+    c->debut[n] = k;
+    return c;
+}
+
+void hierarchie_detruire(HierarchieContraction *h) {
+    if (!h) return;
+    if (h->descendant != h->montant) {
+        graphe_csr_detruire(h->descendant);
+        free(h->milieu_descendant);
+    }
+    graphe_csr_detruire(h->montant);
+    free(h->milieu_montant);
+    free(h->rang);
+    free(h);
+}
+
+static void compter_raccourcis(HierarchieContraction *h) {
+    h->nb_raccourcis = 0;
+    for (int k = 0; k < h->montant->nb_arcs; ++k) h->nb_raccourcis += h->milieu_montant[k] >= 0;
+    if (h->descendant != h->montant)
+        for (int k = 0; k < h->descendant->nb_arcs; ++k)
+            h->nb_raccourcis += h->milieu_descendant[k] >= 0;
+}
+
+/* Removes the contracted set sommets[0 .. nb-1] (ranks from *rang_suivant):
+   adds their shortcuts in set order, takes them out of their neighbors'
+   lists and returns in a_revoir the neighbors whose priority changed */
+static int appliquer_ronde(EtatCH *e, const int *sommets, int nb, int *rang, int *rang_suivant,
+                           int *a_revoir, int *nb_a_revoir, unsigned char *marque) {
+    for (int i = 0; i < nb; ++i) {
+        int v = sommets[i];
+        const Travailleur *t = &e->travailleurs[e->thread_de[i]];
+        for (int k = 0; k < e->nb_raccourcis[i]; ++k) {
+            const Raccourci *r = &t->raccourcis[e->premier_raccourci[i] + k];
+            if (!liste_ajouter(&e->sortants[r->u], r->w, r->poids, v) ||
+                !liste_ajouter(&e->entrants[r->w], r->u, r->poids, v))
+                return 0;
+        }
+    }
+    for (int i = 0; i < nb; ++i) {
+        int v = sommets[i];
+        rang[v] = (*rang_suivant)++;
+        e->etat[v] = CONTRACTE;
+        for (int s = 0; s < (e->oriente ? 2 : 1); ++s) {
+            const ListeCH *l = s == 0 ? &e->sortants[v] : &e->entrants[v];
+            for (int j = 0; j < l->taille; ++j) {
+                int x = l->voisin[j];
+                liste_retirer(s == 0 ? &e->entrants[x] : &e->sortants[x], v);
+                if (!marque[x]) {
+                    marque[x] = 1;
+                    e->voisins_contractes[x]++;
+                    a_revoir[(*nb_a_revoir)++] = x;
+                }
+                if (e->niveau[v] + 1 > e->niveau[x]) e->niveau[x] = e->niveau[v] + 1;
+            }
+        }
+    }
+    for (int i = 0; i < *nb_a_revoir; ++i) marque[a_revoir[i]] = 0;
+    return 1;
+}
+
+HierarchieContraction *hierarchie_construire(GrapheValueListe *g, int nb_threads) {
+    if (!g) return NULL;
+    int n = graphe_value_liste_ordre(g);
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+
+    EtatCH e;
+    memset(&e, 0, sizeof e);
+    e.n = n;
+    e.oriente = graphe_value_liste_est_oriente(g);
+    e.nb_threads = nb_threads;
+    size_t taille = n > 0 ? (size_t)n : 1;
+    e.sortants = (ListeCH *)calloc(taille, sizeof(ListeCH));
+    e.entrants = e.oriente ? (ListeCH *)calloc(taille, sizeof(ListeCH)) : e.sortants;
+    e.etat = (unsigned char *)calloc(taille, 1);
+    e.priorite = (int *)malloc(taille * sizeof(int));
+    e.voisins_contractes = (int *)calloc(taille, sizeof(int));
+    e.niveau = (int *)calloc(taille, sizeof(int));
+    e.choisi = (unsigned char *)malloc(taille);
+    e.thread_de = (int *)malloc(taille * sizeof(int));
+    e.premier_raccourci = (int *)malloc(taille * sizeof(int));
+    e.nb_raccourcis = (int *)malloc(taille * sizeof(int));
+    e.travailleurs = (Travailleur *)calloc(nb_threads, sizeof(Travailleur));
+    int *actifs = (int *)malloc(taille * sizeof(int));
+    int *ensemble = (int *)malloc(taille * sizeof(int));
+    int *a_revoir = (int *)malloc(taille * sizeof(int));
+    unsigned char *marque = (unsigned char *)calloc(taille, 1);
+    HierarchieContraction *h = (HierarchieContraction *)calloc(1, sizeof(HierarchieContraction));
+    int ok = e.sortants && e.entrants && e.etat && e.priorite && e.voisins_contractes &&
+             e.niveau && e.choisi && e.thread_de && e.premier_raccourci && e.nb_raccourcis &&
+             e.travailleurs && actifs && ensemble && a_revoir && marque && h;
+    for (int i = 0; ok && i < nb_threads; ++i) {
+        Travailleur *t = &e.travailleurs[i];
+        t->dist = (int *)malloc(taille * sizeof(int));
+        t->epoque = (unsigned *)calloc(taille, sizeof(unsigned));
+        t->cible = (unsigned *)calloc(taille, sizeof(unsigned));
+        t->file = file_priorite_creer(n > 0 ? n : 1);
+        ok = t->dist && t->epoque && t->cible && t->file;
+    }
+    if (ok) {
+        h->nb_sommets = n;
+        h->oriente = e.oriente;
+        h->rang = (int *)malloc(taille * sizeof(int));
+        ok = h->rang != NULL;
+    }
+
+    /* the remaining graph starts as the input without loops, parallel arcs merged */
+    INSTR_PHASE_DEBUT(preparation, "hierarchie_construire/preparation");
+    for (int u = 0; ok && u < n; ++u) {
+        for (ArcValueListe *a = graphe_value_liste_voisins(g, u); ok && a; a = a->suivant) {
+            if (a->dest == u) continue;
+            ok = liste_ajouter(&e.sortants[u], a->dest, a->poids, -1) &&
+                 liste_ajouter(&e.entrants[a->dest], u, a->poids, -1);
+        }
+    }
+    for (int v = 0; v < n; ++v) actifs[v] = v;
+    if (ok) ok = executer(&e, tache_priorites, actifs, n);
+    INSTR_PHASE_FIN(preparation);
+
+    int nb_actifs = n, rang_suivant = 0;
+    while (ok && nb_actifs > 0) {
+        INSTR_PHASE_DEBUT(ronde, "hierarchie_construire/ronde");
+        ok = executer(&e, tache_selection, actifs, nb_actifs);
+        int nb = 0, reste = 0;
+        for (int i = 0; ok && i < nb_actifs; ++i) {
+            if (e.choisi[i]) {
+                ensemble[nb++] = actifs[i];
+                e.etat[actifs[i]] = EN_COURS;
+            } else {
+                actifs[reste++] = actifs[i];
+            }
+        }
+        for (int i = 0; i < nb_threads; ++i) e.travailleurs[i].nb_raccourcis = 0;
+        if (ok) ok = executer(&e, tache_contraction, ensemble, nb);
+        for (int i = 0; ok && i < nb_threads; ++i) ok = !e.travailleurs[i].erreur;
+        int nb_a_revoir = 0;
+        if (ok) ok = appliquer_ronde(&e, ensemble, nb, h->rang, &rang_suivant, a_revoir,
+                                     &nb_a_revoir, marque);
+        if (ok) ok = executer(&e, tache_priorites, a_revoir, nb_a_revoir);
+        nb_actifs = reste;
+        h->nb_rondes++;
+        INSTR_PHASE_FIN(ronde);
+    }
+
+    if (ok) {
+        INSTR_PHASE_DEBUT(gel, "hierarchie_construire/gel");
+        h->montant = geler(e.sortants, n, &h->milieu_montant);
+        if (!e.oriente) {
+            h->descendant = h->montant;
+            h->milieu_descendant = h->milieu_montant;
+        } else {
+            h->descendant = geler(e.entrants, n, &h->milieu_descendant);
+        }
+        ok = h->montant && h->descendant;
+        if (ok) compter_raccourcis(h);
+        INSTR_PHASE_FIN(gel);
+    }
+
+    for (int v = 0; e.sortants && v < n; ++v) liste_liberer(&e.sortants[v]);
+    if (e.oriente && e.entrants)
+        for (int v = 0; v < n; ++v) liste_liberer(&e.entrants[v]);
+    if (e.entrants != e.sortants) free(e.entrants);
+    free(e.sortants);
+    for (int i = 0; e.travailleurs && i < nb_threads; ++i) {
+        free(e.travailleurs[i].dist);
+        free(e.travailleurs[i].epoque);
+        free(e.travailleurs[i].cible);
+        file_priorite_detruire(e.travailleurs[i].file);
+        free(e.travailleurs[i].raccourcis);
+    }
+    free(e.travailleurs);
+    free(e.etat);
+    free(e.priorite);
+    free(e.voisins_contractes);
+    free(e.niveau);
+    free(e.choisi);
+    free(e.thread_de);
+    free(e.premier_raccourci);
+    free(e.nb_raccourcis);
+    free(actifs);
+    free(ensemble);
+    free(a_revoir);
+    free(marque);
+    if (!ok) {
+        hierarchie_detruire(h);
+        return NULL;
+    }
+    return h;
+}
+
+/* ---------- Files ---------- */
+
+#define TAILLE_ENTETE 64
+#define TAILLE_TAMPON 4096
+
+static const char MAGIE[8] = { 'G', 'R', 'A', 'P', 'H', 'E', 'C', 'H' };
+
+static int ecrire_entiers(FILE *f, const int *t, size_t n) {
+    unsigned char octets[4 * TAILLE_TAMPON];
+    while (n > 0) {
+        size_t k = n < TAILLE_TAMPON ? n : TAILLE_TAMPON;
+        for (size_t i = 0; i < k; ++i) octets_poser_u32(octets + 4 * i, (uint32_t)t[i]);
+        if (fwrite(octets, 4, k, f) != k) return 0;
+        t += k;
+        n -= k;
+    }
+    return 1;
+}
+
+static int *lire_entiers(FILE *f, size_t n) {
+    unsigned char octets[4 * TAILLE_TAMPON];
+    int *t = (int *)malloc((n ? n : 1) * sizeof(int));
+    if (!t) return NULL;
+    for (size_t fait = 0; fait < n;) {
+        size_t k = n - fait < TAILLE_TAMPON ? n - fait : TAILLE_TAMPON;
+        if (fread(octets, 4, k, f) != k) {
+            free(t);
+            return NULL;
+        }
+        for (size_t i = 0; i < k; ++i) t[fait + i] = (int)octets_lire_u32(octets + 4 * i);
+        fait += k;
+    }
+    return t;
+}
+
+static int ecrire_niveau(FILE *f, const GrapheCSR *c, const int *milieu) {
+    return ecrire_entiers(f, c->debut, (size_t)c->nb_sommets + 1) &&
+           ecrire_entiers(f, c->dest, (size_t)c->nb_arcs) &&
+           ecrire_entiers(f, c->poids, (size_t)c->nb_arcs) &&
+           ecrire_entiers(f, milieu, (size_t)c->nb_arcs);
+}
+
+int hierarchie_ecrire(const HierarchieContraction *h, const char *chemin) {
+    if (!h || !chemin) return 0;
+    uint64_t n = (uint64_t)h->nb_sommets;
+    uint64_t m_montant = (uint64_t)h->montant->nb_arcs;
+    uint64_t m_descendant = h->oriente ? (uint64_t)h->descendant->nb_arcs : 0;
+    uint64_t taille = TAILLE_ENTETE + 4 * n + 4 * (n + 1 + 3 * m_montant) +
+                      (h->oriente ? 4 * (n + 1 + 3 * m_descendant) : 0);
+
+    unsigned char entete[TAILLE_ENTETE];
+    memset(entete, 0, sizeof entete);
+    memcpy(entete, MAGIE, 8);
+    octets_poser_u32(entete + 8, HIERARCHIE_VERSION);
+    octets_poser_u32(entete + 12, h->oriente ? 1u : 0u);
+    octets_poser_u64(entete + 16, n);
+    octets_poser_u64(entete + 24, m_montant);
+    octets_poser_u64(entete + 32, m_descendant);
+    octets_poser_u64(entete + 40, (uint64_t)h->nb_rondes);
+    octets_poser_u64(entete + 48, taille);
+
+    FILE *f = fopen(chemin, "wb");
+    if (!f) return 0;
+    int ok = fwrite(entete, 1, sizeof entete, f) == sizeof entete &&
+             ecrire_entiers(f, h->rang, (size_t)n) &&
+             ecrire_niveau(f, h->montant, h->milieu_montant) &&
+             (!h->oriente || ecrire_niveau(f, h->descendant, h->milieu_descendant));
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) remove(chemin);
+    return ok;
+}
+
+static GrapheCSR *lire_niveau(FILE *f, int n, int m, int **milieu) {
+    GrapheCSR *c = (GrapheCSR *)calloc(1, sizeof(GrapheCSR));
+    if (!c) return NULL;
+    c->nb_sommets = n;
+    c->nb_arcs = m;
+    c->oriente = 1;
+    c->debut = lire_entiers(f, (size_t)n + 1);
+    c->dest = c->debut ? lire_entiers(f, (size_t)m) : NULL;
+    c->poids = c->dest ? lire_entiers(f, (size_t)m) : NULL;
+    *milieu = c->poids ? lire_entiers(f, (size_t)m) : NULL;
+    if (!*milieu) {
+        graphe_csr_detruire(c);
+        return NULL;
+    }
+    return c;
+}
+
+/* Offsets in order and within the arcs, vertices in range, arcs going
+   up the ranks, weights below INF so that d + poids cannot overflow */
+static int verifier_niveau(const GrapheCSR *c, const int *milieu, const int *rang) {
+    int n = c->nb_sommets;
+    if (c->debut[0] != 0 || c->debut[n] != c->nb_arcs) return 0;
+    for (int v = 0; v < n; ++v) {
+        if (c->debut[v + 1] < c->debut[v] || c->debut[v + 1] > c->nb_arcs) return 0;
+        for (int k = c->debut[v]; k < c->debut[v + 1]; ++k) {
+            int x = c->dest[k];
+            if (x < 0 || x >= n || rang[x] <= rang[v] || c->poids[k] < 0 ||
+                c->poids[k] >= INF)
+                return 0;
+            if (milieu[k] < -1 || milieu[k] >= n) return 0;
+            if (milieu[k] >= 0 && rang[milieu[k]] >= rang[v]) return 0;
+        }
+    }
+    return 1;
+}
+
+HierarchieContraction *hierarchie_ouvrir(const char *chemin) {
+    if (!chemin) return NULL;
+    FILE *f = fopen(chemin, "rb");
+    if (!f) return NULL;
+    unsigned char entete[TAILLE_ENTETE];
+    long taille_fichier = -1;
+    if (fseek(f, 0, SEEK_END) == 0) taille_fichier = ftell(f);
+    rewind(f);
+    if (taille_fichier < TAILLE_ENTETE || fread(entete, 1, sizeof entete, f) != sizeof entete) {
+        fclose(f);
+        return NULL;
+    }
+    uint32_t drapeaux = octets_lire_u32(entete + 12);
+    uint64_t n = octets_lire_u64(entete + 16), m_montant = octets_lire_u64(entete + 24);
+    uint64_t m_descendant = octets_lire_u64(entete + 32), taille = octets_lire_u64(entete + 48);
+    int oriente = (drapeaux & 1u) != 0;
+    int valide = memcmp(entete, MAGIE, 8) == 0 && octets_lire_u32(entete + 8) == HIERARCHIE_VERSION &&
+                 n < 2147483647ULL && m_montant <= 2147483647ULL &&
+                 m_descendant <= 2147483647ULL && (oriente || m_descendant == 0) &&
+                 taille == (uint64_t)taille_fichier &&
+                 taille == TAILLE_ENTETE + 4 * n + 4 * (n + 1 + 3 * m_montant) +
+                           (oriente ? 4 * (n + 1 + 3 * m_descendant) : 0);
+    HierarchieContraction *h = valide ? (HierarchieContraction *)calloc(1, sizeof(HierarchieContraction)) : NULL;
+    if (!h) {
+        fclose(f);
+        return NULL;
+    }
+    h->nb_sommets = (int)n;
+    h->oriente = oriente;
+    h->nb_rondes = (int)octets_lire_u64(entete + 40);
+    h->rang = lire_entiers(f, (size_t)n);
+    if (h->rang) h->montant = lire_niveau(f, (int)n, (int)m_montant, &h->milieu_montant);
+    if (h->montant && oriente) {
+        h->descendant = lire_niveau(f, (int)n, (int)m_descendant, &h->milieu_descendant);
+    } else if (h->montant) {
+        h->descendant = h->montant;
+        h->milieu_descendant = h->milieu_montant;
+    }
+    fclose(f);
+
+    /* the ranks must be a permutation */
+    int ok = h->descendant != NULL;
+    unsigned char *vu = ok ? (unsigned char *)calloc(n ? n : 1, 1) : NULL;
+    ok = vu != NULL;
+    for (uint64_t v = 0; ok && v < n; ++v) {
+        int r = h->rang[v];
+        ok = r >= 0 && (uint64_t)r < n && !vu[r];
+        if (ok) vu[r] = 1;
+    }
+    free(vu);
+    ok = ok && verifier_niveau(h->montant, h->milieu_montant, h->rang) &&
+         (!oriente || verifier_niveau(h->descendant, h->milieu_descendant, h->rang));
+    if (!ok) {
+        hierarchie_detruire(h);
+        return NULL;
+    }
+    compter_raccourcis(h);
+    return h;
+}
+
+/* ---------- Queries ---------- */
+
+struct ContexteHierarchie {
+    const HierarchieContraction *h;
+    unsigned *epoque;
+    unsigned epoque_courante;
+    int *dist[2];
+    int *pred[2]; /* pred[ARRIERE][v] = next vertex towards the target */
+    FilePriorite *file[2];
+    int *etapes;  /* path in the hierarchy */
+    int *pile;    /* arcs still to unpack, two entries each */
+    int *sommets; /* unpacked path */
+};
+
+ContexteHierarchie *contexte_hierarchie_creer(const HierarchieContraction *h) {
+    if (!h) return NULL;
+    ContexteHierarchie *c = (ContexteHierarchie *)calloc(1, sizeof(ContexteHierarchie));
+    if (!c) return NULL;
+    size_t n = h->nb_sommets > 0 ? (size_t)h->nb_sommets : 1;
+    c->h = h;
+    c->epoque = (unsigned *)calloc(n, sizeof(unsigned));
+    c->etapes = (int *)malloc(n * sizeof(int));
+    c->pile = (int *)malloc(2 * (n + 1) * sizeof(int));
+    c->sommets = (int *)malloc(n * sizeof(int));
+    int ok = c->epoque && c->etapes && c->pile && c->sommets;
+    for (int s = 0; s < 2; ++s) {
+        c->dist[s] = (int *)malloc(n * sizeof(int));
+        c->pred[s] = (int *)malloc(n * sizeof(int));
+        c->file[s] = file_priorite_creer((int)n);
+        ok = ok && c->dist[s] && c->pred[s] && c->file[s];
+    }
+    if (!ok) {
+        contexte_hierarchie_detruire(c);
+        return NULL;
+    }
+    return c;
+}
+
+void contexte_hierarchie_detruire(ContexteHierarchie *c) {
+    if (!c) return;
+    for (int s = 0; s < 2; ++s) {
+        free(c->dist[s]);
+        free(c->pred[s]);
+        file_priorite_detruire(c->file[s]);
+    }
+    free(c->epoque);
+    free(c->etapes);
+    free(c->pile);
+    free(c->sommets);
+    free(c);
+}
+
+static void toucher(ContexteHierarchie *c, int v) {
+    if (c->epoque[v] == c->epoque_courante) return;
+    c->epoque[v] = c->epoque_courante;
+    c->dist[AVANT][v] = c->dist[ARRIERE][v] = INF;
+    c->pred[AVANT][v] = c->pred[ARRIERE][v] = -1;
+}
+
+static int distance_touchee(const ContexteHierarchie *c, int cote, int v) {
+    return c->epoque[v] == c->epoque_courante ? c->dist[cote][v] : INF;
+}
+
+/* Both upward searches; returns the distance and the meeting vertex */
+static int rechercher(ContexteHierarchie *c, int source, int cible, int *milieu, int *nb_regles) {
+    const HierarchieContraction *h = c->h;
+    if (++c->epoque_courante == 0) {
+        memset(c->epoque, 0, (h->nb_sommets > 0 ? h->nb_sommets : 1) * sizeof(unsigned));
+        c->epoque_courante = 1;
+    }
+    file_priorite_vider(c->file[AVANT]);
+    file_priorite_vider(c->file[ARRIERE]);
+    toucher(c, source);
+    toucher(c, cible);
+    c->dist[AVANT][source] = 0;
+    c->dist[ARRIERE][cible] = 0;
+    file_priorite_inserer(c->file[AVANT], source, 0);
+    file_priorite_inserer(c->file[ARRIERE], cible, 0);
+    int meilleur = source == cible ? 0 : INF;
+    *milieu = source == cible ? source : -1;
+    *nb_regles = 0;
+
+    for (;;) {
+        /* a search stops once its smallest key cannot improve the best meeting */
+        int min[2];
+        for (int s = 0; s < 2; ++s)
+            min[s] = file_priorite_est_vide(c->file[s]) ? INF
+                                                        : c->file[s]->cle[file_priorite_min(c->file[s])];
+        if (min[AVANT] >= meilleur && min[ARRIERE] >= meilleur) break;
+        int cote = min[AVANT] >= meilleur ? ARRIERE
+                 : min[ARRIERE] >= meilleur ? AVANT
+                 : min[AVANT] <= min[ARRIERE] ? AVANT : ARRIERE;
+        int autre = 1 - cote;
+        int d;
+        int u = file_priorite_extraire_min(c->file[cote], &d);
+        (*nb_regles)++;
+
+        const GrapheCSR *g = cote == AVANT ? h->montant : h->descendant;
+        const GrapheCSR *inverse = cote == AVANT ? h->descendant : h->montant;
+
+        /* stall-on-demand: a higher vertex already gives u a shorter
+           distance, so u is not on a shortest upward path */
+        int cale = 0;
+        for (int k = inverse->debut[u]; k < inverse->debut[u + 1] && !cale; ++k) {
+            int x = inverse->dest[k];
+            int dx = distance_touchee(c, cote, x);
+            cale = dx < INF && dx + inverse->poids[k] < d;
+        }
+        if (cale) continue;
+
+        for (int k = g->debut[u]; k < g->debut[u + 1]; ++k) {
+            int v = g->dest[k];
+            int nd = d + g->poids[k];
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (nd >= INF) continue; /* keeps the meeting sums below INT_MAX */
+            toucher(c, v);
+            if (nd < c->dist[cote][v]) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                c->dist[cote][v] = nd;
+                c->pred[cote][v] = u;
+                file_priorite_inserer(c->file[cote], v, nd);
+            }
+            if (c->dist[autre][v] < INF && c->dist[cote][v] + c->dist[autre][v] < meilleur) {
+                meilleur = c->dist[cote][v] + c->dist[autre][v];
+                *milieu = v;
+            }
+        }
+    }
+    return meilleur;
+}
+
+int hierarchie_distance(ContexteHierarchie *c, int source, int cible) {
+    if (!c) return INF;
+    int n = c->h->nb_sommets;
+    if (source < 0 || source >= n || cible < 0 || cible >= n) return INF;
+    int milieu, regles;
+    INSTR_PHASE_DEBUT(phase, "hierarchie_distance");
+    int d = rechercher(c, source, cible, &milieu, &regles);
+    INSTR_PHASE_FIN(phase);
+    return d;
+}
+
+/* Bypassed vertex of the hierarchy arc a -> b (original direction), -2 if none */
+static int milieu_arc(const HierarchieContraction *h, int a, int b) {
+    const GrapheCSR *g = h->rang[a] < h->rang[b] ? h->montant : h->descendant;
+    const int *milieu = h->rang[a] < h->rang[b] ? h->milieu_montant : h->milieu_descendant;
+    int ligne = h->rang[a] < h->rang[b] ? a : b, x = h->rang[a] < h->rang[b] ? b : a;
+    for (int k = g->debut[ligne]; k < g->debut[ligne + 1]; ++k)
+        if (g->dest[k] == x) return milieu[k];
+    return -2;
+}
+
+int hierarchie_chemin(ContexteHierarchie *c, int source, int cible, Chemin *chemin) {
+    if (!chemin) return 0;
+    chemin->distance = INF;
+    chemin->nb_sommets = 0;
+    chemin->sommets = NULL;
+    chemin->nb_regles = 0;
+    if (!c) return 0;
+    const HierarchieContraction *h = c->h;
+    int n = h->nb_sommets;
+    if (source < 0 || source >= n || cible < 0 || cible >= n) return 0;
+
+    INSTR_PHASE_DEBUT(phase, "hierarchie_chemin");
+    int milieu;
+    int d = rechercher(c, source, cible, &milieu, &chemin->nb_regles);
+    if (milieu < 0) {
+        INSTR_PHASE_FIN(phase);
+        return 0;
+    }
+
+    /* path in the hierarchy: up from the source, then down to the target */
+    int k = 0;
+    for (int v = milieu; v != -1; v = c->pred[AVANT][v]) c->etapes[k++] = v;
+    for (int i = 0, j = k - 1; i < j; ++i, --j) {
+        int t = c->etapes[i];
+        c->etapes[i] = c->etapes[j];
+        c->etapes[j] = t;
+    }
+    for (int v = c->pred[ARRIERE][milieu]; v != -1; v = c->pred[ARRIERE][v]) c->etapes[k++] = v;
+
+    /* unpack each arc: a shortcut a -> b through m becomes a -> m, m -> b */
+    int nb = 0, ok = 1;
+    c->sommets[nb++] = source;
+    for (int i = 0; ok && i + 1 < k; ++i) {
+        int haut = 0;
+        c->pile[haut++] = c->etapes[i];
+        c->pile[haut++] = c->etapes[i + 1];
+        while (ok && haut > 0) {
+            int b = c->pile[--haut], a = c->pile[--haut];
+            int m = milieu_arc(h, a, b);
+            if (m == -1) {
+                ok = nb < n;
+                if (ok) c->sommets[nb++] = b;
+            } else if (m >= 0 && haut + 4 <= 2 * (n + 1)) {
+                c->pile[haut++] = m;
+                c->pile[haut++] = b;
+                c->pile[haut++] = a;
+                c->pile[haut++] = m;
+            } else {
+                ok = 0; /* not a hierarchy arc: corrupted hierarchy */
+            }
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+    if (!ok) return 0;
+    chemin->distance = d;
+    chemin->nb_sommets = nb;
+    chemin->sommets = c->sommets;
+    return 1;
+}
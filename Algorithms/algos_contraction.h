@@ -0,0 +1,74 @@
+/* algos_contraction.h */
+#ifndef ALGOS_CONTRACTION_H
+#define ALGOS_CONTRACTION_H
+
+#include "GrapheValueListe.h"
+#include "GrapheCSR.h"
+#include "algos_chemins.h"
+
+/* Contraction hierarchies, for many shortest-path queries on a graph
+   whose arcs and weights do not change (non-negative weights).
+
+   Preprocessing removes the vertices one by one in order of importance.
+   Removing v adds a shortcut u -> w, weighted d(u, v) + d(v, w), for each
+   pair of neighbors whose shortest path goes through v (a bounded local
+   Dijkstra from u, the witness search, looks for another path). Each
+   round computes the priorities of the vertices whose neighborhood
+   changed, picks the vertices whose priority is smaller than that of all
+   their remaining neighbors (an independent set), and contracts them
+   together; the witness searches run on nb_threads threads. The priority
+   favors few shortcuts, then vertices with few removed neighbors and a
+   low depth in the hierarchy.
+
+   A query only follows arcs towards vertices contracted later: a forward
+   search from the source over montant and a backward one from the target
+   over descendant meet at the highest vertex of a shortest path.
+   Vertices reached through a better arc from above are not expanded
+   (stall-on-demand). Shortcuts are unpacked through the vertex they
+   bypass to give the path in the original graph. */
+
+#define HIERARCHIE_TEMOINS_MAX 500 /* vertices settled by a witness search */
+#define HIERARCHIE_VERSION     1
+
+typedef struct {
+    int nb_sommets;
+    int oriente;           /* of the graph the hierarchy comes from */
+    int *rang;             /* rang[v] = position of v in the contraction order */
+    GrapheCSR *montant;    /* row v: arcs v -> x with rang[x] > rang[v] */
+    GrapheCSR *descendant; /* row v: arcs x -> v with rang[x] > rang[v], stored
+                              as v -> x; the same snapshot as montant when the
+                              graph is not oriented */
+    int *milieu_montant;   /* per arc, the vertex a shortcut bypasses, -1 = original arc */
+    int *milieu_descendant;
+    int nb_raccourcis;     /* arcs that are shortcuts */
+    int nb_rondes;         /* independent sets contracted */
+} HierarchieContraction;
+
+/* nb_threads <= 0 means one thread per processor. NULL on error. */
+HierarchieContraction *hierarchie_construire(GrapheValueListe *g, int nb_threads);
+void hierarchie_detruire(HierarchieContraction *h);
+
+/* Files: 64-byte header (magic "GRAPHECH", version, oriented flag,
+   counts, file size) then the little-endian int32 arrays rang,
+   montant (debut, dest, poids, milieu) and, for an oriented graph,
+   descendant. 1 = ok / NULL if the file is missing or invalid
+   (every offset and vertex is checked). */
+int hierarchie_ecrire(const HierarchieContraction *h, const char *chemin);
+HierarchieContraction *hierarchie_ouvrir(const char *chemin);
+
+/* Per-query arrays, reused between the queries of one hierarchy; each
+   query only resets the vertices it touched */
+typedef struct ContexteHierarchie ContexteHierarchie;
+
+ContexteHierarchie *contexte_hierarchie_creer(const HierarchieContraction *h);
+void contexte_hierarchie_detruire(ContexteHierarchie *c);
+
+/* Distance from source to cible, 1000000000 if unreachable or invalid */
+int hierarchie_distance(ContexteHierarchie *c, int source, int cible);
+
+/* Same contract as chemin_bidirectionnel: 1 if cible is reachable, the
+   unpacked path in chemin (owned by the context), nb_regles counting
+   the vertices settled in the hierarchy */
+int hierarchie_chemin(ContexteHierarchie *c, int source, int cible, Chemin *chemin);
+
+#endif /* ALGOS_CONTRACTION_H */
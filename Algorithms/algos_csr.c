@@ -0,0 +1,295 @@
+/* algos_csr.c DFS, BFS, connectivity and Dijkstra on CSR snapshots */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "algos_csr.h"
+#include "FilePriorite.h"
+#include "algos_scc.h"
+#include "Instrumentation.h"
+
+#define INF 1000000000
+
+/* ---------- DFS (explicit stack) ---------- */
+
+/* pile[] holds the vertices of the current path, pos[] the next arc
+   to look at for each of them, so the visit order is exactly the one
+   of the recursive version. */
+static void dfs_depuis(const GrapheCSR *g, int s, int *visite, int *pile, int *pos) {
+    int sommet = 0;
+    pile[sommet] = s;
+    pos[sommet] = g->debut[s];
+    visite[s] = 1;
+    printf("%d ", s);
+
+    while (sommet >= 0) {
+        int v = pile[sommet];
+        if (pos[sommet] < g->debut[v + 1]) {
+            int u = g->dest[pos[sommet]++];
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (!visite[u]) {
+                visite[u] = 1;
+                printf("%d ", u);
+                sommet++;
+                pile[sommet] = u;
+                pos[sommet] = g->debut[u];
+            }
+        } else {
+            sommet--;
+        }
+    }
+}
+
+void dfs_composantes_connexes_csr(const GrapheCSR *g) {
+    int n = graphe_csr_ordre(g);
+    if (n == 0) return;
+    int *visite = (int *)calloc(n, sizeof(int));
+    int *pile = (int *)malloc(n * sizeof(int));
+    int *pos = (int *)malloc(n * sizeof(int));
+    if (!visite || !pile || !pos) {
+        free(visite);
+        free(pile);
+        free(pos);
+        return;
+    }
+
+    INSTR_PHASE_DEBUT(phase, "dfs_composantes_connexes_csr");
+    int num_comp = 0;
+    for (int v = 0; v < n; ++v) {
+        if (!visite[v]) {
+            num_comp++;
+            printf("Component %d: ", num_comp);
+            dfs_depuis(g, v, visite, pile, pos);
+            printf("\n");
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    free(visite);
+    free(pile);
+    free(pos);
+}
+
+/* ---------- BFS and distances ---------- */
+
+void bfs_distances_csr(const GrapheCSR *g, int source, int *dist) {
+    int n = graphe_csr_ordre(g);
+    if (source < 0 || source >= n) return;
+
+    for (int i = 0; i < n; ++i) dist[i] = -1;
+    dist[source] = 0;
+
+    int *queue = (int *)malloc(n * sizeof(int));
+    if (!queue) return;
+
+    INSTR_PHASE_DEBUT(phase, "bfs_distances_csr");
+    int head = 0, tail = 0;
+    queue[tail++] = source;
+
+    while (head < tail) {
+        int v = queue[head++];
+        INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[v + 1] - g->debut[v]);
+        for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+            int u = g->dest[k];
+            if (dist[u] == -1) {
+                dist[u] = dist[v] + 1;
+                queue[tail++] = u;
+            }
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    free(queue);
+}
+
+/* ---------- Connectivity ---------- */
+
+static int tous_atteints(const int *dist, int n) {
+    for (int i = 0; i < n; ++i)
+        if (dist[i] == -1) return 0;
+    return 1;
+}
+
+int graphe_csr_est_connexe(const GrapheCSR *g) {
+    int n = graphe_csr_ordre(g);
+    if (n == 0) return 1;
+
+    int *dist = (int *)malloc(n * sizeof(int));
+    if (!dist) return 0;
+
+    INSTR_PHASE_DEBUT(phase, "graphe_csr_est_connexe");
+    bfs_distances_csr(g, 0, dist);
+    int res = tous_atteints(dist, n);
+    INSTR_PHASE_FIN(phase);
+    free(dist);
+    return res;
+}
+
+/* One Tarjan pass (O(V+E)) instead of a BFS from every vertex */
+int graphe_csr_est_fortement_connexe(const GrapheCSR *g) {
+    int n = graphe_csr_ordre(g);
+    if (n == 0) return 1;
+
+    int *composante = (int *)malloc(n * sizeof(int));
+    if (!composante) return 0;
+
+    INSTR_PHASE_DEBUT(phase, "graphe_csr_est_fortement_connexe");
+    int nb = composantes_fortes_etiqueter_csr(g, composante);
+    INSTR_PHASE_FIN(phase);
+    free(composante);
+    return nb == 1;
+}
+
+/* ---------- Multi-source BFS ---------- */
+
+/* One batch of at most MSBFS_LARGEUR sources. Masks of a vertex are mots
+   consecutive words: vu = sources that reached it, visite = sources whose
+   frontier contains it, suivant = sources reaching it at the next level. */
+static int msbfs_lot(const GrapheCSR *g, const int *sources, int nb, int premier,
+                     int *dist, RappelMSBFS rappel, void *ctx) {
+    int n = g->nb_sommets;
+    int mots = (nb + 63) / 64;
+    uint64_t *vu = (uint64_t *)calloc((size_t)n * mots, sizeof(uint64_t));
+    uint64_t *visite = (uint64_t *)calloc((size_t)n * mots, sizeof(uint64_t));
+    uint64_t *suivant = (uint64_t *)calloc((size_t)n * mots, sizeof(uint64_t));
+    if (!vu || !visite || !suivant) {
+        free(vu);
+        free(visite);
+        free(suivant);
+        return 0;
+    }
+
+    for (int i = 0; i < nb; ++i) {
+        int s = sources[i];
+        uint64_t bit = (uint64_t)1 << (i & 63);
+        vu[(size_t)s * mots + (i >> 6)] |= bit;
+        visite[(size_t)s * mots + (i >> 6)] |= bit;
+        if (dist) dist[(size_t)(premier + i) * n + s] = 0;
+        if (rappel) rappel(premier + i, s, 0, ctx);
+    }
+
+    int actif = nb > 0;
+    for (int niveau = 1; actif; ++niveau) {
+        /* push every frontier mask along the arcs */
+        for (int v = 0; v < n; ++v) {
+            const uint64_t *mv = visite + (size_t)v * mots;
+            uint64_t tout = 0;
+            for (int w = 0; w < mots; ++w) tout |= mv[w];
+            if (!tout) continue;
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[v + 1] - g->debut[v]);
+            for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+                uint64_t *mu = suivant + (size_t)g->dest[k] * mots;
+                for (int w = 0; w < mots; ++w) mu[w] |= mv[w];
+            }
+        }
+
+        /* keep the sources new to each vertex, they form the next frontier */
+        actif = 0;
+        for (int v = 0; v < n; ++v) {
+            uint64_t *ms = suivant + (size_t)v * mots;
+            uint64_t *mvu = vu + (size_t)v * mots;
+            uint64_t *mv = visite + (size_t)v * mots;
+            for (int w = 0; w < mots; ++w) {
+                uint64_t nouveau = ms[w] & ~mvu[w];
+                ms[w] = 0;
+                mv[w] = nouveau;
+                if (!nouveau) continue;
+                mvu[w] |= nouveau;
+                actif = 1;
+                for (; nouveau; nouveau &= nouveau - 1) {
+                    int i = premier + w * 64 + __builtin_ctzll(nouveau);
+                    if (dist) dist[(size_t)i * n + v] = niveau;
+                    if (rappel) rappel(i, v, niveau, ctx);
+                }
+            }
+        }
+    }
+
+    free(vu);
+    free(visite);
+    free(suivant);
+    return 1;
+}
+
+static int msbfs(const GrapheCSR *g, const int *sources, int nb_sources, int *dist,
+                 RappelMSBFS rappel, void *ctx) {
+    int n = graphe_csr_ordre(g);
+    if (!sources || nb_sources < 0) return 0;
+    for (int i = 0; i < nb_sources; ++i)
+        if (sources[i] < 0 || sources[i] >= n) return 0;
+
+    INSTR_PHASE_DEBUT(phase, "bfs_multi_sources_csr");
+    if (dist)
+        for (size_t k = 0; k < (size_t)nb_sources * n; ++k) dist[k] = -1;
+    int ok = 1;
+    for (int premier = 0; ok && premier < nb_sources; premier += MSBFS_LARGEUR) {
+        int nb = nb_sources - premier < MSBFS_LARGEUR ? nb_sources - premier : MSBFS_LARGEUR;
+        ok = msbfs_lot(g, sources + premier, nb, premier, dist, rappel, ctx);
+    }
+    INSTR_PHASE_FIN(phase);
+    return ok;
+}
+
+int bfs_multi_sources_csr(const GrapheCSR *g, const int *sources, int nb_sources, int *dist) {
+    if (!dist) return 0;
+    return msbfs(g, sources, nb_sources, dist, NULL, NULL);
+}
+
+int bfs_multi_sources_csr_rappel(const GrapheCSR *g, const int *sources, int nb_sources,
+                                 RappelMSBFS rappel, void *ctx) {
+    if (!rappel) return 0;
+    return msbfs(g, sources, nb_sources, NULL, rappel, ctx);
+}
+
+int bfs_multi_sources(GrapheListe *g, const int *sources, int nb_sources, int *dist) {
+    INSTR_PHASE_DEBUT(gel, "bfs_multi_sources/gel");
+    GrapheCSR *c = graphe_csr_depuis_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return 0;
+    int ok = bfs_multi_sources_csr(c, sources, nb_sources, dist);
+    graphe_csr_detruire(c);
+    return ok;
+}
+
+/* ---------- Dijkstra ---------- */
+
+void dijkstra_csr(const GrapheCSR *g, int source, int *dist, int *pred) {
+    int n = graphe_csr_ordre(g);
+    if (source < 0 || source >= n || !graphe_csr_est_value(g)) return;
+
+    int *vu = (int *)calloc(n, sizeof(int));
+    FilePriorite *file = file_priorite_creer(n);
+    if (!vu || !file) {
+        free(vu);
+        file_priorite_detruire(file);
+        return;
+    }
+
+    INSTR_PHASE_DEBUT(phase, "dijkstra_csr");
+    for (int i = 0; i < n; ++i) {
+        dist[i] = INF;
+        pred[i] = -1;
+    }
+    dist[source] = 0;
+    file_priorite_inserer(file, source, 0);
+
+    while (!file_priorite_est_vide(file)) {
+        int u = file_priorite_extraire_min(file, NULL);
+        vu[u] = 1;
+
+        INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[u + 1] - g->debut[u]);
+        for (int a = g->debut[u]; a < g->debut[u + 1]; ++a) {
+            int v = g->dest[a];
+            int w = g->poids[a];
+            if (!vu[v] && dist[u] + w < dist[v]) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                dist[v] = dist[u] + w;
+                pred[v] = u;
+                file_priorite_inserer(file, v, dist[v]);
+            }
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    file_priorite_detruire(file);
+    free(vu);
+}
@@ -0,0 +1,38 @@
+/* algos_csr.h */
+#ifndef ALGOS_CSR_H
+#define ALGOS_CSR_H
+
+#include "GrapheCSR.h"
+
+/* Same contracts as the GrapheListe / GrapheValueListe versions,
+   but running on a frozen CSR snapshot. */
+
+void dfs_composantes_connexes_csr(const GrapheCSR *g);
+void bfs_distances_csr(const GrapheCSR *g, int source, int *dist);
+int  graphe_csr_est_connexe(const GrapheCSR *g);
+int  graphe_csr_est_fortement_connexe(const GrapheCSR *g);
+
+/* Multi-source BFS (MS-BFS): up to MSBFS_LARGEUR sources share one
+   traversal, each vertex carrying one bit per source in its seen / visit
+   masks, so every arc is read once per batch instead of once per source.
+   More sources are processed in successive batches.
+   dist is an nb_sources x order matrix, row i holding the distances from
+   sources[i] (-1 = unreachable), as bfs_distances would fill it.
+   The streaming version calls rappel(i, v, d, ctx) once for every vertex v
+   reached from sources[i], d being its distance, and stores nothing.
+   Both return 1, or 0 on error (bad source, memory). */
+#define MSBFS_LARGEUR 256 /* sources per batch: 4 words of 64 bits */
+
+typedef void (*RappelMSBFS)(int indice_source, int v, int distance, void *ctx);
+
+int bfs_multi_sources_csr(const GrapheCSR *g, const int *sources, int nb_sources, int *dist);
+int bfs_multi_sources_csr_rappel(const GrapheCSR *g, const int *sources, int nb_sources,
+                                 RappelMSBFS rappel, void *ctx);
+
+/* Same on a list graph, frozen to CSR once for all the sources */
+int bfs_multi_sources(GrapheListe *g, const int *sources, int nb_sources, int *dist);
+
+/* Requires a snapshot built from a GrapheValueListe */
+void dijkstra_csr(const GrapheCSR *g, int source, int *dist, int *pred);
+
+#endif /* ALGOS_CSR_H */
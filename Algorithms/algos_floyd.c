@@ -0,0 +1,317 @@
+/* algos_floyd.c Blocked Floyd-Warshall with scalar, AVX2 and AVX-512 tile kernels */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algos_floyd.h"
+#include "Parallele.h"
+#include "Instrumentation.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FLOYD_X86
+#include <immintrin.h>
+#endif
+
+#define INF 1000000000
+
+#define ALIGNEMENT 64 /* bytes: tile rows start on a cache line, aligned vector loads */
+
+/* ---------- Tile kernels ---------- */
+
+/* c = min(c, a (+) b) over the FLOYD_TUILE intermediate vertices of the
+   block, k outermost so that c may be a or b (the diagonal entries of
+   the diagonal tile are 0, row and column k do not move during step k).
+   sc / sa are the matching tiles of suivant, NULL without paths: an
+   improved c[i][j] takes the successor of i towards k. Rows whose
+   a[i][k] is unreachable are skipped. */
+typedef void (*NoyauFloyd)(int *c, int *sc, const int *a, const int *sa, const int *b, size_t pas);
+
+static void noyau_scalaire(int *c, int *sc, const int *a, const int *sa, const int *b, size_t pas) {
+    for (int k = 0; k < FLOYD_TUILE; ++k) {
+        const int *bk = b + k * pas;
+        for (int i = 0; i < FLOYD_TUILE; ++i) {
+            int aik = a[i * pas + k];
+            if (aik >= INF) continue;
+            int *ci = c + i * pas;
+            if (sc) {
+                int nik = sa[i * pas + k];
+                int *si = sc + i * pas;
+                for (int j = 0; j < FLOYD_TUILE; ++j) {
+                    int s = aik + bk[j];
+                    if (s < ci[j]) {
+                        ci[j] = s;
+                        si[j] = nik;
+                    }
+                }
+            } else {
+                for (int j = 0; j < FLOYD_TUILE; ++j) {
+                    int s = aik + bk[j];
+                    ci[j] = s < ci[j] ? s : ci[j];
+                }
+            }
+        }
+    }
+}
+
+#ifdef FLOYD_X86
+__attribute__((target("avx2")))
+static void noyau_avx2(int *c, int *sc, const int *a, const int *sa, const int *b, size_t pas) {
+    for (int k = 0; k < FLOYD_TUILE; ++k) {
+        const int *bk = b + k * pas;
+        for (int i = 0; i < FLOYD_TUILE; ++i) {
+            int aik = a[i * pas + k];
+            if (aik >= INF) continue;
+            __m256i va = _mm256_set1_epi32(aik);
+            int *ci = c + i * pas;
+            if (sc) {
+                __m256i vn = _mm256_set1_epi32(sa[i * pas + k]);
+                int *si = sc + i * pas;
+                for (int j = 0; j < FLOYD_TUILE; j += 8) {
+                    __m256i vc = _mm256_load_si256((const __m256i *)(ci + j));
+                    __m256i s = _mm256_add_epi32(va, _mm256_load_si256((const __m256i *)(bk + j)));
+                    __m256i plus_court = _mm256_cmpgt_epi32(vc, s);
+                    _mm256_store_si256((__m256i *)(ci + j), _mm256_min_epi32(vc, s));
+                    __m256i vs = _mm256_load_si256((const __m256i *)(si + j));
+                    _mm256_store_si256((__m256i *)(si + j), _mm256_blendv_epi8(vs, vn, plus_court));
+                }
+            } else {
+                for (int j = 0; j < FLOYD_TUILE; j += 8) {
+                    __m256i vc = _mm256_load_si256((const __m256i *)(ci + j));
+                    __m256i s = _mm256_add_epi32(va, _mm256_load_si256((const __m256i *)(bk + j)));
+                    _mm256_store_si256((__m256i *)(ci + j), _mm256_min_epi32(vc, s));
+                }
+            }
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+static void noyau_avx512(int *c, int *sc, const int *a, const int *sa, const int *b, size_t pas) {
+    for (int k = 0; k < FLOYD_TUILE; ++k) {
+        const int *bk = b + k * pas;
+        for (int i = 0; i < FLOYD_TUILE; ++i) {
+            int aik = a[i * pas + k];
+            if (aik >= INF) continue;
+            __m512i va = _mm512_set1_epi32(aik);
+            int *ci = c + i * pas;
+            if (sc) {
+                __m512i vn = _mm512_set1_epi32(sa[i * pas + k]);
+                int *si = sc + i * pas;
+                for (int j = 0; j < FLOYD_TUILE; j += 16) {
+                    __m512i vc = _mm512_load_si512((const void *)(ci + j));
+                    __m512i s = _mm512_add_epi32(va, _mm512_load_si512((const void *)(bk + j)));
+                    __mmask16 plus_court = _mm512_cmplt_epi32_mask(s, vc);
+                    _mm512_store_si512((void *)(ci + j), _mm512_min_epi32(vc, s));
+                    __m512i vs = _mm512_load_si512((const void *)(si + j));
+                    _mm512_store_si512((void *)(si + j), _mm512_mask_mov_epi32(vs, plus_court, vn));
+                }
+            } else {
+                for (int j = 0; j < FLOYD_TUILE; j += 16) {
+                    __m512i vc = _mm512_load_si512((const void *)(ci + j));
+                    __m512i s = _mm512_add_epi32(va, _mm512_load_si512((const void *)(bk + j)));
+                    _mm512_store_si512((void *)(ci + j), _mm512_min_epi32(vc, s));
+                }
+            }
+        }
+    }
+}
+#endif
+
+VarianteFloyd floyd_meilleure_variante(void) {
+#ifdef FLOYD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return FLOYD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return FLOYD_AVX2;
+#endif
+    return FLOYD_SCALAIRE;
+}
+
+const char *floyd_nom_variante(VarianteFloyd v) {
+    switch (v) {
+    case FLOYD_AUTO:     return "auto";
+    case FLOYD_SCALAIRE: return "scalaire";
+    case FLOYD_AVX2:     return "avx2";
+    case FLOYD_AVX512:   return "avx512";
+    }
+    return "?";
+}
+
+/* The requested version if the processor has it, the best one otherwise */
+static VarianteFloyd resoudre_variante(VarianteFloyd v) {
+    VarianteFloyd meilleure = floyd_meilleure_variante();
+    if (v == FLOYD_SCALAIRE) return v;
+    if (v == FLOYD_AVX2 && meilleure >= FLOYD_AVX2) return v;
+    if (v == FLOYD_AVX512 && meilleure == FLOYD_AVX512) return v;
+    return meilleure;
+}
+
+static NoyauFloyd noyau_de(VarianteFloyd v) {
+#ifdef FLOYD_X86
+    if (v == FLOYD_AVX512) return noyau_avx512;
+    if (v == FLOYD_AVX2) return noyau_avx2;
+#endif
+    (void)v;
+    return noyau_scalaire;
+}
+
+/* ---------- Blocked rounds ---------- */
+
+typedef struct {
+    int *dist;
+    int *suivant;
+    size_t pas;
+    int nb_blocs; /* tiles per row */
+    NoyauFloyd noyau;
+    BarriereParallele barriere;
+    int prochain_croix; /* next tile of the row / column of the round */
+    int prochain_reste; /* next tile of the rest */
+} EtatFloyd;
+
+static void tuile(const EtatFloyd *e, int bi, int bj, int bk) {
+    size_t t = FLOYD_TUILE;
+    size_t c = bi * t * e->pas + bj * t;
+    size_t a = bi * t * e->pas + bk * t;
+    size_t b = bk * t * e->pas + bj * t;
+    if (e->suivant)
+        e->noyau(e->dist + c, e->suivant + c, e->dist + a, e->suivant + a, e->dist + b, e->pas);
+    else
+        e->noyau(e->dist + c, NULL, e->dist + a, NULL, e->dist + b, e->pas);
+}
+
+static void tache_floyd(int id, int nb, void *arg) {
+    (void)nb;
+    EtatFloyd *e = (EtatFloyd *)arg;
+    int m = e->nb_blocs, t;
+    for (int kb = 0; kb < m; ++kb) {
+        if (id == 0) {
+            tuile(e, kb, kb, kb);
+            e->prochain_croix = 0;
+            e->prochain_reste = 0;
+        }
+        parallele_barriere_attendre(&e->barriere);
+        /* row kb then column kb, the diagonal tile left out */
+        while ((t = __atomic_fetch_add(&e->prochain_croix, 1, __ATOMIC_RELAXED)) < 2 * (m - 1)) {
+            int autre = t % (m - 1);
+            if (autre >= kb) autre++;
+            if (t < m - 1) tuile(e, kb, autre, kb);
+            else tuile(e, autre, kb, kb);
+        }
+        parallele_barriere_attendre(&e->barriere);
+        while ((t = __atomic_fetch_add(&e->prochain_reste, 1, __ATOMIC_RELAXED)) < (m - 1) * (m - 1)) {
+            int bi = t / (m - 1), bj = t % (m - 1);
+            if (bi >= kb) bi++;
+            if (bj >= kb) bj++;
+            tuile(e, bi, bj, kb);
+        }
+        parallele_barriere_attendre(&e->barriere);
+    }
+}
+
+static int *allouer_aligne(size_t nb) {
+    size_t taille = (nb * sizeof(int) + ALIGNEMENT - 1) / ALIGNEMENT * ALIGNEMENT;
+#ifdef _WIN32
+    return (int *)_aligned_malloc(taille, ALIGNEMENT);
+#else
+    return (int *)aligned_alloc(ALIGNEMENT, taille);
+#endif
+}
+
+static void liberer_aligne(int *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+void distances_toutes_paires_detruire(DistancesToutesPaires *d) {
+    if (!d) return;
+    liberer_aligne(d->dist);
+    liberer_aligne(d->suivant);
+    free(d);
+}
+
+DistancesToutesPaires *floyd_warshall_variante(const GrapheValueMatrice *g, int chemins,
+                                               int nb_threads, VarianteFloyd variante) {
+    if (!g) return NULL;
+    int n = graphe_value_matrice_ordre(g);
+    int m = (n + FLOYD_TUILE - 1) / FLOYD_TUILE;
+    if (m == 0) m = 1;
+    size_t pas = (size_t)m * FLOYD_TUILE;
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+
+    DistancesToutesPaires *d = (DistancesToutesPaires *)calloc(1, sizeof(DistancesToutesPaires));
+    if (!d) return NULL;
+    d->nb_sommets = n;
+    d->pas = (int)pas;
+    d->variante = resoudre_variante(variante);
+    d->dist = allouer_aligne(pas * pas);
+    d->suivant = chemins ? allouer_aligne(pas * pas) : NULL;
+    if (!d->dist || (chemins && !d->suivant)) {
+        distances_toutes_paires_detruire(d);
+        return NULL;
+    }
+
+    /* "0 = no edge" becomes unreachable, padding rows and columns too */
+    INSTR_PHASE_DEBUT(conversion, "floyd_warshall/conversion");
+    for (size_t i = 0; i < pas; ++i) {
+        int *di = d->dist + i * pas;
+        int *si = chemins ? d->suivant + i * pas : NULL;
+        for (size_t j = 0; j < pas; ++j) {
+            int w = i < (size_t)n && j < (size_t)n ? graphe_value_matrice_obtenir_poids(g, (int)i, (int)j) : 0;
+            if (i == j && i < (size_t)n) w = 0;
+            else if (w <= 0) w = INF;
+            di[j] = w;
+            if (si) si[j] = w < INF ? (int)j : -1;
+        }
+    }
+    INSTR_PHASE_FIN(conversion);
+
+    EtatFloyd e;
+    e.dist = d->dist;
+    e.suivant = d->suivant;
+    e.pas = pas;
+    e.nb_blocs = m;
+    e.noyau = noyau_de(d->variante);
+    e.prochain_croix = 0;
+    e.prochain_reste = 0;
+    /* no point in more threads than tiles of a round */
+    if (nb_threads > (m - 1) * (m - 1)) nb_threads = (m - 1) * (m - 1) > 0 ? (m - 1) * (m - 1) : 1;
+    if (!parallele_barriere_init(&e.barriere, nb_threads)) {
+        distances_toutes_paires_detruire(d);
+        return NULL;
+    }
+    INSTR_PHASE_DEBUT(phase, "floyd_warshall");
+    int ok = parallele_executer(nb_threads, tache_floyd, &e);
+    INSTR_PHASE_FIN(phase);
+    parallele_barriere_detruire(&e.barriere);
+    if (!ok) {
+        distances_toutes_paires_detruire(d);
+        return NULL;
+    }
+    return d;
+}
+
+DistancesToutesPaires *floyd_warshall(const GrapheValueMatrice *g, int chemins, int nb_threads) {
+    return floyd_warshall_variante(g, chemins, nb_threads, FLOYD_AUTO);
+}
+
+int floyd_distance(const DistancesToutesPaires *d, int i, int j) {
+    if (!d || i < 0 || i >= d->nb_sommets || j < 0 || j >= d->nb_sommets) return INF;
+    return d->dist[(size_t)i * d->pas + j];
+}
+
+int floyd_chemin(const DistancesToutesPaires *d, int i, int j, int *sommets) {
+    if (!d || !d->suivant || !sommets || floyd_distance(d, i, j) >= INF) return 0;
+    int k = 0;
+    sommets[k++] = i;
+    for (int v = i; v != j;) {
+        v = d->suivant[(size_t)v * d->pas + j];
+        if (v < 0 || k >= d->nb_sommets) return 0;
+        sommets[k++] = v;
+    }
+    return k;
+}
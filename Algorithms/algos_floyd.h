@@ -0,0 +1,56 @@
+/* algos_floyd.h */
+#ifndef ALGOS_FLOYD_H
+#define ALGOS_FLOYD_H
+
+#include "GrapheValueMatrice.h"
+
+/* All-pairs shortest paths on GrapheValueMatrice (Floyd-Warshall), with
+   the matrix cut into FLOYD_TUILE x FLOYD_TUILE tiles that stay in cache.
+   For each block of FLOYD_TUILE intermediate vertices, the diagonal tile
+   is updated first, then the tiles of its row and column, then all the
+   others; the tiles of the last two steps are independent and shared
+   between nb_threads threads (<= 0: one per processor).
+   The min-plus inner loop has a scalar version and, on x86 with GCC or
+   Clang, AVX2 and AVX-512 versions picked at run time from what the
+   processor supports. All versions give the same result.
+   Distances are expected to stay below 1000000000. */
+
+#define FLOYD_TUILE 64 /* tile side: three tiles of int fit in a 48 KiB L1 */
+
+typedef enum {
+    FLOYD_AUTO = 0, /* best version the processor supports */
+    FLOYD_SCALAIRE,
+    FLOYD_AVX2,
+    FLOYD_AVX512
+} VarianteFloyd;
+
+typedef struct {
+    int nb_sommets;
+    int pas;       /* row stride of dist and suivant, a multiple of FLOYD_TUILE */
+    int *dist;     /* dist[i * pas + j] = d(i, j), 1000000000 = unreachable, 0 for i = j */
+    int *suivant;  /* NULL unless paths were asked for: vertex after i on a
+                      shortest path from i to j, -1 if unreachable */
+    VarianteFloyd variante; /* version that ran */
+} DistancesToutesPaires;
+
+/* The "0 = no edge" entries of the matrix become unreachable pairs.
+   chemins = 1 also fills suivant (twice the memory, slower inner loop).
+   A variant the processor lacks falls back to the best one it has.
+   NULL if memory runs out or a thread cannot start. */
+DistancesToutesPaires *floyd_warshall(const GrapheValueMatrice *g, int chemins, int nb_threads);
+DistancesToutesPaires *floyd_warshall_variante(const GrapheValueMatrice *g, int chemins,
+                                               int nb_threads, VarianteFloyd variante);
+void distances_toutes_paires_detruire(DistancesToutesPaires *d);
+
+/* d(i, j), 1000000000 if unreachable or out of range */
+int floyd_distance(const DistancesToutesPaires *d, int i, int j);
+
+/* Writes the path i .. j (both included) in sommets (at least
+   nb_sommets entries) and returns its number of vertices, 0 if j is
+   unreachable or the paths were not computed */
+int floyd_chemin(const DistancesToutesPaires *d, int i, int j, int *sommets);
+
+VarianteFloyd floyd_meilleure_variante(void);
+const char *floyd_nom_variante(VarianteFloyd v);
+
+#endif /* ALGOS_FLOYD_H */
@@ -1,41 +1,178 @@
 /* algos_non_values.c DFS, BFS, connectivity */
 #include <stdio.h>
 #include <stdlib.h>
-#include "GrapheListe.h"
+#include <stdint.h>
+#include "algos_non_values.h"
+#include "algos_scc.h"
+#include "Instrumentation.h"
 
-/* ---------- DFS (recursive) ---------- */
+/* ---------- DFS (explicit stack) ---------- */
 
-static void dfs_rec(GrapheListe *g, int v, int *visite) {
-    visite[v] = 1;
-    printf("%d ", v);
+typedef struct {
+    uint64_t *vu;              /* discovered, one bit per vertex */
+    uint64_t *fini;            /* finished, only kept for arc classification */
+    int *decouverte;           /* discovery time, idem */
+    unsigned char *parent_vu;  /* non oriented: way back to the parent skipped */
+    int *chemin;               /* current DFS path */
+    ArcListe **curseur;        /* next arc of each vertex of the path */
+    int temps;
+} EtatDFS;
+
+static inline int bit_lire(const uint64_t *b, int v) {
+    return (int)((b[v >> 6] >> (v & 63)) & 1);
+}
+
+static inline void bit_mettre(uint64_t *b, int v) {
+    b[v >> 6] |= (uint64_t)1 << (v & 63);
+}
+
+static void etat_liberer(EtatDFS *e) {
+    free(e->vu);
+    free(e->fini);
+    free(e->decouverte);
+    free(e->parent_vu);
+    free(e->chemin);
+    free(e->curseur);
+}
+
+static int etat_init(EtatDFS *e, GrapheListe *g, const VisiteurDFS *vis) {
+    int n = graphe_liste_ordre(g);
+    int mots = (n + 63) / 64 + 1;
+    int classer = vis && vis->arc;
+    e->vu = (uint64_t *)calloc(mots, sizeof(uint64_t));
+    e->fini = classer ? (uint64_t *)calloc(mots, sizeof(uint64_t)) : NULL;
+    e->decouverte = classer ? (int *)malloc((n + 1) * sizeof(int)) : NULL;
+    e->parent_vu = classer && !graphe_liste_est_oriente(g) ? (unsigned char *)malloc(n + 1) : NULL;
+    e->chemin = (int *)malloc((n + 1) * sizeof(int));
+    e->curseur = (ArcListe **)malloc((n + 1) * sizeof(ArcListe *));
+    e->temps = 0;
+    if (!e->vu || !e->chemin || !e->curseur ||
+        (classer && (!e->fini || !e->decouverte)) ||
+        (classer && !graphe_liste_est_oriente(g) && !e->parent_vu)) {
+        etat_liberer(e);
+        return 0;
+    }
+    return 1;
+}
+
+static void decouvrir(GrapheListe *g, EtatDFS *e, const VisiteurDFS *vis, int prof, int v) {
+    bit_mettre(e->vu, v);
+    if (e->decouverte) e->decouverte[v] = e->temps++;
+    if (e->parent_vu) e->parent_vu[prof] = 0;
+    e->chemin[prof] = v;
+    e->curseur[prof] = graphe_liste_voisins(g, v);
+    if (vis->pre) vis->pre(v, vis->ctx);
+}
+
+/* The path and the arc cursors replace the call stack of the recursive
+   version, so the visit order is unchanged and the depth is unbounded. */
+static int parcourir(GrapheListe *g, int s, const VisiteurDFS *vis, EtatDFS *e) {
+    int prof = 0, nb = 1;
+    decouvrir(g, e, vis, 0, s);
 
-    ArcListe *voisin = graphe_liste_voisins(g, v);
-    while (voisin) {
-        int u = voisin->dest;
-        if (!visite[u]) {
-            dfs_rec(g, u, visite);
+    while (prof >= 0) {
+        int v = e->chemin[prof];
+        ArcListe *a = e->curseur[prof];
+        if (!a) {
+            if (e->fini) bit_mettre(e->fini, v);
+            if (vis->post) vis->post(v, vis->ctx);
+            prof--;
+            continue;
+        }
+        e->curseur[prof] = a->suivant;
+        int u = a->dest;
+        INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+
+        if (!bit_lire(e->vu, u)) {
+            if (vis->arc) vis->arc(v, u, ARC_ARBRE, vis->ctx);
+            nb++;
+            decouvrir(g, e, vis, ++prof, u);
+        } else if (vis->arc) {
+            if (e->parent_vu && prof > 0 && u == e->chemin[prof - 1] && !e->parent_vu[prof]) {
+                e->parent_vu[prof] = 1;
+                continue;
+            }
+            TypeArc type;
+            if (!bit_lire(e->fini, u)) type = ARC_ARRIERE;
+            else if (e->decouverte[u] > e->decouverte[v]) type = ARC_AVANT;
+            else type = ARC_TRANSVERSE;
+            vis->arc(v, u, type, vis->ctx);
         }
-        voisin = voisin->suivant;
     }
+    return nb;
 }
 
-/* Explore all vertices and print connected components (for non-oriented graphs) */
-void dfs_composantes_connexes(GrapheListe *g) {
-    int n = graphe_liste_ordre(g);
-    int *visite = (int *)calloc(n, sizeof(int));
-    if (!visite) return;
+int dfs_visiter(GrapheListe *g, int source, const VisiteurDFS *vis) {
+    if (!g || !vis || source < 0 || source >= graphe_liste_ordre(g)) return -1;
+    EtatDFS e;
+    if (!etat_init(&e, g, vis)) return -1;
+    INSTR_PHASE_DEBUT(phase, "dfs_visiter");
+    if (vis->racine) vis->racine(source, vis->ctx);
+    int nb = parcourir(g, source, vis, &e);
+    INSTR_PHASE_FIN(phase);
+    etat_liberer(&e);
+    return nb;
+}
 
-    int num_comp = 0;
+int dfs_visiter_tout(GrapheListe *g, const VisiteurDFS *vis) {
+    if (!g || !vis) return -1;
+    EtatDFS e;
+    if (!etat_init(&e, g, vis)) return -1;
+
+    INSTR_PHASE_DEBUT(phase, "dfs_visiter_tout");
+    int n = graphe_liste_ordre(g), nb = 0;
     for (int v = 0; v < n; ++v) {
-        if (!visite[v]) {
-            num_comp++;
-            printf("Component %d: ", num_comp);
-            dfs_rec(g, v, visite);
-            printf("\n");
-        }
+        if (bit_lire(e.vu, v)) continue;
+        if (vis->racine) vis->racine(v, vis->ctx);
+        parcourir(g, v, vis, &e);
+        nb++;
     }
+    INSTR_PHASE_FIN(phase);
+    etat_liberer(&e);
+    return nb;
+}
+
+typedef struct {
+    int *composante;
+    int courante;
+} CtxComposantes;
+
+static void composante_racine(int v, void *ctx) {
+    (void)v;
+    ((CtxComposantes *)ctx)->courante++;
+}
+
+static void composante_pre(int v, void *ctx) {
+    CtxComposantes *c = (CtxComposantes *)ctx;
+    c->composante[v] = c->courante;
+}
+
+int dfs_composantes(GrapheListe *g, int *composante) {
+    if (!composante) return -1;
+    CtxComposantes c = { composante, -1 };
+    VisiteurDFS vis = { composante_racine, composante_pre, NULL, NULL, &c };
+    return dfs_visiter_tout(g, &vis);
+}
+
+/* Printing wrapper, same output as the former recursive version */
+static void afficher_racine(int v, void *ctx) {
+    (void)v;
+    int *num_comp = (int *)ctx;
+    if (*num_comp > 0) printf("\n");
+    printf("Component %d: ", ++*num_comp);
+}
 
-    free(visite);
+static void afficher_sommet(int v, void *ctx) {
+    (void)ctx;
+    printf("%d ", v);
+}
+
+/* Explore all vertices and print connected components (for non-oriented graphs) */
+void dfs_composantes_connexes(GrapheListe *g) {
+    int num_comp = 0;
+    VisiteurDFS vis = { afficher_racine, afficher_sommet, NULL, NULL, &num_comp };
+    dfs_visiter_tout(g, &vis);
+    if (num_comp > 0) printf("\n");
 }
 
 /* ---------- BFS and distances ---------- */
@@ -51,6 +188,7 @@ void bfs_distances(GrapheListe *g, int source, int *dist) {
     int *queue = (int *)malloc(n * sizeof(int));
     if (!queue) return;
 
+    INSTR_PHASE_DEBUT(phase, "bfs_distances");
     int head = 0, tail = 0;
     queue[tail++] = source;
 
@@ -60,6 +198,7 @@ void bfs_distances(GrapheListe *g, int source, int *dist) {
         ArcListe *voisin = graphe_liste_voisins(g, v);
         while (voisin) {
             int u = voisin->dest;
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
             if (dist[u] == -1) {
                 dist[u] = dist[v] + 1;
                 queue[tail++] = u;
@@ -67,23 +206,170 @@ void bfs_distances(GrapheListe *g, int source, int *dist) {
             voisin = voisin->suivant;
         }
     }
+    INSTR_PHASE_FIN(phase);
 
     free(queue);
 }
 
+/* ---------- Direction-optimizing BFS ---------- */
+
+/* One step top-down: the queue frontier scans its successors */
+static int etape_descendante(GrapheListe *g, const int *frontiere, int nf, int *suivante,
+                             int *dist, int niveau, const int *deg, long *arcs_suivante) {
+    int ns = 0;
+    long arcs = 0;
+    for (int i = 0; i < nf; ++i) {
+        for (ArcListe *a = graphe_liste_voisins(g, frontiere[i]); a; a = a->suivant) {
+            int u = a->dest;
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (dist[u] != -1) continue;
+            dist[u] = niveau + 1;
+            suivante[ns++] = u;
+            arcs += deg[u];
+        }
+    }
+    *arcs_suivante = arcs;
+    return ns;
+}
+
+/* One step bottom-up: every unvisited vertex stops at its first
+   predecessor found in the frontier bitmap */
+static int etape_ascendante(GrapheListe *g, const uint64_t *frontiere, uint64_t *suivante,
+                            int mots, int *dist, int niveau, const int *deg, long *arcs_suivante) {
+    int n = graphe_liste_ordre(g), oriente = graphe_liste_est_oriente(g), ns = 0;
+    long arcs = 0;
+    for (int i = 0; i < mots; ++i) suivante[i] = 0;
+    for (int v = 0; v < n; ++v) {
+        if (dist[v] != -1) continue;
+        ArcListe *a = oriente ? graphe_liste_predecesseurs(g, v) : graphe_liste_voisins(g, v);
+        for (; a; a = a->suivant) {
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (!bit_lire(frontiere, a->dest)) continue;
+            dist[v] = niveau + 1;
+            bit_mettre(suivante, v);
+            ns++;
+            arcs += deg[v];
+            break;
+        }
+    }
+    *arcs_suivante = arcs;
+    return ns;
+}
+
+int bfs_distances_hybride(GrapheListe *g, int source, int *dist, DirectionBFS *directions) {
+    int n = graphe_liste_ordre(g);
+    if (source < 0 || source >= n) return -1;
+
+    int mots = (n + 63) / 64;
+    int *deg = (int *)malloc(n * sizeof(int));
+    int *file = (int *)malloc(n * sizeof(int));
+    int *file_suivante = (int *)malloc(n * sizeof(int));
+    uint64_t *bits = (uint64_t *)malloc(mots * sizeof(uint64_t));
+    uint64_t *bits_suivants = (uint64_t *)malloc(mots * sizeof(uint64_t));
+    int temporaire = graphe_liste_est_oriente(g) && !graphe_liste_predecesseurs_actifs(g);
+    int etapes = -1;
+    if (!deg || !file || !file_suivante || !bits || !bits_suivants) goto fin;
+    INSTR_PHASE_DEBUT(preparation, "bfs_distances_hybride/preparation");
+    if (temporaire && !graphe_liste_activer_predecesseurs(g)) {
+        temporaire = 0;
+        INSTR_PHASE_FIN(preparation);
+        goto fin;
+    }
+
+    long arcs_inexplores = 0;
+    for (int v = 0; v < n; ++v) {
+        deg[v] = 0;
+        for (ArcListe *a = graphe_liste_voisins(g, v); a; a = a->suivant) deg[v]++;
+        arcs_inexplores += deg[v];
+        dist[v] = -1;
+    }
+    INSTR_PHASE_FIN(preparation);
+
+    dist[source] = 0;
+    file[0] = source;
+    int nf = 1, nf_precedent = 0;
+    long arcs_frontiere = deg[source];
+    arcs_inexplores -= arcs_frontiere;
+    DirectionBFS direction = BFS_DESCENDANT;
+    etapes = 0;
+
+    while (nf > 0) {
+        /* Beamer's heuristic: the frontier is represented by the queue
+           top-down and by bits[] bottom-up, converted when switching */
+        if (direction == BFS_DESCENDANT && arcs_frontiere > arcs_inexplores / BFS_HYBRIDE_ALPHA) {
+            direction = BFS_ASCENDANT;
+            for (int i = 0; i < mots; ++i) bits[i] = 0;
+            for (int i = 0; i < nf; ++i) bit_mettre(bits, file[i]);
+        } else if (direction == BFS_ASCENDANT && nf < nf_precedent &&
+                   nf < n / BFS_HYBRIDE_BETA) {
+            direction = BFS_DESCENDANT;
+            int k = 0;
+            for (int i = 0; i < mots; ++i) {
+                for (uint64_t w = bits[i]; w; w &= w - 1)
+                    file[k++] = i * 64 + __builtin_ctzll(w);
+            }
+        }
+        if (directions) directions[etapes] = direction;
+
+        int ns;
+        if (direction == BFS_DESCENDANT) {
+            INSTR_PHASE_DEBUT(etape, "bfs_distances_hybride/descendant");
+            ns = etape_descendante(g, file, nf, file_suivante, dist, etapes, deg, &arcs_frontiere);
+            INSTR_PHASE_FIN(etape);
+            int *t = file;
+            file = file_suivante;
+            file_suivante = t;
+        } else {
+            INSTR_PHASE_DEBUT(etape, "bfs_distances_hybride/ascendant");
+            ns = etape_ascendante(g, bits, bits_suivants, mots, dist, etapes, deg, &arcs_frontiere);
+            INSTR_PHASE_FIN(etape);
+            uint64_t *t = bits;
+            bits = bits_suivants;
+            bits_suivants = t;
+        }
+        arcs_inexplores -= arcs_frontiere;
+        nf_precedent = nf;
+        nf = ns;
+        etapes++;
+    }
+
+fin:
+    if (temporaire) graphe_liste_desactiver_predecesseurs(g);
+    free(deg);
+    free(file);
+    free(file_suivante);
+    free(bits);
+    free(bits_suivants);
+    return etapes;
+}
+
 /* ---------- Connectivity ---------- */
 
 int graphe_liste_est_connexe(GrapheListe *g) {
     int n = graphe_liste_ordre(g);
-    if (n == 0) return 1;
+    if (n <= 0) return 1;
+    /* same question, answered by the union-find when it is maintained;
+       -1 means it could not be rebuilt, the BFS below still can answer */
+    if (!graphe_liste_est_oriente(g) && graphe_liste_connexite_active(g)) {
+        int nb = graphe_liste_nb_composantes(g);
+        if (nb >= 0) return nb <= 1;
+    }
+
+    /* removed vertices (see supprimer_sommet_differe) are left out, as
+       the union-find does */
+    int depart = 0;
+    while (depart < n && graphe_liste_est_supprime(g, depart)) depart++;
+    if (depart == n) return 1;
 
     int *dist = (int *)malloc(n * sizeof(int));
     if (!dist) return 0;
 
-    bfs_distances(g, 0, dist);
+    INSTR_PHASE_DEBUT(phase, "graphe_liste_est_connexe");
+    bfs_distances(g, depart, dist);
+    INSTR_PHASE_FIN(phase);
 
     for (int i = 0; i < n; ++i) {
-        if (dist[i] == -1) {
+        if (dist[i] == -1 && !graphe_liste_est_supprime(g, i)) {
             free(dist);
             return 0;
         }
@@ -92,26 +378,17 @@ int graphe_liste_est_connexe(GrapheListe *g) {
     return 1;
 }
 
-/* Strong connectivity for oriented graph:
-   We simply run BFS from every vertex and check that all others are reachable.
-   This is O(V * (V+E)) but easy to understand. */
+/* One Tarjan pass (O(V+E)) instead of a BFS from every vertex */
 int graphe_liste_est_fortement_connexe(GrapheListe *g) {
     int n = graphe_liste_ordre(g);
     if (n == 0) return 1;
 
-    int *dist = (int *)malloc(n * sizeof(int));
-    if (!dist) return 0;
+    int *composante = (int *)malloc(n * sizeof(int));
+    if (!composante) return 0;
 
-    for (int s = 0; s < n; ++s) {
-        bfs_distances(g, s, dist);
-        for (int i = 0; i < n; ++i) {
-            if (dist[i] == -1) {
-                free(dist);
-                return 0;
-            }
-        }
-    }
-
-    free(dist);
-    return 1;
+    INSTR_PHASE_DEBUT(phase, "graphe_liste_est_fortement_connexe");
+    int nb = composantes_fortes_etiqueter(g, composante);
+    INSTR_PHASE_FIN(phase);
+    free(composante);
+    return nb == 1;
 }
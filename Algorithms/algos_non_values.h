@@ -0,0 +1,67 @@
+/* algos_non_values.h */
+#ifndef ALGOS_NON_VALUES_H
+#define ALGOS_NON_VALUES_H
+
+#include "GrapheListe.h"
+
+/* ---------- DFS engine (explicit stack, no recursion) ---------- */
+
+typedef enum {
+    ARC_ARBRE,      /* discovers a new vertex */
+    ARC_ARRIERE,    /* to a vertex still on the DFS path (cycle) */
+    ARC_AVANT,      /* to an already finished descendant */
+    ARC_TRANSVERSE  /* to a finished vertex of another branch or tree */
+} TypeArc;
+
+/* Every callback may be NULL. Vertices and neighbors are visited in
+   adjacency list order, as the former recursive version did.
+   Non oriented graphs report each edge from both ends, except the way
+   back from a vertex to its parent: tree edges once as ARC_ARBRE, the
+   others as ARC_ARRIERE then ARC_AVANT. */
+typedef struct {
+    void (*racine)(int v, void *ctx);                  /* v starts a new DFS tree */
+    void (*pre)(int v, void *ctx);                     /* v discovered */
+    void (*post)(int v, void *ctx);                    /* all descendants of v done */
+    void (*arc)(int u, int v, TypeArc type, void *ctx);
+    void *ctx;
+} VisiteurDFS;
+
+/* One tree from source; returns the number of vertices reached, -1 on error */
+int dfs_visiter(GrapheListe *g, int source, const VisiteurDFS *vis);
+
+/* Whole graph, a new tree from each unvisited vertex in increasing order;
+   returns the number of trees, -1 on error */
+int dfs_visiter_tout(GrapheListe *g, const VisiteurDFS *vis);
+
+/* composante[v] = index of the DFS tree containing v (the connected
+   components for non-oriented graphs); returns their number, -1 on error */
+int dfs_composantes(GrapheListe *g, int *composante);
+
+/* Prints the components found by dfs_composantes, one line each */
+void dfs_composantes_connexes(GrapheListe *g);
+
+/* ---------- BFS and connectivity ---------- */
+
+void bfs_distances(GrapheListe *g, int source, int *dist);
+
+/* Direction-optimizing BFS (Beamer et al.): large middle levels are
+   expanded bottom-up, each unvisited vertex looking for a parent in a
+   bitmap of the frontier, which needs the reverse adjacency (oriented
+   graphs get their predecessor lists enabled for the duration of the
+   call if they were not). Same dist[] contract as bfs_distances.
+   directions (NULL or at least order entries) receives the direction of
+   each step; returns the number of steps, -1 on error. */
+typedef enum {
+    BFS_DESCENDANT, /* top-down: the frontier scans its successors */
+    BFS_ASCENDANT   /* bottom-up: unvisited vertices scan their predecessors */
+} DirectionBFS;
+
+#define BFS_HYBRIDE_ALPHA 14 /* go bottom-up when frontier arcs > unexplored arcs / alpha */
+#define BFS_HYBRIDE_BETA  24 /* back top-down when the shrinking frontier < order / beta */
+
+int bfs_distances_hybride(GrapheListe *g, int source, int *dist, DirectionBFS *directions);
+
+int  graphe_liste_est_connexe(GrapheListe *g);
+int  graphe_liste_est_fortement_connexe(GrapheListe *g);
+
+#endif /* ALGOS_NON_VALUES_H */
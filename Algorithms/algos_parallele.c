@@ -0,0 +1,621 @@
+/* algos_parallele.c Multithreaded BFS, connected components, delta-stepping and many-source Dijkstra on CSR snapshots */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "algos_parallele.h"
+#include "algos_csr.h"
+#include "Parallele.h"
+#include "FilePriorite.h"
+#include "Instrumentation.h"
+
+#define TAILLE_BLOC   64   /* frontier vertices taken at once by a thread */
+#define TAILLE_LOCALE 1024 /* per-thread buffer before publishing to the next frontier */
+
+#define INF 1000000000
+
+/* ---------- BFS ---------- */
+
+typedef struct {
+    const GrapheCSR *g;
+    int *dist;
+    int *frontiere;
+    int *suivante;
+    int nf;             /* size of frontiere */
+    int ns;             /* size of suivante, grown atomically */
+    int prochain;       /* next block of frontiere to take */
+    int niveau;
+    BarriereParallele barriere;
+} EtatBFS;
+
+static void publier(EtatBFS *e, const int *local, int nb) {
+    int pos = __atomic_fetch_add(&e->ns, nb, __ATOMIC_RELAXED);
+    memcpy(e->suivante + pos, local, nb * sizeof(int));
+}
+
+static void tache_bfs(int id, int nb, void *arg) {
+    (void)nb;
+    EtatBFS *e = (EtatBFS *)arg;
+    const GrapheCSR *g = e->g;
+    int local[TAILLE_LOCALE];
+
+    while (e->nf > 0) {
+        int nl = 0, debut, fin;
+        int niveau = e->niveau;
+        while (parallele_prendre_bloc(&e->prochain, e->nf, TAILLE_BLOC, &debut, &fin)) {
+            for (int i = debut; i < fin; ++i) {
+                int v = e->frontiere[i];
+                INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[v + 1] - g->debut[v]);
+                for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+                    int u = g->dest[k];
+                    int attendu = -1;
+                    /* plain load first: most neighbors are already visited */
+                    if (__atomic_load_n(&e->dist[u], __ATOMIC_RELAXED) != -1) continue;
+                    if (!__atomic_compare_exchange_n(&e->dist[u], &attendu, niveau + 1, 0,
+                                                     __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                        continue;
+                    local[nl++] = u;
+                    if (nl == TAILLE_LOCALE) {
+                        publier(e, local, nl);
+                        nl = 0;
+                    }
+                }
+            }
+        }
+        if (nl > 0) publier(e, local, nl);
+
+        parallele_barriere_attendre(&e->barriere);
+        if (id == 0) {
+            int *t = e->frontiere;
+            e->frontiere = e->suivante;
+            e->suivante = t;
+            e->nf = e->ns;
+            e->ns = 0;
+            e->prochain = 0;
+            e->niveau++;
+        }
+        parallele_barriere_attendre(&e->barriere);
+    }
+}
+
+int bfs_distances_parallele_csr(const GrapheCSR *g, int source, int *dist, int nb_threads) {
+    int n = graphe_csr_ordre(g);
+    if (source < 0 || source >= n || !dist) return 0;
+    nb_threads = parallele_resoudre_nb_threads(nb_threads);
+
+    EtatBFS e;
+    e.g = g;
+    e.dist = dist;
+    e.frontiere = (int *)malloc(n * sizeof(int));
+    e.suivante = (int *)malloc(n * sizeof(int));
+    if (!e.frontiere || !e.suivante || !parallele_barriere_init(&e.barriere, nb_threads)) {
+        free(e.frontiere);
+        free(e.suivante);
+        return 0;
+    }
+
+    for (int i = 0; i < n; ++i) dist[i] = -1;
+    dist[source] = 0;
+    e.frontiere[0] = source;
+    e.nf = 1;
+    e.ns = 0;
+    e.prochain = 0;
+    e.niveau = 0;
+
+    INSTR_PHASE_DEBUT(phase, "bfs_distances_parallele_csr");
+    int ok = parallele_executer(nb_threads, tache_bfs, &e);
+    INSTR_PHASE_FIN(phase);
+
+    parallele_barriere_detruire(&e.barriere);
+    free(e.frontiere);
+    free(e.suivante);
+    return ok;
+}
+
+int bfs_distances_parallele(GrapheListe *g, int source, int *dist, int nb_threads) {
+    INSTR_PHASE_DEBUT(gel, "bfs_distances_parallele/gel");
+    GrapheCSR *c = graphe_csr_depuis_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return 0;
+    int ok = bfs_distances_parallele_csr(c, source, dist, nb_threads);
+    graphe_csr_detruire(c);
+    return ok;
+}
+
+/* ---------- Connected components (Shiloach-Vishkin) ---------- */
+
+typedef struct {
+    const GrapheCSR *g;
+    int *comp;          /* parent pointers, roots are their own parent */
+    int change;
+    int fini;
+    int prochain_accrocher;
+    int prochain_compresser;
+    BarriereParallele barriere;
+} EtatSV;
+
+static inline int lire(const int *t, int i) {
+    return __atomic_load_n(&t[i], __ATOMIC_RELAXED);
+}
+
+static inline void ecrire(int *t, int i, int x) {
+    __atomic_store_n(&t[i], x, __ATOMIC_RELAXED);
+}
+
+static void tache_sv(int id, int nb, void *arg) {
+    (void)nb;
+    EtatSV *e = (EtatSV *)arg;
+    const GrapheCSR *g = e->g;
+    int n = g->nb_sommets, debut, fin;
+
+    while (!e->fini) {
+        /* hooking: a root adopts the smaller label seen across any arc
+           (both ways, so oriented graphs give their weak components) */
+        int change = 0;
+        while (parallele_prendre_bloc(&e->prochain_accrocher, n, TAILLE_BLOC, &debut, &fin)) {
+            for (int u = debut; u < fin; ++u) {
+                INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[u + 1] - g->debut[u]);
+                for (int k = g->debut[u]; k < g->debut[u + 1]; ++k) {
+                    int cu = lire(e->comp, u), cv = lire(e->comp, g->dest[k]);
+                    if (cu == cv) continue;
+                    int petit = cu < cv ? cu : cv, grand = cu < cv ? cv : cu;
+                    if (lire(e->comp, grand) == grand) {
+                        ecrire(e->comp, grand, petit);
+                        change = 1;
+                    }
+                }
+            }
+        }
+        if (change) __atomic_store_n(&e->change, 1, __ATOMIC_RELAXED);
+        parallele_barriere_attendre(&e->barriere);
+
+        /* pointer jumping: every vertex points straight to its root */
+        while (parallele_prendre_bloc(&e->prochain_compresser, n, TAILLE_BLOC, &debut, &fin)) {
+            for (int v = debut; v < fin; ++v) {
+                int c = lire(e->comp, v);
+                while (c != lire(e->comp, c)) c = lire(e->comp, c);
+                ecrire(e->comp, v, c);
+            }
+        }
+        parallele_barriere_attendre(&e->barriere);
+
+        if (id == 0) {
+            e->fini = !e->change;
+            e->change = 0;
+            e->prochain_accrocher = 0;
+            e->prochain_compresser = 0;
+        }
+        parallele_barriere_attendre(&e->barriere);
+    }
+}
+
+int composantes_connexes_parallele_csr(const GrapheCSR *g, int *composante, int nb_threads) {
+    int n = graphe_csr_ordre(g);
+    if (!composante) return -1;
+    if (n == 0) return 0;
+    nb_threads = parallele_resoudre_nb_threads(nb_threads);
+
+    EtatSV e;
+    e.g = g;
+    e.comp = composante;
+    e.change = 0;
+    e.fini = 0;
+    e.prochain_accrocher = 0;
+    e.prochain_compresser = 0;
+    if (!parallele_barriere_init(&e.barriere, nb_threads)) return -1;
+    for (int v = 0; v < n; ++v) composante[v] = v;
+
+    INSTR_PHASE_DEBUT(phase, "composantes_connexes_parallele_csr");
+    int ok = parallele_executer(nb_threads, tache_sv, &e);
+    INSTR_PHASE_FIN(phase);
+    parallele_barriere_detruire(&e.barriere);
+    if (!ok) return -1;
+
+    /* labels only ever decrease, so each root is the smallest vertex of
+       its component and comes before the other vertices of it */
+    int nb = 0;
+    for (int v = 0; v < n; ++v)
+        composante[v] = composante[v] == v ? nb++ : composante[composante[v]];
+    return nb;
+}
+
+int composantes_connexes_parallele(GrapheListe *g, int *composante, int nb_threads) {
+    INSTR_PHASE_DEBUT(gel, "composantes_connexes_parallele/gel");
+    GrapheCSR *c = graphe_csr_depuis_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return -1;
+    int nb = composantes_connexes_parallele_csr(c, composante, nb_threads);
+    graphe_csr_detruire(c);
+    return nb;
+}
+
+int graphe_csr_est_connexe_parallele(const GrapheCSR *g, int nb_threads) {
+    int n = graphe_csr_ordre(g);
+    if (n == 0) return 1;
+
+    int *composante = (int *)malloc(n * sizeof(int));
+    if (!composante) return 0;
+    int nb = composantes_connexes_parallele_csr(g, composante, nb_threads);
+    free(composante);
+    return nb == 1;
+}
+
+int graphe_liste_est_connexe_parallele(GrapheListe *g, int nb_threads) {
+    INSTR_PHASE_DEBUT(gel, "graphe_liste_est_connexe_parallele/gel");
+    GrapheCSR *c = graphe_csr_depuis_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return 0;
+    int res = graphe_csr_est_connexe_parallele(c, nb_threads);
+    graphe_csr_detruire(c);
+    return res;
+}
+
+/* ---------- Delta-stepping ---------- */
+
+typedef struct {
+    int *sommets;
+    int taille;
+    int capacite;
+} ListeSommets;
+
+static int liste_ajouter(ListeSommets *l, int v) {
+    if (l->taille == l->capacite) {
+        int capacite = l->capacite ? l->capacite * 2 : 16;
+        int *nv = (int *)realloc(l->sommets, capacite * sizeof(int));
+        if (!nv) return 0;
+        l->sommets = nv;
+        l->capacite = capacite;
+    }
+    l->sommets[l->taille++] = v;
+    return 1;
+}
+
+typedef struct {
+    ListeSommets *seaux;   /* circular: bucket b lives in seaux[b % nb_seaux] */
+    ListeSommets regles;   /* settled in the current bucket, heavy arcs pending */
+} LocalDelta;
+
+typedef struct {
+    const GrapheCSR *g;
+    int *dist;
+    int delta;
+    int nb_seaux;          /* > max weight / delta, so pushes never wrap onto a live bucket */
+    LocalDelta *locaux;
+    int *traite;           /* distance with which v last relaxed its light arcs */
+    unsigned char *dans_regles;
+    int *frontiere;        /* current bucket, gathered from every thread */
+    int capacite_frontiere;
+    int taille_totale;
+    int remplissage;
+    int curseur;
+    int courant;           /* current bucket */
+    int min_seau;          /* smallest non-empty bucket over all threads */
+    int lourds;            /* some thread has heavy arcs pending */
+    int erreur;
+    uint64_t *cle;         /* pred pass: (dist[u], u) of the best tight arc */
+    BarriereParallele barriere;
+} EtatDelta;
+
+static void relacher(EtatDelta *e, LocalDelta *l, int v, int d, int lourds) {
+    const GrapheCSR *g = e->g;
+    INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[v + 1] - g->debut[v]);
+    for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+        int w = g->poids[k];
+        if ((w > e->delta) != lourds) continue;
+        long long nd = (long long)d + w;
+        if (nd >= INF) continue;
+        int u = g->dest[k];
+        int ancien = __atomic_load_n(&e->dist[u], __ATOMIC_RELAXED);
+        while (nd < ancien) {
+            if (__atomic_compare_exchange_n(&e->dist[u], &ancien, (int)nd, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                if (!liste_ajouter(&l->seaux[(nd / e->delta) % e->nb_seaux], u))
+                    __atomic_store_n(&e->erreur, 1, __ATOMIC_RELAXED);
+                break;
+            }
+        }
+    }
+}
+
+static void tache_delta(int id, int nb, void *arg) {
+    (void)nb;
+    EtatDelta *e = (EtatDelta *)arg;
+    LocalDelta *l = &e->locaux[id];
+    int debut, fin;
+
+    for (;;) {
+        int c = e->courant, m = INT_MAX;
+        for (int j = 0; j < e->nb_seaux; ++j) {
+            if (l->seaux[(c + j) % e->nb_seaux].taille) {
+                m = c + j;
+                break;
+            }
+        }
+        parallele_min_atomique(&e->min_seau, m);
+        parallele_barriere_attendre(&e->barriere);
+        int b = e->min_seau, lourds = e->lourds;
+        parallele_barriere_attendre(&e->barriere);
+
+        /* bucket c is exhausted: its vertices are final, relax their heavy arcs */
+        if (b != c && lourds) {
+            for (int i = 0; i < l->regles.taille; ++i) {
+                int v = l->regles.sommets[i];
+                relacher(e, l, v, e->dist[v], 1);
+                e->dans_regles[v] = 0;
+            }
+            l->regles.taille = 0;
+            if (id == 0) {
+                e->lourds = 0;
+                e->min_seau = INT_MAX;
+            }
+            parallele_barriere_attendre(&e->barriere);
+            continue;
+        }
+        if (b == INT_MAX) break;
+
+        /* gather bucket b from every thread into the shared frontier */
+        ListeSommets *s = &l->seaux[b % e->nb_seaux];
+        __atomic_fetch_add(&e->taille_totale, s->taille, __ATOMIC_RELAXED);
+        if (id == 0) e->min_seau = INT_MAX;
+        parallele_barriere_attendre(&e->barriere);
+        if (id == 0) {
+            if (e->taille_totale > e->capacite_frontiere) {
+                int *nv = (int *)realloc(e->frontiere, e->taille_totale * sizeof(int));
+                if (nv) {
+                    e->frontiere = nv;
+                    e->capacite_frontiere = e->taille_totale;
+                } else {
+                    e->erreur = 1;
+                    e->taille_totale = 0; /* bail out: the result is discarded */
+                }
+            }
+            e->courant = b;
+            e->remplissage = 0;
+            e->curseur = 0;
+        }
+        parallele_barriere_attendre(&e->barriere);
+        if (e->taille_totale > 0 && s->taille > 0) {
+            int pos = __atomic_fetch_add(&e->remplissage, s->taille, __ATOMIC_RELAXED);
+            memcpy(e->frontiere + pos, s->sommets, s->taille * sizeof(int));
+        }
+        s->taille = 0;
+        parallele_barriere_attendre(&e->barriere);
+
+        /* light arcs; improved vertices may land in bucket b again */
+        while (parallele_prendre_bloc(&e->curseur, e->taille_totale, TAILLE_BLOC, &debut, &fin)) {
+            for (int i = debut; i < fin; ++i) {
+                int v = e->frontiere[i];
+                int d = __atomic_load_n(&e->dist[v], __ATOMIC_RELAXED);
+                if (d / e->delta != b) continue;
+                if (__atomic_exchange_n(&e->traite[v], d, __ATOMIC_RELAXED) == d) continue;
+                if (!__atomic_exchange_n(&e->dans_regles[v], 1, __ATOMIC_RELAXED)) {
+                    if (!liste_ajouter(&l->regles, v))
+                        __atomic_store_n(&e->erreur, 1, __ATOMIC_RELAXED);
+                    __atomic_store_n(&e->lourds, 1, __ATOMIC_RELAXED);
+                }
+                relacher(e, l, v, d, 0);
+            }
+        }
+        parallele_barriere_attendre(&e->barriere);
+        if (id == 0) e->taille_totale = 0;
+    }
+}
+
+/* pred[v] = tight predecessor with the smallest (dist, index): with
+   positive weights, the one dijkstra() settles first */
+static void tache_pred(int id, int nb, void *arg) {
+    (void)id;
+    (void)nb;
+    EtatDelta *e = (EtatDelta *)arg;
+    const GrapheCSR *g = e->g;
+    int debut, fin;
+    while (parallele_prendre_bloc(&e->curseur, g->nb_sommets, TAILLE_BLOC, &debut, &fin)) {
+        for (int u = debut; u < fin; ++u) {
+            int du = e->dist[u];
+            if (du >= INF) continue;
+            uint64_t cle = (uint64_t)du << 32 | (uint32_t)u;
+            for (int k = g->debut[u]; k < g->debut[u + 1]; ++k) {
+                int v = g->dest[k];
+                if ((long long)du + g->poids[k] != e->dist[v]) continue;
+                uint64_t ancien = __atomic_load_n(&e->cle[v], __ATOMIC_RELAXED);
+                while (cle < ancien &&
+                       !__atomic_compare_exchange_n(&e->cle[v], &ancien, cle, 1,
+                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    ;
+            }
+        }
+    }
+}
+
+int delta_stepping_csr(const GrapheCSR *g, int source, int *dist, int *pred,
+                       int delta, int nb_threads) {
+    int n = graphe_csr_ordre(g);
+    if (source < 0 || source >= n || !graphe_csr_est_value(g) || !dist || !pred) return 0;
+
+    int poids_max = 1;
+    for (int k = 0; k < g->nb_arcs; ++k) {
+        if (g->poids[k] <= 0) {
+            /* equal distances: the settling order of dijkstra() is not
+               a function of dist[] any more */
+            dijkstra_csr(g, source, dist, pred);
+            return 1;
+        }
+        if (g->poids[k] > poids_max) poids_max = g->poids[k];
+    }
+    if (delta <= 0) {
+        int degre_moyen = n > 0 && g->nb_arcs > n ? g->nb_arcs / n : 1;
+        delta = poids_max / degre_moyen > 0 ? poids_max / degre_moyen : 1;
+    }
+    nb_threads = parallele_resoudre_nb_threads(nb_threads);
+
+    EtatDelta e;
+    memset(&e, 0, sizeof(e));
+    e.g = g;
+    e.dist = dist;
+    e.delta = delta;
+    e.nb_seaux = poids_max / delta + 2;
+    e.min_seau = INT_MAX;
+    e.locaux = (LocalDelta *)calloc(nb_threads, sizeof(LocalDelta));
+    e.traite = (int *)malloc(n * sizeof(int));
+    e.dans_regles = (unsigned char *)calloc(n, 1);
+    e.cle = (uint64_t *)malloc(n * sizeof(uint64_t));
+    int ok = e.locaux && e.traite && e.dans_regles && e.cle;
+    for (int t = 0; ok && t < nb_threads; ++t) {
+        e.locaux[t].seaux = (ListeSommets *)calloc(e.nb_seaux, sizeof(ListeSommets));
+        if (!e.locaux[t].seaux) ok = 0;
+    }
+    if (ok) ok = parallele_barriere_init(&e.barriere, nb_threads);
+
+    if (ok) {
+        for (int v = 0; v < n; ++v) {
+            dist[v] = INF;
+            pred[v] = -1;
+            e.traite[v] = -1;
+            e.cle[v] = UINT64_MAX;
+        }
+        dist[source] = 0;
+        ok = liste_ajouter(&e.locaux[0].seaux[0], source);
+        INSTR_PHASE_DEBUT(seaux, "delta_stepping_csr/seaux");
+        if (ok) ok = parallele_executer(nb_threads, tache_delta, &e);
+        INSTR_PHASE_FIN(seaux);
+        if (ok && !e.erreur) {
+            e.curseur = 0;
+            INSTR_PHASE_DEBUT(predecesseurs, "delta_stepping_csr/predecesseurs");
+            ok = parallele_executer(nb_threads, tache_pred, &e);
+            INSTR_PHASE_FIN(predecesseurs);
+        } else {
+            ok = 0;
+        }
+        if (ok)
+            for (int v = 0; v < n; ++v)
+                if (v != source && e.cle[v] != UINT64_MAX) pred[v] = (int)(e.cle[v] & 0xffffffffu);
+        parallele_barriere_detruire(&e.barriere);
+    }
+
+    for (int t = 0; e.locaux && t < nb_threads; ++t) {
+        if (e.locaux[t].seaux)
+            for (int j = 0; j < e.nb_seaux; ++j) free(e.locaux[t].seaux[j].sommets);
+        free(e.locaux[t].seaux);
+        free(e.locaux[t].regles.sommets);
+    }
+    free(e.locaux);
+    free(e.traite);
+    free(e.dans_regles);
+    free(e.cle);
+    free(e.frontiere);
+    return ok;
+}
+
+int delta_stepping(GrapheValueListe *g, int source, int *dist, int *pred,
+                   int delta, int nb_threads) {
+    INSTR_PHASE_DEBUT(gel, "delta_stepping/gel");
+    GrapheCSR *c = graphe_csr_depuis_value_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return 0;
+    int ok = delta_stepping_csr(c, source, dist, pred, delta, nb_threads);
+    graphe_csr_detruire(c);
+    return ok;
+}
+
+/* ---------- Many-source Dijkstra ---------- */
+
+typedef struct {
+    const GrapheCSR *g;
+    const int *sources;
+    int nb_sources;
+    int *dist;               /* nb_sources x n table, NULL when streaming */
+    RappelDistances rappel;
+    void *ctx;
+    int prochaine;           /* next source to take */
+    int traitees;            /* sources done */
+} EtatMultiDijkstra;
+
+/* A settled vertex never improves again with non-negative weights, so
+   the heap alone tells what is left: no seen array to reset */
+static void dijkstra_ligne(const GrapheCSR *g, FilePriorite *file, int source, int *dist) {
+    for (int v = 0; v < g->nb_sommets; ++v) dist[v] = INF;
+    dist[source] = 0;
+    file_priorite_inserer(file, source, 0);
+    int du;
+    while (!file_priorite_est_vide(file)) {
+        int u = file_priorite_extraire_min(file, &du);
+        INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[u + 1] - g->debut[u]);
+        for (int k = g->debut[u]; k < g->debut[u + 1]; ++k) {
+            int v = g->dest[k];
+            int dv = du + g->poids[k];
+            if (dv < dist[v]) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                dist[v] = dv;
+                file_priorite_inserer(file, v, dv);
+            }
+        }
+    }
+}
+
+static void tache_multi_dijkstra(int id, int nb, void *arg) {
+    (void)nb;
+    EtatMultiDijkstra *e = (EtatMultiDijkstra *)arg;
+    if (__atomic_load_n(&e->prochaine, __ATOMIC_RELAXED) >= e->nb_sources) return;
+    int n = graphe_csr_ordre(e->g);
+    FilePriorite *file = file_priorite_creer(n);
+    int *ligne = e->dist ? NULL : (int *)malloc(n * sizeof(int));
+    /* a thread short of memory takes no source, the others do its share */
+    if (file && (e->dist || ligne)) {
+        int i;
+        while ((i = __atomic_fetch_add(&e->prochaine, 1, __ATOMIC_RELAXED)) < e->nb_sources) {
+            int *d = e->dist ? e->dist + (size_t)i * n : ligne;
+            dijkstra_ligne(e->g, file, e->sources[i], d);
+            if (e->rappel) e->rappel(i, d, id, e->ctx);
+            __atomic_fetch_add(&e->traitees, 1, __ATOMIC_RELAXED);
+        }
+    }
+    file_priorite_detruire(file);
+    free(ligne);
+}
+
+static int multi_dijkstra(const GrapheCSR *g, const int *sources, int nb_sources, int *dist,
+                          RappelDistances rappel, void *ctx, PoolThreads *pool) {
+    if (!g || !graphe_csr_est_value(g) || nb_sources < 0 || (nb_sources > 0 && !sources)) return 0;
+    int n = graphe_csr_ordre(g);
+    for (int i = 0; i < nb_sources; ++i)
+        if (sources[i] < 0 || sources[i] >= n) return 0;
+
+    EtatMultiDijkstra e;
+    e.g = g;
+    e.sources = sources;
+    e.nb_sources = nb_sources;
+    e.dist = dist;
+    e.rappel = rappel;
+    e.ctx = ctx;
+    e.prochaine = 0;
+    e.traitees = 0;
+    INSTR_PHASE_DEBUT(phase, "dijkstra_multi_sources_csr");
+    int ok = nb_sources == 0 || pool_threads_executer(pool, tache_multi_dijkstra, &e);
+    INSTR_PHASE_FIN(phase);
+    return ok && e.traitees == nb_sources;
+}
+
+int dijkstra_multi_sources_csr(const GrapheCSR *g, const int *sources, int nb_sources,
+                               int *dist, PoolThreads *pool) {
+    if (!dist) return 0;
+    return multi_dijkstra(g, sources, nb_sources, dist, NULL, NULL, pool);
+}
+
+int dijkstra_multi_sources_csr_rappel(const GrapheCSR *g, const int *sources, int nb_sources,
+                                      RappelDistances rappel, void *ctx, PoolThreads *pool) {
+    if (!rappel) return 0;
+    return multi_dijkstra(g, sources, nb_sources, NULL, rappel, ctx, pool);
+}
+
+int dijkstra_multi_sources(GrapheValueListe *g, const int *sources, int nb_sources,
+                           int *dist, PoolThreads *pool) {
+    INSTR_PHASE_DEBUT(gel, "dijkstra_multi_sources/gel");
+    GrapheCSR *c = graphe_csr_depuis_value_liste(g);
+    INSTR_PHASE_FIN(gel);
+    if (!c) return 0;
+    int ok = dijkstra_multi_sources_csr(c, sources, nb_sources, dist, pool);
+    graphe_csr_detruire(c);
+    return ok;
+}
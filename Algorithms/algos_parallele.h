@@ -0,0 +1,63 @@
+/* algos_parallele.h */
+#ifndef ALGOS_PARALLELE_H
+#define ALGOS_PARALLELE_H
+
+#include "GrapheListe.h"
+#include "GrapheCSR.h"
+#include "Parallele.h"
+
+/* Multithreaded traversals on CSR snapshots. nb_threads <= 0 means one
+   thread per processor. The list versions freeze the graph first. */
+
+/* Level-synchronous BFS, same dist[] contract as bfs_distances.
+   Returns 1, or 0 on error (bad source, memory, thread creation). */
+int bfs_distances_parallele_csr(const GrapheCSR *g, int source, int *dist, int nb_threads);
+int bfs_distances_parallele(GrapheListe *g, int source, int *dist, int nb_threads);
+
+/* Connected components (weak components for oriented graphs) by
+   Shiloach-Vishkin hooking and pointer jumping. composante[v] is
+   numbered by smallest vertex, like dfs_composantes on non oriented
+   graphs. Returns the number of components, -1 on error. */
+int composantes_connexes_parallele_csr(const GrapheCSR *g, int *composante, int nb_threads);
+int composantes_connexes_parallele(GrapheListe *g, int *composante, int nb_threads);
+
+/* Single component check (an empty graph is connected) */
+int graphe_csr_est_connexe_parallele(const GrapheCSR *g, int nb_threads);
+int graphe_liste_est_connexe_parallele(GrapheListe *g, int nb_threads);
+
+/* Delta-stepping single-source shortest paths (non-negative weights).
+   Vertices are processed by buckets of width delta: arcs of weight <= delta
+   (light) are relaxed until the bucket is empty, then heavy arcs once per
+   settled vertex. Threads keep their own circular bucket arrays.
+   dist / pred are identical to those of dijkstra() (1000000000 =
+   unreachable, pred -1 = none): pred[v] is recomputed at the end as the
+   tight predecessor the sequential algorithm settles first. Graphs with
+   zero weight arcs, where that order depends on the heap, are handed to
+   dijkstra_csr. delta <= 0 picks max weight / average out-degree.
+   Returns 1, or 0 on error (bad source, unweighted snapshot, memory). */
+int delta_stepping_csr(const GrapheCSR *g, int source, int *dist, int *pred,
+                       int delta, int nb_threads);
+int delta_stepping(GrapheValueListe *g, int source, int *dist, int *pred,
+                   int delta, int nb_threads);
+
+/* Many-source shortest paths (non-negative weights), for distance
+   tables: one heap Dijkstra per source, the sources shared between the
+   threads of pool (NULL = one thread per processor, see Parallele.h).
+   Each thread allocates its heap once and reuses it for all the sources
+   it takes. dist is an nb_sources x order matrix, row i holding the
+   distances from sources[i] as dijkstra() fills them (1000000000 =
+   unreachable). The streaming version stores nothing: rappel gets the
+   row of sources[i] from a per-thread buffer, valid during the call
+   only; calls come from every thread of the pool in no set order,
+   id_thread telling them apart. Both return 1, or 0 on error (bad
+   source, unweighted snapshot, memory). */
+typedef void (*RappelDistances)(int indice_source, const int *dist, int id_thread, void *ctx);
+
+int dijkstra_multi_sources_csr(const GrapheCSR *g, const int *sources, int nb_sources,
+                               int *dist, PoolThreads *pool);
+int dijkstra_multi_sources_csr_rappel(const GrapheCSR *g, const int *sources, int nb_sources,
+                                      RappelDistances rappel, void *ctx, PoolThreads *pool);
+int dijkstra_multi_sources(GrapheValueListe *g, const int *sources, int nb_sources,
+                           int *dist, PoolThreads *pool);
+
+#endif /* ALGOS_PARALLELE_H */
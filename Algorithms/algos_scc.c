@@ -0,0 +1,657 @@
+/* algos_scc.c Strongly connected components (Tarjan, forward-backward) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "algos_scc.h"
+#include "Parallele.h"
+#include "FilePriorite.h"
+#include "Instrumentation.h"
+
+#define SEUIL_TARJAN 4096 /* subsets up to this size are finished with Tarjan */
+
+/* ---------- Iterative Tarjan ---------- */
+
+/* Scratch space of one Tarjan run; index[] must be -1 everywhere on entry */
+typedef struct {
+    int *index;
+    int *bas;                /* lowlink */
+    int *pile;               /* vertices of the open components */
+    int *chemin;             /* current DFS path */
+    int *curseur;            /* next arc offset for each vertex of the path */
+    unsigned char *sur_pile;
+} TravailTarjan;
+
+static void liberer_travail(TravailTarjan *w) {
+    free(w->index);
+    free(w->bas);
+    free(w->pile);
+    free(w->chemin);
+    free(w->curseur);
+    free(w->sur_pile);
+}
+
+static int allouer_travail(TravailTarjan *w, int n) {
+    if (n <= 0) n = 1;
+    w->index = (int *)malloc(n * sizeof(int));
+    w->bas = (int *)malloc(n * sizeof(int));
+    w->pile = (int *)malloc(n * sizeof(int));
+    w->chemin = (int *)malloc(n * sizeof(int));
+    w->curseur = (int *)malloc(n * sizeof(int));
+    w->sur_pile = (unsigned char *)calloc(n, 1);
+    if (!w->index || !w->bas || !w->pile || !w->chemin || !w->curseur || !w->sur_pile) {
+        liberer_travail(w);
+        return 0;
+    }
+    for (int v = 0; v < n; ++v) w->index[v] = -1;
+    return 1;
+}
+
+/* Tarjan from each vertex of depart[] (every vertex if depart is NULL),
+   following only vertices whose couleur is c (no filter if couleur is NULL).
+   composante[v] receives the completion rank of its component, sinks
+   first, and the number of components found is returned. */
+static int tarjan_csr(const GrapheCSR *g, const int *depart, int nb_depart,
+                      atomic_int *couleur, int c, int *composante, TravailTarjan *w) {
+    int compteur = 0, haut = 0, nb = 0;
+
+    for (int i = 0; i < nb_depart; ++i) {
+        int s = depart ? depart[i] : i;
+        if (w->index[s] != -1) continue;
+
+        int prof = 0;
+        w->chemin[0] = s;
+        w->curseur[0] = g->debut[s];
+        w->index[s] = w->bas[s] = compteur++;
+        w->pile[haut++] = s;
+        w->sur_pile[s] = 1;
+
+        while (prof >= 0) {
+            int v = w->chemin[prof];
+            if (w->curseur[prof] < g->debut[v + 1]) {
+                int u = g->dest[w->curseur[prof]++];
+                INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+                if (couleur && atomic_load_explicit(&couleur[u], memory_order_relaxed) != c)
+                    continue;
+                if (w->index[u] == -1) {
+                    w->index[u] = w->bas[u] = compteur++;
+                    w->pile[haut++] = u;
+                    w->sur_pile[u] = 1;
+                    prof++;
+                    w->chemin[prof] = u;
+                    w->curseur[prof] = g->debut[u];
+                } else if (w->sur_pile[u] && w->index[u] < w->bas[v]) {
+                    w->bas[v] = w->index[u];
+                }
+            } else {
+                if (w->bas[v] == w->index[v]) {
+                    int x;
+                    do {
+                        x = w->pile[--haut];
+                        w->sur_pile[x] = 0;
+                        composante[x] = nb;
+                    } while (x != v);
+                    nb++;
+                }
+                prof--;
+                if (prof >= 0) {
+                    int p = w->chemin[prof];
+                    if (w->bas[v] < w->bas[p]) w->bas[p] = w->bas[v];
+                }
+            }
+        }
+    }
+    return nb;
+}
+
+/* Same algorithm walking the adjacency lists directly */
+static int tarjan_liste(GrapheListe *g, int *composante) {
+    int n = graphe_liste_ordre(g);
+    int *index = (int *)malloc(n * sizeof(int));
+    int *bas = (int *)malloc(n * sizeof(int));
+    int *pile = (int *)malloc(n * sizeof(int));
+    int *chemin = (int *)malloc(n * sizeof(int));
+    ArcListe **curseur = (ArcListe **)malloc(n * sizeof(ArcListe *));
+    unsigned char *sur_pile = (unsigned char *)calloc(n, 1);
+    int nb = -1;
+    if (!index || !bas || !pile || !chemin || !curseur || !sur_pile) goto fin;
+
+    for (int v = 0; v < n; ++v) index[v] = -1;
+    int compteur = 0, haut = 0;
+    nb = 0;
+
+    for (int s = 0; s < n; ++s) {
+        if (index[s] != -1) continue;
+
+        int prof = 0;
+        chemin[0] = s;
+        curseur[0] = graphe_liste_voisins(g, s);
+        index[s] = bas[s] = compteur++;
+        pile[haut++] = s;
+        sur_pile[s] = 1;
+
+        while (prof >= 0) {
+            int v = chemin[prof];
+            ArcListe *arc = curseur[prof];
+            if (arc) {
+                int u = arc->dest;
+                curseur[prof] = arc->suivant;
+                INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+                if (index[u] == -1) {
+                    index[u] = bas[u] = compteur++;
+                    pile[haut++] = u;
+                    sur_pile[u] = 1;
+                    prof++;
+                    chemin[prof] = u;
+                    curseur[prof] = graphe_liste_voisins(g, u);
+                } else if (sur_pile[u] && index[u] < bas[v]) {
+                    bas[v] = index[u];
+                }
+            } else {
+                if (bas[v] == index[v]) {
+                    int x;
+                    do {
+                        x = pile[--haut];
+                        sur_pile[x] = 0;
+                        composante[x] = nb;
+                    } while (x != v);
+                    nb++;
+                }
+                prof--;
+                if (prof >= 0) {
+                    int p = chemin[prof];
+                    if (bas[v] < bas[p]) bas[p] = bas[v];
+                }
+            }
+        }
+    }
+
+fin:
+    free(index);
+    free(bas);
+    free(pile);
+    free(chemin);
+    free(curseur);
+    free(sur_pile);
+    return nb;
+}
+
+/* Tarjan completes sink components first: reversing the ranks gives a
+   topological numbering */
+static void inverser_rangs(int *composante, int n, int nb) {
+    for (int v = 0; v < n; ++v) composante[v] = nb - 1 - composante[v];
+}
+
+int composantes_fortes_etiqueter(GrapheListe *g, int *composante) {
+    int n = graphe_liste_ordre(g);
+    if (n == 0) return 0;
+    INSTR_PHASE_DEBUT(phase, "composantes_fortes_etiqueter");
+    int nb = tarjan_liste(g, composante);
+    if (nb > 0) inverser_rangs(composante, n, nb);
+    INSTR_PHASE_FIN(phase);
+    return nb;
+}
+
+int composantes_fortes_etiqueter_csr(const GrapheCSR *g, int *composante) {
+    int n = graphe_csr_ordre(g);
+    if (n == 0) return 0;
+    TravailTarjan w;
+    if (!allouer_travail(&w, n)) return -1;
+    INSTR_PHASE_DEBUT(phase, "composantes_fortes_etiqueter_csr");
+    int nb = tarjan_csr(g, NULL, n, NULL, 0, composante, &w);
+    INSTR_PHASE_FIN(phase);
+    liberer_travail(&w);
+    inverser_rangs(composante, n, nb);
+    return nb;
+}
+
+/* ---------- Condensation ---------- */
+
+/* Arcs between components, without duplicates (exactly one of gl / gc is set) */
+static GrapheListe *construire_condensation(int n, const int *composante, int nb,
+                                            GrapheListe *gl, const GrapheCSR *gc) {
+    GrapheListe *cond = graphe_liste_creer(nb, 1);
+    int *debut = (int *)calloc(nb + 1, sizeof(int));
+    int *ordre = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    int *marque = (int *)malloc((nb > 0 ? nb : 1) * sizeof(int));
+    if (!cond || !debut || !ordre || !marque) {
+        graphe_liste_detruire(cond);
+        cond = NULL;
+        goto fin;
+    }
+    for (int c = 0; c < nb; ++c) {
+        graphe_liste_ajouter_sommet(cond);
+        marque[c] = -1;
+    }
+
+    /* group the vertices by component */
+    for (int v = 0; v < n; ++v) debut[composante[v] + 1]++;
+    for (int c = 0; c < nb; ++c) debut[c + 1] += debut[c];
+    for (int v = 0; v < n; ++v) ordre[debut[composante[v]]++] = v;
+    for (int c = nb; c > 0; --c) debut[c] = debut[c - 1];
+    debut[0] = 0;
+
+    for (int c = 0; c < nb; ++c) {
+        for (int i = debut[c]; i < debut[c + 1]; ++i) {
+            int v = ordre[i];
+            if (gl) {
+                for (ArcListe *a = graphe_liste_voisins(gl, v); a; a = a->suivant) {
+                    int d = composante[a->dest];
+                    if (d != c && marque[d] != c) {
+                        marque[d] = c;
+                        graphe_liste_ajouter_arc(cond, c, d);
+                    }
+                }
+            } else {
+                for (int k = gc->debut[v]; k < gc->debut[v + 1]; ++k) {
+                    int d = composante[gc->dest[k]];
+                    if (d != c && marque[d] != c) {
+                        marque[d] = c;
+                        graphe_liste_ajouter_arc(cond, c, d);
+                    }
+                }
+            }
+        }
+    }
+
+fin:
+    free(debut);
+    free(ordre);
+    free(marque);
+    return cond;
+}
+
+static ComposantesFortes *assembler(int n, int *composante, int nb,
+                                    GrapheListe *gl, const GrapheCSR *gc) {
+    ComposantesFortes *c = NULL;
+    if (nb < 0 || !(c = (ComposantesFortes *)malloc(sizeof(ComposantesFortes)))) {
+        free(composante);
+        return NULL;
+    }
+    c->nb_composantes = nb;
+    c->composante = composante;
+    c->condensation = construire_condensation(n, composante, nb, gl, gc);
+    if (!c->condensation) {
+        composantes_fortes_detruire(c);
+        return NULL;
+    }
+    return c;
+}
+
+ComposantesFortes *composantes_fortes(GrapheListe *g) {
+    if (!g) return NULL;
+    int n = graphe_liste_ordre(g);
+    int *composante = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!composante) return NULL;
+    int nb = composantes_fortes_etiqueter(g, composante);
+    INSTR_PHASE_DEBUT(phase, "composantes_fortes/condensation");
+    ComposantesFortes *c = assembler(n, composante, nb, g, NULL);
+    INSTR_PHASE_FIN(phase);
+    return c;
+}
+
+ComposantesFortes *composantes_fortes_csr(const GrapheCSR *g) {
+    if (!g) return NULL;
+    int n = graphe_csr_ordre(g);
+    int *composante = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!composante) return NULL;
+    int nb = composantes_fortes_etiqueter_csr(g, composante);
+    INSTR_PHASE_DEBUT(phase, "composantes_fortes_csr/condensation");
+    ComposantesFortes *c = assembler(n, composante, nb, NULL, g);
+    INSTR_PHASE_FIN(phase);
+    return c;
+}
+
+ComposantesFortes *composantes_fortes_parallele_csr(const GrapheCSR *g, int nb_threads) {
+    if (!g) return NULL;
+    int n = graphe_csr_ordre(g);
+    int *composante = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!composante) return NULL;
+    int nb = composantes_fortes_etiqueter_parallele_csr(g, composante, nb_threads);
+    INSTR_PHASE_DEBUT(phase, "composantes_fortes_parallele_csr/condensation");
+    ComposantesFortes *c = assembler(n, composante, nb, NULL, g);
+    INSTR_PHASE_FIN(phase);
+    return c;
+}
+
+void composantes_fortes_detruire(ComposantesFortes *c) {
+    if (!c) return;
+    free(c->composante);
+    graphe_liste_detruire(c->condensation);
+    free(c);
+}
+
+/* ---------- Parallel forward-backward ---------- */
+
+/* A subset of vertices not yet assigned to a component; its vertices
+   are exactly those whose couleur equals the subset's */
+typedef struct {
+    int couleur;
+    int taille;
+    int *sommets;
+} SousEnsemble;
+
+typedef struct {
+    const GrapheCSR *g;
+    const GrapheCSR *t;          /* transposed graph */
+    atomic_int *couleur;         /* -1 once the component of v is known */
+    int *composante;             /* ids in completion order, renumbered at the end */
+    unsigned char *marque;       /* 1 = reached forward, 2 = reached backward */
+    atomic_int prochaine_couleur;
+    atomic_int prochaine_composante;
+
+    pthread_mutex_t verrou;
+    pthread_cond_t cond;
+    SousEnsemble *taches;        /* stack of pending subsets */
+    int nb_taches;
+    int capacite_taches;
+    int actifs;                  /* threads currently processing a subset */
+    atomic_int erreur;
+} EtatFWBW;
+
+/* Called with the lock held */
+static int empiler(EtatFWBW *e, SousEnsemble t) {
+    if (e->nb_taches == e->capacite_taches) {
+        int cap = e->capacite_taches ? e->capacite_taches * 2 : 16;
+        SousEnsemble *nv = (SousEnsemble *)realloc(e->taches, cap * sizeof(SousEnsemble));
+        if (!nv) return 0;
+        e->taches = nv;
+        e->capacite_taches = cap;
+    }
+    e->taches[e->nb_taches++] = t;
+    pthread_cond_broadcast(&e->cond);
+    return 1;
+}
+
+static void atteindre(const GrapheCSR *g, int s, int c, unsigned char bit,
+                      EtatFWBW *e, int *file) {
+    int tete = 0, queue = 0;
+    file[queue++] = s;
+    e->marque[s] |= bit;
+    while (tete < queue) {
+        int v = file[tete++];
+        INSTR_COMPTER(STAT_ARCS_PARCOURUS, g->debut[v + 1] - g->debut[v]);
+        for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+            int u = g->dest[k];
+            /* colour first: marque[] of other subsets belongs to other threads */
+            if (atomic_load_explicit(&e->couleur[u], memory_order_relaxed) != c) continue;
+            if (e->marque[u] & bit) continue;
+            e->marque[u] |= bit;
+            file[queue++] = u;
+        }
+    }
+}
+
+static void traiter(EtatFWBW *e, SousEnsemble *t, TravailTarjan *w, int *file) {
+    if (t->taille <= SEUIL_TARJAN) {
+        int k = tarjan_csr(e->g, t->sommets, t->taille, e->couleur, t->couleur, e->composante, w);
+        int base = atomic_fetch_add(&e->prochaine_composante, k);
+        for (int i = 0; i < t->taille; ++i) {
+            int v = t->sommets[i];
+            e->composante[v] += base;
+            w->index[v] = -1;
+            atomic_store_explicit(&e->couleur[v], -1, memory_order_relaxed);
+        }
+        free(t->sommets);
+        return;
+    }
+
+    /* The component of the pivot is what it reaches in both directions;
+       the three remaining parts cannot share a component. */
+    int pivot = t->sommets[0];
+    atteindre(e->g, pivot, t->couleur, 1, e, file);
+    atteindre(e->t, pivot, t->couleur, 2, e, file);
+
+    int tailles[3] = { 0, 0, 0 };
+    for (int i = 0; i < t->taille; ++i) {
+        unsigned char m = e->marque[t->sommets[i]];
+        if (m != 3) tailles[m]++;
+    }
+    SousEnsemble parts[3];
+    for (int p = 0; p < 3; ++p) {
+        parts[p].taille = 0;
+        parts[p].sommets = tailles[p] ? (int *)malloc(tailles[p] * sizeof(int)) : NULL;
+        parts[p].couleur = tailles[p] ? atomic_fetch_add(&e->prochaine_couleur, 1) : -1;
+        if (tailles[p] && !parts[p].sommets) atomic_store(&e->erreur, 1);
+    }
+
+    int id = atomic_fetch_add(&e->prochaine_composante, 1);
+    for (int i = 0; i < t->taille; ++i) {
+        int v = t->sommets[i];
+        unsigned char m = e->marque[v];
+        e->marque[v] = 0;
+        if (m == 3) {
+            e->composante[v] = id;
+            atomic_store_explicit(&e->couleur[v], -1, memory_order_relaxed);
+        } else if (parts[m].sommets) {
+            parts[m].sommets[parts[m].taille++] = v;
+            atomic_store_explicit(&e->couleur[v], parts[m].couleur, memory_order_relaxed);
+        }
+    }
+    free(t->sommets);
+
+    pthread_mutex_lock(&e->verrou);
+    for (int p = 0; p < 3; ++p) {
+        if (!parts[p].sommets) continue;
+        if (!empiler(e, parts[p])) {
+            atomic_store(&e->erreur, 1);
+            free(parts[p].sommets);
+        }
+    }
+    pthread_mutex_unlock(&e->verrou);
+}
+
+static void travailleur_fwbw(int id, int nb, void *arg) {
+    (void)id;
+    (void)nb;
+    EtatFWBW *e = (EtatFWBW *)arg;
+    int n = e->g->nb_sommets;
+    TravailTarjan w;
+    int *file = (int *)malloc(n * sizeof(int));
+    int pret = file && allouer_travail(&w, n);
+
+    if (!pret) {
+        /* the other threads take the work */
+        free(file);
+        return;
+    }
+    pthread_mutex_lock(&e->verrou);
+    for (;;) {
+        if (e->nb_taches > 0) {
+            SousEnsemble t = e->taches[--e->nb_taches];
+            e->actifs++;
+            pthread_mutex_unlock(&e->verrou);
+            traiter(e, &t, &w, file);
+            pthread_mutex_lock(&e->verrou);
+            e->actifs--;
+            if (e->actifs == 0 && e->nb_taches == 0) pthread_cond_broadcast(&e->cond);
+        } else if (e->actifs == 0) {
+            break;
+        } else {
+            pthread_cond_wait(&e->cond, &e->verrou);
+        }
+    }
+    pthread_mutex_unlock(&e->verrou);
+
+    liberer_travail(&w);
+    free(file);
+}
+
+/* Vertices with no in-arc or no out-arc inside the remaining graph are
+   single-vertex components: peel them off first (linear, queue based). */
+static int elaguer(EtatFWBW *e, int *compteur) {
+    const GrapheCSR *g = e->g, *t = e->t;
+    int n = g->nb_sommets;
+    int *deg_in = (int *)calloc(n, sizeof(int));
+    int *deg_out = (int *)calloc(n, sizeof(int));
+    int *file = (int *)malloc(n * sizeof(int));
+    if (!deg_in || !deg_out || !file) {
+        free(deg_in);
+        free(deg_out);
+        free(file);
+        return 0;
+    }
+
+    for (int v = 0; v < n; ++v) {
+        for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+            if (g->dest[k] == v) continue; /* self-loops do not link anything */
+            deg_out[v]++;
+            deg_in[g->dest[k]]++;
+        }
+    }
+
+    int tete = 0, queue = 0;
+    for (int v = 0; v < n; ++v) {
+        if (deg_in[v] == 0 || deg_out[v] == 0) {
+            file[queue++] = v;
+            atomic_store_explicit(&e->couleur[v], -1, memory_order_relaxed);
+        }
+    }
+    while (tete < queue) {
+        int v = file[tete++];
+        e->composante[v] = (*compteur)++;
+        for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+            int u = g->dest[k];
+            if (u == v || atomic_load_explicit(&e->couleur[u], memory_order_relaxed) == -1) continue;
+            if (--deg_in[u] == 0) {
+                file[queue++] = u;
+                atomic_store_explicit(&e->couleur[u], -1, memory_order_relaxed);
+            }
+        }
+        for (int k = t->debut[v]; k < t->debut[v + 1]; ++k) {
+            int u = t->dest[k];
+            if (u == v || atomic_load_explicit(&e->couleur[u], memory_order_relaxed) == -1) continue;
+            if (--deg_out[u] == 0) {
+                file[queue++] = u;
+                atomic_store_explicit(&e->couleur[u], -1, memory_order_relaxed);
+            }
+        }
+    }
+
+    free(deg_in);
+    free(deg_out);
+    free(file);
+    return 1;
+}
+
+/* Kahn's algorithm on the condensation, so that arcs go from smaller to
+   larger ids. The pre-ids come from the thread schedule, so among the
+   ready components the one holding the smallest vertex goes first: the
+   final ids only depend on the graph. */
+static int renumeroter_topologique(const GrapheCSR *g, int *composante, int nb) {
+    int n = g->nb_sommets;
+    int *debut = (int *)calloc(nb + 1, sizeof(int));
+    int *deg_in = (int *)calloc(nb, sizeof(int));
+    int *rang = (int *)malloc(nb * sizeof(int));
+    int *plus_petit = (int *)malloc(nb * sizeof(int)); /* smallest vertex of each component */
+    FilePriorite *prets = file_priorite_creer(nb);
+    int *arcs = NULL;
+    int ok = 0;
+    if (!debut || !deg_in || !rang || !plus_petit || !prets) goto fin;
+
+    for (int c = 0; c < nb; ++c) plus_petit[c] = -1;
+    for (int v = 0; v < n; ++v) {
+        if (plus_petit[composante[v]] < 0) plus_petit[composante[v]] = v;
+        for (int k = g->debut[v]; k < g->debut[v + 1]; ++k)
+            if (composante[g->dest[k]] != composante[v]) debut[composante[v] + 1]++;
+    }
+    for (int c = 0; c < nb; ++c) debut[c + 1] += debut[c];
+    arcs = (int *)malloc((debut[nb] > 0 ? debut[nb] : 1) * sizeof(int));
+    if (!arcs) goto fin;
+    for (int c = 0; c < nb; ++c) rang[c] = debut[c]; /* fill cursors */
+    for (int v = 0; v < n; ++v) {
+        for (int k = g->debut[v]; k < g->debut[v + 1]; ++k) {
+            int d = composante[g->dest[k]];
+            if (d == composante[v]) continue;
+            arcs[rang[composante[v]]++] = d;
+            deg_in[d]++;
+        }
+    }
+
+    for (int c = 0; c < nb; ++c)
+        if (deg_in[c] == 0) file_priorite_inserer(prets, c, plus_petit[c]);
+    for (int suivant = 0; !file_priorite_est_vide(prets); ++suivant) {
+        int c = file_priorite_extraire_min(prets, NULL);
+        rang[c] = suivant;
+        for (int k = debut[c]; k < debut[c + 1]; ++k)
+            if (--deg_in[arcs[k]] == 0) file_priorite_inserer(prets, arcs[k], plus_petit[arcs[k]]);
+    }
+    for (int v = 0; v < n; ++v) composante[v] = rang[composante[v]];
+    ok = 1;
+
+fin:
+    free(debut);
+    free(deg_in);
+    free(rang);
+    free(plus_petit);
+    file_priorite_detruire(prets);
+    free(arcs);
+    return ok;
+}
+
+int composantes_fortes_etiqueter_parallele_csr(const GrapheCSR *g, int *composante,
+                                               int nb_threads) {
+    int n = graphe_csr_ordre(g);
+    if (n == 0) return 0;
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+
+    EtatFWBW e;
+    e.g = g;
+    INSTR_PHASE_DEBUT(transposition, "composantes_fortes_parallele/transposition");
+    e.t = g->oriente ? graphe_csr_transposer(g) : g;
+    INSTR_PHASE_FIN(transposition);
+    e.couleur = (atomic_int *)malloc(n * sizeof(atomic_int));
+    e.composante = composante;
+    e.marque = (unsigned char *)calloc(n, 1);
+    e.taches = NULL;
+    e.nb_taches = 0;
+    e.capacite_taches = 0;
+    e.actifs = 0;
+    atomic_init(&e.erreur, 0);
+    int nb = -1;
+    if (!e.t || !e.couleur || !e.marque) goto fin;
+    for (int v = 0; v < n; ++v) atomic_init(&e.couleur[v], 0);
+
+    int compteur = 0;
+    INSTR_PHASE_DEBUT(elagage, "composantes_fortes_parallele/elagage");
+    int elague = elaguer(&e, &compteur);
+    INSTR_PHASE_FIN(elagage);
+    if (!elague) goto fin;
+
+    SousEnsemble reste;
+    reste.couleur = 0;
+    reste.taille = 0;
+    reste.sommets = (int *)malloc(n * sizeof(int));
+    if (!reste.sommets) goto fin;
+    for (int v = 0; v < n; ++v)
+        if (atomic_load_explicit(&e.couleur[v], memory_order_relaxed) == 0)
+            reste.sommets[reste.taille++] = v;
+
+    atomic_init(&e.prochaine_couleur, 1);
+    atomic_init(&e.prochaine_composante, compteur);
+    pthread_mutex_init(&e.verrou, NULL);
+    pthread_cond_init(&e.cond, NULL);
+    if (reste.taille == 0) free(reste.sommets);
+    else empiler(&e, reste);
+
+    INSTR_PHASE_DEBUT(decomposition, "composantes_fortes_parallele/avant_arriere");
+    int ok = parallele_executer(nb_threads, travailleur_fwbw, &e);
+    INSTR_PHASE_FIN(decomposition);
+
+    pthread_cond_destroy(&e.cond);
+    pthread_mutex_destroy(&e.verrou);
+    for (int i = 0; i < e.nb_taches; ++i) free(e.taches[i].sommets);
+    if (ok && !atomic_load(&e.erreur) && e.nb_taches == 0) {
+        nb = atomic_load(&e.prochaine_composante);
+        INSTR_PHASE_DEBUT(renumerotation, "composantes_fortes_parallele/renumerotation");
+        if (!renumeroter_topologique(g, composante, nb)) nb = -1;
+        INSTR_PHASE_FIN(renumerotation);
+    }
+
+fin:
+    if (e.t != g) graphe_csr_detruire((GrapheCSR *)e.t);
+    free(e.couleur);
+    free(e.marque);
+    free(e.taches);
+    return nb;
+}
@@ -0,0 +1,37 @@
+/* algos_scc.h */
+#ifndef ALGOS_SCC_H
+#define ALGOS_SCC_H
+
+#include "GrapheListe.h"
+#include "GrapheCSR.h"
+
+/* Strongly connected components in O(V+E).
+   Component ids follow a topological order of the condensation: every
+   arc between two components goes from a smaller id to a larger one.
+   Non oriented graphs give their connected components. */
+
+typedef struct {
+    int nb_composantes;
+    int *composante;           /* composante[v] in 0 .. nb_composantes-1 */
+    GrapheListe *condensation; /* oriented DAG, one vertex per component,
+                                  no parallel arcs */
+} ComposantesFortes;
+
+/* Labels only: fill composante[] (size = order) and return the number of
+   components, or -1 if memory runs out */
+int composantes_fortes_etiqueter(GrapheListe *g, int *composante);
+int composantes_fortes_etiqueter_csr(const GrapheCSR *g, int *composante);
+
+/* Forward-backward decomposition with trimming, independent subsets are
+   processed on nb_threads threads (<= 0: one per processor). Small
+   subsets fall back to Tarjan. */
+int composantes_fortes_etiqueter_parallele_csr(const GrapheCSR *g, int *composante,
+                                               int nb_threads);
+
+/* Labels + condensation DAG (NULL if memory runs out) */
+ComposantesFortes *composantes_fortes(GrapheListe *g);
+ComposantesFortes *composantes_fortes_csr(const GrapheCSR *g);
+ComposantesFortes *composantes_fortes_parallele_csr(const GrapheCSR *g, int nb_threads);
+void composantes_fortes_detruire(ComposantesFortes *c);
+
+#endif /* ALGOS_SCC_H */
@@ -1,7 +1,9 @@
 /* algos_values.c */
 #include <stdio.h>
 #include <stdlib.h>
-#include "GrapheValueListe.h"
+#include "algos_values.h"
+#include "FilePriorite.h"
+#include "Instrumentation.h"
 
 #define INF 1000000000
 
@@ -9,18 +11,173 @@
    dist[i] will contain the shortest distance from source to i,
    pred[i] will contain the predecessor of i on the shortest path (or -1). */
 
+static void initialiser(int n, int source, int *dist, int *pred) {
+    for (int i = 0; i < n; ++i) {
+        dist[i] = INF;
+        pred[i] = -1;
+    }
+    dist[source] = 0;
+}
+
+/* ---------- Heap version ---------- */
+
 void dijkstra(GrapheValueListe *g, int source, int *dist, int *pred) {
     int n = graphe_value_liste_ordre(g);
     if (source < 0 || source >= n) return;
 
+    int *vu = (int *)calloc(n, sizeof(int));
+    FilePriorite *file = file_priorite_creer(n);
+    if (!vu || !file) {
+        free(vu);
+        file_priorite_detruire(file);
+        return;
+    }
+
+    INSTR_PHASE_DEBUT(phase, "dijkstra");
+    initialiser(n, source, dist, pred);
+    file_priorite_inserer(file, source, 0);
+
+    while (!file_priorite_est_vide(file)) {
+        int u = file_priorite_extraire_min(file, NULL);
+        vu[u] = 1;
+
+        /* Relax edges u -> v */
+        ArcValueListe *arc = graphe_value_liste_voisins(g, u);
+        while (arc) {
+            int v = arc->dest;
+            int w = arc->poids;
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+            if (!vu[v] && dist[u] + w < dist[v]) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                dist[v] = dist[u] + w;
+                pred[v] = u;
+                file_priorite_inserer(file, v, dist[v]);
+            }
+            arc = arc->suivant;
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    file_priorite_detruire(file);
+    free(vu);
+}
+
+/* ---------- Bucket queue version ---------- */
+
+typedef struct {
+    int *sommets;
+    int taille;
+    int capacite;
+} Seau;
+
+static int seau_ajouter(Seau *s, int v) {
+    if (s->taille == s->capacite) {
+        int nouvelle_capacite = s->capacite ? s->capacite * 2 : 4;
+        int *nouveau = (int *)realloc(s->sommets, nouvelle_capacite * sizeof(int));
+        if (!nouveau) return 0;
+        s->sommets = nouveau;
+        s->capacite = nouvelle_capacite;
+    }
+    s->sommets[s->taille++] = v;
+    return 1;
+}
+
+static int comparer_sommets(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/* Weights are >= 1 and <= max_poids, so the pending distances always lie
+   in a window of max_poids + 1 values and one bucket per value is enough.
+   A vertex is pushed again on every improvement; stale entries are dropped
+   when their bucket comes up. Each bucket is sorted by index before being
+   settled to keep the (distance, index) order of the other versions. */
+void dijkstra_seaux(GrapheValueListe *g, int source, int *dist, int *pred) {
+    int n = graphe_value_liste_ordre(g);
+    if (source < 0 || source >= n) return;
+
     int *vu = (int *)calloc(n, sizeof(int));
     if (!vu) return;
 
-    for (int i = 0; i < n; ++i) {
-        dist[i] = INF;
-        pred[i] = -1;
+    INSTR_PHASE_DEBUT(balayage, "dijkstra_seaux/poids_max");
+    int max_poids = 1;
+    for (int u = 0; u < n; ++u)
+        for (ArcValueListe *a = graphe_value_liste_voisins(g, u); a; a = a->suivant)
+            if (a->poids > max_poids) max_poids = a->poids;
+    INSTR_PHASE_FIN(balayage);
+    if (max_poids > DIJKSTRA_SEAUX_POIDS_MAX) {
+        free(vu);
+        dijkstra(g, source, dist, pred);
+        return;
     }
-    dist[source] = 0;
+
+    int nb_seaux = max_poids + 1;
+    Seau *seaux = (Seau *)calloc(nb_seaux, sizeof(Seau));
+    if (!seaux) {
+        free(vu);
+        return;
+    }
+
+    INSTR_PHASE_DEBUT(phase, "dijkstra_seaux");
+    initialiser(n, source, dist, pred);
+    /* a bucket that cannot grow would lose a vertex: the heap version
+       starts over instead */
+    int echec = !seau_ajouter(&seaux[0], source);
+    long en_attente = 1;
+
+    for (int d = 0; en_attente > 0 && !echec; ++d) {
+        Seau *s = &seaux[d % nb_seaux];
+        if (s->taille == 0) continue;
+        en_attente -= s->taille;
+
+        /* keep the live entries only, then settle them by index */
+        int k = 0;
+        for (int i = 0; i < s->taille; ++i) {
+            int x = s->sommets[i];
+            if (!vu[x] && dist[x] == d) s->sommets[k++] = x;
+        }
+        if (k > 1) qsort(s->sommets, k, sizeof(int), comparer_sommets);
+        s->taille = 0; /* relaxations never land in the current bucket */
+
+        for (int i = 0; i < k && !echec; ++i) {
+            int u = s->sommets[i];
+            vu[u] = 1;
+            for (ArcValueListe *arc = graphe_value_liste_voisins(g, u); arc; arc = arc->suivant) {
+                int v = arc->dest;
+                int nd = d + arc->poids;
+                INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
+                if (!vu[v] && nd < dist[v]) {
+                    INSTR_COMPTER(STAT_RELAXATIONS, 1);
+                    dist[v] = nd;
+                    pred[v] = u;
+                    if (!seau_ajouter(&seaux[nd % nb_seaux], v)) {
+                        echec = 1;
+                        break;
+                    }
+                    en_attente++;
+                }
+            }
+        }
+    }
+    INSTR_PHASE_FIN(phase);
+
+    for (int i = 0; i < nb_seaux; ++i) free(seaux[i].sommets);
+    free(seaux);
+    free(vu);
+    if (echec) dijkstra(g, source, dist, pred);
+}
+
+/* ---------- Array version (reference) ---------- */
+
+void dijkstra_tableau(GrapheValueListe *g, int source, int *dist, int *pred) {
+    int n = graphe_value_liste_ordre(g);
+    if (source < 0 || source >= n) return;
+
+    int *vu = (int *)calloc(n, sizeof(int));
+    if (!vu) return;
+
+    INSTR_PHASE_DEBUT(phase, "dijkstra_tableau");
+    initialiser(n, source, dist, pred);
 
     for (int k = 0; k < n; ++k) {
         /* Select unvisited vertex with minimal distance */
@@ -41,13 +198,16 @@ void dijkstra(GrapheValueListe *g, int source, int *dist, int *pred) {
         while (arc) {
             int v = arc->dest;
             int w = arc->poids;
+            INSTR_COMPTER(STAT_ARCS_PARCOURUS, 1);
             if (!vu[v] && dist[u] + w < dist[v]) {
+                INSTR_COMPTER(STAT_RELAXATIONS, 1);
                 dist[v] = dist[u] + w;
                 pred[v] = u;
             }
             arc = arc->suivant;
         }
     }
+    INSTR_PHASE_FIN(phase);
 
     free(vu);
 }
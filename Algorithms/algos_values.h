@@ -0,0 +1,23 @@
+/* algos_values.h */
+#ifndef ALGOS_VALUES_H
+#define ALGOS_VALUES_H
+
+#include "GrapheValueListe.h"
+
+/* All variants fill dist[] (1000000000 = unreachable) and pred[] (-1 = none)
+   and return exactly the same arrays: vertices are settled in increasing
+   (distance, index) order. */
+
+/* 4-ary heap with decrease-key, O((V+E) log V) */
+void dijkstra(GrapheValueListe *g, int source, int *dist, int *pred);
+
+/* Bucket queue (Dial), O(V + E + max_dist) for small integer weights.
+   Falls back to dijkstra() when the largest weight exceeds DIJKSTRA_SEAUX_POIDS_MAX,
+   or when a bucket cannot grow. */
+#define DIJKSTRA_SEAUX_POIDS_MAX 65536
+void dijkstra_seaux(GrapheValueListe *g, int source, int *dist, int *pred);
+
+/* Original O(V^2) minimum scan, kept as a reference for benchmarks */
+void dijkstra_tableau(GrapheValueListe *g, int source, int *dist, int *pred);
+
+#endif /* ALGOS_VALUES_H */
@@ -7,13 +7,11 @@
 #include "GrapheListe.h"
 #include "GrapheValueMatrice.h"
 #include "GrapheValueListe.h"
-
-/* Algorithms */
-void dfs_composantes_connexes(GrapheListe *g);
-void bfs_distances(GrapheListe *g, int source, int *dist);
-int  graphe_liste_est_connexe(GrapheListe *g);
-int  graphe_liste_est_fortement_connexe(GrapheListe *g);
-void dijkstra(GrapheValueListe *g, int source, int *dist, int *pred);
+#include "GrapheCSR.h"
+#include "algos_csr.h"
+#include "algos_values.h"
+#include "algos_scc.h"
+#include "algos_non_values.h"
 
 static void test_graphe_liste() {
     printf("=== Test GrapheListe (unweighted, undirected) ===\n");
@@ -46,6 +44,18 @@ static void test_graphe_liste() {
 
     printf("Graph is connected? %s\n", graphe_liste_est_connexe(g) ? "YES" : "NO");
 
+    DirectionBFS directions[4];
+    int etapes = bfs_distances_hybride(g, 0, dist, directions);
+    printf("Hybrid BFS: %d steps (", etapes);
+    for (int i = 0; i < etapes; ++i)
+        printf("%s%s", i ? " " : "", directions[i] == BFS_DESCENDANT ? "top-down" : "bottom-up");
+    printf("), dist[0 -> 3] = %d\n", dist[3]);
+
+    StatsPool stats;
+    graphe_liste_stats_allocation(g, &stats);
+    printf("Arc nodes allocated = %ld, malloc calls = %ld\n",
+           stats.allocations, stats.appels_malloc);
+
     free(dist);
     graphe_liste_detruire(g);
 }
@@ -74,6 +84,12 @@ static void test_graphe_matrice() {
                graphe_matrice_degre_entrant(g, i));
     }
 
+    printf("Neighbors of 1:");
+    for (int v = graphe_matrice_voisin_suivant(g, 1, -1); v != -1;
+         v = graphe_matrice_voisin_suivant(g, 1, v))
+        printf(" %d", v);
+    printf("\n");
+
     graphe_matrice_detruire(g);
 }
 
@@ -94,6 +110,12 @@ static void test_graphe_value_liste() {
     graphe_value_liste_ajouter_arc(g, v2, v3, 8);
     graphe_value_liste_ajouter_arc(g, v3, v4, 7);
 
+    graphe_value_liste_activer_predecesseurs(g);
+    printf("In degree of 3 = %d, predecessors:", graphe_value_liste_degre_entrant(g, v3));
+    for (ArcValueListe *a = graphe_value_liste_predecesseurs(g, v3); a; a = a->suivant)
+        printf(" %d (weight %d)", a->dest, a->poids);
+    printf("\n");
+
     int n = graphe_value_liste_ordre(g);
     int *dist = (int *)malloc(n * sizeof(int));
     int *pred = (int *)malloc(n * sizeof(int));
@@ -134,6 +156,112 @@ static void test_graphe_value_matrice() {
     }
 
     graphe_value_matrice_detruire(g);
+
+    /* Same graph with one byte per entry */
+    GrapheValueMatrice *g8 = graphe_value_matrice_creer_type(3, 0, POIDS_UINT8);
+    for (int i = 0; i < 3; ++i) graphe_value_matrice_ajouter_sommet(g8);
+    graphe_value_matrice_ajouter_arc(g8, 0, 1, 5);
+    graphe_value_matrice_ajouter_arc(g8, 1, 2, 300); /* too large for uint8: ignored */
+    printf("uint8 matrix: weight 0-1 = %d, edge 1-2 exists? %s (max weight %d)\n",
+           graphe_value_matrice_obtenir_poids(g8, 0, 1),
+           graphe_value_matrice_existe_arc(g8, 1, 2) ? "YES" : "NO",
+           graphe_value_matrice_poids_max(g8));
+    graphe_value_matrice_detruire(g8);
+}
+
+static void test_graphe_csr() {
+    printf("\n=== Test GrapheCSR (frozen snapshots) ===\n");
+    GrapheListe *gl = graphe_liste_creer(4, 0);
+    for (int i = 0; i < 4; ++i) graphe_liste_ajouter_sommet(gl);
+    graphe_liste_ajouter_arc(gl, 0, 1);
+    graphe_liste_ajouter_arc(gl, 2, 3);
+
+    GrapheCSR *c = graphe_csr_depuis_liste(gl);
+    printf("Order = %d, arcs = %d\n", graphe_csr_ordre(c), graphe_csr_nb_arcs(c));
+    printf("DFS connected components:\n");
+    dfs_composantes_connexes_csr(c);
+    printf("Graph is connected? %s\n", graphe_csr_est_connexe(c) ? "YES" : "NO");
+    graphe_csr_detruire(c);
+    graphe_liste_detruire(gl);
+
+    GrapheValueListe *gv = graphe_value_liste_creer(3, 1);
+    for (int i = 0; i < 3; ++i) graphe_value_liste_ajouter_sommet(gv);
+    graphe_value_liste_ajouter_arc(gv, 0, 1, 4);
+    graphe_value_liste_ajouter_arc(gv, 0, 2, 1);
+    graphe_value_liste_ajouter_arc(gv, 2, 1, 2);
+
+    GrapheCSR *cv = graphe_csr_depuis_value_liste(gv);
+    int n = graphe_csr_ordre(cv);
+    int *dist = (int *)malloc(n * sizeof(int));
+    int *pred = (int *)malloc(n * sizeof(int));
+    dijkstra_csr(cv, 0, dist, pred);
+    for (int i = 0; i < n; ++i)
+        printf("0 -> %d : %d (pred %d)\n", i, dist[i], pred[i]);
+
+    free(dist);
+    free(pred);
+    graphe_csr_detruire(cv);
+    graphe_value_liste_detruire(gv);
+}
+
+static void afficher_arc(int u, int v, TypeArc type, void *ctx) {
+    static const char *noms[] = { "tree", "back", "forward", "cross" };
+    (void)ctx;
+    printf("  %d -> %d : %s\n", u, v, noms[type]);
+}
+
+static void test_dfs_visiteur() {
+    printf("\n=== Test DFS visitor (oriented) ===\n");
+    /* 0 -> 1 -> 2 -> 0, 0 -> 2, 3 -> 1 */
+    GrapheListe *g = graphe_liste_creer(4, 1);
+    for (int i = 0; i < 4; ++i) graphe_liste_ajouter_sommet(g);
+    graphe_liste_ajouter_arc(g, 0, 2);
+    graphe_liste_ajouter_arc(g, 0, 1);
+    graphe_liste_ajouter_arc(g, 1, 2);
+    graphe_liste_ajouter_arc(g, 2, 0);
+    graphe_liste_ajouter_arc(g, 3, 1);
+
+    VisiteurDFS vis = { NULL, NULL, NULL, afficher_arc, NULL };
+    dfs_visiter_tout(g, &vis);
+
+    int comp[4];
+    int nb = dfs_composantes(g, comp);
+    printf("DFS trees = %d:", nb);
+    for (int v = 0; v < 4; ++v) printf(" %d", comp[v]);
+    printf("\n");
+    graphe_liste_detruire(g);
+}
+
+static void test_composantes_fortes() {
+    printf("\n=== Test strongly connected components ===\n");
+    /* 0 <-> 1 -> 2 <-> 3, 3 -> 4 */
+    GrapheListe *g = graphe_liste_creer(5, 1);
+    for (int i = 0; i < 5; ++i) graphe_liste_ajouter_sommet(g);
+    graphe_liste_ajouter_arc(g, 0, 1);
+    graphe_liste_ajouter_arc(g, 1, 0);
+    graphe_liste_ajouter_arc(g, 1, 2);
+    graphe_liste_ajouter_arc(g, 2, 3);
+    graphe_liste_ajouter_arc(g, 3, 2);
+    graphe_liste_ajouter_arc(g, 3, 4);
+
+    ComposantesFortes *c = composantes_fortes(g);
+    printf("Components = %d\n", c->nb_composantes);
+    for (int v = 0; v < 5; ++v)
+        printf("  vertex %d -> component %d\n", v, c->composante[v]);
+    printf("Condensation arcs:");
+    for (int k = 0; k < c->nb_composantes; ++k)
+        for (ArcListe *a = graphe_liste_voisins(c->condensation, k); a; a = a->suivant)
+            printf(" %d->%d", k, a->dest);
+    printf("\n");
+    composantes_fortes_detruire(c);
+
+    GrapheCSR *gc = graphe_csr_depuis_liste(g);
+    int comp[5];
+    printf("Parallel FW-BW (2 threads): %d components\n",
+           composantes_fortes_etiqueter_parallele_csr(gc, comp, 2));
+    printf("Strongly connected? %s\n", graphe_csr_est_fortement_connexe(gc) ? "YES" : "NO");
+    graphe_csr_detruire(gc);
+    graphe_liste_detruire(g);
 }
 
 int main(void) {
@@ -141,5 +269,8 @@ int main(void) {
     test_graphe_matrice();
     test_graphe_value_liste();
     test_graphe_value_matrice();
+    test_graphe_csr();
+    test_dfs_visiteur();
+    test_composantes_fortes();
     return 0;
 }
@@ -0,0 +1,92 @@
+/* bench_arbre_couvrant.c Minimum spanning forest engines on Erdos-Renyi
+   graphs from sparse to complete: time of each engine, same total weight
+   check, fastest engine against arbre_couvrant_moteur_conseille.
+   Usage: bench_arbre_couvrant [nb_sommets] [nb_threads] [nb_sommets_denses] */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "GrapheValueListe.h"
+#include "GrapheValueMatrice.h"
+#include "Parallele.h"
+#include "algos_arbre_couvrant.h"
+#include "generateurs.h"
+
+#define NB_MOTEURS 4
+#define ORDRE_MATRICE_MAX 8000 /* a larger weight matrix is not built */
+
+static void mesurer(int n, int degre, int nb_threads) {
+    ArcsGeneres a;
+    long long nb_aretes = (long long)n * degre / 2;
+    long long paires = (long long)n * (n - 1) / 2;
+    if (nb_aretes > paires) nb_aretes = paires;
+    if (!generer_erdos_renyi(&a, n, (int)nb_aretes, 0, 1000, 42) || !arcs_generes_nettoyer(&a)) {
+        fprintf(stderr, "generation failed\n");
+        exit(1);
+    }
+    GrapheValueListe *g = graphe_value_liste_depuis_arcs(n, 0, a.src, a.dst, a.poids, a.nb_arcs);
+    GrapheValueMatrice *m = n <= ORDRE_MATRICE_MAX ? graphe_value_matrice_creer(n, 0) : NULL;
+    if (!g || (n <= ORDRE_MATRICE_MAX && !m)) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+    for (int i = 0; m && i < n; ++i) graphe_value_matrice_ajouter_sommet(m);
+    for (int e = 0; m && e < a.nb_arcs; ++e) graphe_value_matrice_ajouter_arc(m, a.src[e], a.dst[e], a.poids[e]);
+    int nb = a.nb_arcs;
+    arcs_generes_liberer(&a);
+
+    printf("n = %7d, %9d edges (%5.1f%% of the pairs)\n", n, nb, paires > 0 ? 100.0 * nb / paires : 0.0);
+    double temps[NB_MOTEURS];
+    long long poids = -1;
+    int identique = 1, meilleur = -1;
+    for (int k = 0; k < NB_MOTEURS; ++k) {
+        if (k == ARBRE_PRIM_MATRICE && !m) {
+            temps[k] = -1;
+            continue;
+        }
+        double t0 = maintenant();
+        ArbreCouvrant *arbre = NULL;
+        switch ((MoteurArbre)k) {
+        case ARBRE_KRUSKAL:      arbre = arbre_couvrant_kruskal(g, nb_threads); break;
+        case ARBRE_PRIM:         arbre = arbre_couvrant_prim(g); break;
+        case ARBRE_PRIM_MATRICE: arbre = arbre_couvrant_prim_matrice(m); break;
+        case ARBRE_BORUVKA:      arbre = arbre_couvrant_boruvka(g, nb_threads); break;
+        }
+        temps[k] = maintenant() - t0;
+        if (!arbre) {
+            fprintf(stderr, "%s failed\n", arbre_couvrant_nom_moteur((MoteurArbre)k));
+            exit(1);
+        }
+        if (poids < 0) poids = arbre->poids_total;
+        else if (arbre->poids_total != poids) identique = 0;
+        if (meilleur < 0 || temps[k] < temps[meilleur]) meilleur = k;
+        printf("  %-14s %10.2f ms  %d trees\n", arbre_couvrant_nom_moteur((MoteurArbre)k),
+               1e3 * temps[k], arbre->nb_composantes);
+        arbre_couvrant_detruire(arbre);
+    }
+    MoteurArbre conseil = arbre_couvrant_moteur_conseille(n, nb, nb_threads);
+    printf("  weight %lld, %s; fastest %s, suggested %s (%.2fx the fastest)\n\n", poids,
+           identique ? "same weight" : "MISMATCH", arbre_couvrant_nom_moteur((MoteurArbre)meilleur),
+           arbre_couvrant_nom_moteur(conseil),
+           temps[conseil] > 0 ? temps[conseil] / temps[meilleur] : 0.0);
+
+    graphe_value_matrice_detruire(m);
+    graphe_value_liste_detruire(g);
+}
+
+int main(int argc, char **argv) {
+    int n          = argc > 1 ? atoi(argv[1]) : 200000;
+    int nb_threads = argc > 2 ? atoi(argv[2]) : 0;
+    int n_dense    = argc > 3 ? atoi(argv[3]) : 3000;
+    if (n <= 1 || n_dense <= 1) {
+        fprintf(stderr, "usage: %s [nb_sommets] [nb_threads] [nb_sommets_denses]\n", argv[0]);
+        return 1;
+    }
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+    printf("%d threads\n\n", nb_threads);
+
+    int degres[] = {4, 16, 64};
+    for (int i = 0; i < 3; ++i) mesurer(n, degres[i], nb_threads);
+    int degres_denses[] = {n_dense / 50, n_dense / 8, n_dense / 2, n_dense};
+    for (int i = 0; i < 4; ++i) mesurer(n_dense, degres_denses[i], nb_threads);
+    return 0;
+}
@@ -0,0 +1,127 @@
+/* bench_chargement.c Loading a text edge list: fscanf + one insertion per
+   arc against the memory-mapped parallel loader.
+   Usage: bench_chargement [nb_sommets] [nb_arcs] [threads] [fichier]
+   The file is generated first (Erdos-Renyi "u v w" lines), then read back;
+   the CSR is finally saved in the binary format and mapped again, and
+   the same arcs are ingested twice by the deduplicating batch insertion. */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "GrapheListe.h"
+#include "GrapheValueListe.h"
+#include "GrapheCSR.h"
+#include "ChargeurGraphe.h"
+#include "GrapheBinaire.h"
+#include "generateurs.h"
+
+static int ecrire(const char *chemin, const ArcsGeneres *a) {
+    FILE *f = fopen(chemin, "w");
+    if (!f) return 0;
+    fprintf(f, "# random edge list: %d vertices, %d arcs\n", a->nb_sommets, a->nb_arcs);
+    for (int i = 0; i < a->nb_arcs; ++i) fprintf(f, "%d\t%d\t%d\n", a->src[i], a->dst[i], a->poids[i]);
+    fclose(f);
+    return 1;
+}
+
+/* What main.c-style code does today */
+static GrapheListe *charger_naif(const char *chemin, int n) {
+    FILE *f = fopen(chemin, "r");
+    if (!f) return NULL;
+    GrapheListe *g = graphe_liste_creer(1, 1);
+    for (int i = 0; i < n; ++i) graphe_liste_ajouter_sommet(g);
+    char ligne[256];
+    int u, v, w;
+    while (fgets(ligne, sizeof ligne, f))
+        if (sscanf(ligne, "%d %d %d", &u, &v, &w) >= 2) graphe_liste_ajouter_arc(g, u, v);
+    fclose(f);
+    return g;
+}
+
+static void afficher(const char *nom, const BilanChargement *b) {
+    printf("%-26s %8.1f ms parse %8.1f ms build %8.2f M arcs/s\n", nom,
+           1e3 * b->secondes_analyse, 1e3 * b->secondes_construction, b->arcs_par_seconde / 1e6);
+}
+
+int main(int argc, char **argv) {
+    int n              = argc > 1 ? atoi(argv[1]) : 1000000;
+    int m              = argc > 2 ? atoi(argv[2]) : 10000000;
+    int threads        = argc > 3 ? atoi(argv[3]) : 0;
+    const char *chemin = argc > 4 ? argv[4] : "bench_arcs.txt";
+    if (n <= 1 || m < 0) {
+        fprintf(stderr, "usage: %s [nb_sommets] [nb_arcs] [threads] [fichier]\n", argv[0]);
+        return 1;
+    }
+    ArcsGeneres arcs;
+    if (!generer_erdos_renyi(&arcs, n, m, 1, 100, 42) || !ecrire(chemin, &arcs)) {
+        fprintf(stderr, "cannot write %s\n", chemin);
+        return 1;
+    }
+
+    double t0 = maintenant();
+    GrapheListe *naif = charger_naif(chemin, n);
+    double t_naif = maintenant() - t0;
+    printf("%-26s %8.1f ms total            %8.2f M arcs/s\n", "fscanf + ajouter_arc",
+           1e3 * t_naif, m / t_naif / 1e6);
+
+    BilanChargement b;
+    GrapheListe *g = charger_graphe_liste(chemin, 1, threads, &b);
+    afficher("charger_graphe_liste", &b);
+    GrapheValueListe *gv = charger_graphe_value_liste(chemin, 1, threads, &b);
+    afficher("charger_graphe_value_liste", &b);
+    GrapheCSR *c = charger_graphe_csr(chemin, 1, 1, threads, &b);
+    afficher("charger_graphe_csr", &b);
+    printf("%d vertices, %d arcs, %d ignored lines, %.1f MB\n", b.nb_sommets, b.nb_arcs,
+           b.lignes_ignorees, b.octets / 1e6);
+
+    char binaire[512];
+    snprintf(binaire, sizeof binaire, "%s.bin", chemin);
+    t0 = maintenant();
+    int ecrit = c && graphe_binaire_ecrire_csr(c, binaire);
+    double t_ecriture = maintenant() - t0;
+    t0 = maintenant();
+    GrapheCSR *vue = ecrit ? graphe_binaire_ouvrir(binaire, 0) : NULL;
+    double t_ouverture = maintenant() - t0;
+    t0 = maintenant();
+    GrapheCSR *verifiee = ecrit ? graphe_binaire_ouvrir(binaire, 1) : NULL;
+    double t_verification = maintenant() - t0;
+    if (vue && verifiee) {
+        printf("%-26s %8.1f ms\n", "graphe_binaire_ecrire_csr", 1e3 * t_ecriture);
+        printf("%-26s %8.3f ms (verified: %.1f ms)\n", "graphe_binaire_ouvrir", 1e3 * t_ouverture,
+               1e3 * t_verification);
+    } else {
+        fprintf(stderr, "cannot write or map %s\n", binaire);
+    }
+    graphe_csr_detruire(vue);
+    graphe_csr_detruire(verifiee);
+    remove(binaire);
+
+    /* same arcs as the file, inserted into an empty graph, then once
+       more: the second batch only merges weights */
+    TripletArc *lot = (TripletArc *)malloc((m > 0 ? (size_t)m : 1) * sizeof(TripletArc));
+    GrapheValueListe *dedup = graphe_value_liste_creer(n, 1);
+    for (int i = 0; dedup && i < n; ++i) graphe_value_liste_ajouter_sommet(dedup);
+    if (lot && dedup) {
+        for (int i = 0; i < m; ++i) {
+            lot[i].u = arcs.src[i];
+            lot[i].v = arcs.dst[i];
+            lot[i].poids = arcs.poids[i];
+        }
+        for (int passe = 0; passe < 2; ++passe) {
+            t0 = maintenant();
+            int ajoutes = graphe_value_liste_ajouter_arcs(dedup, lot, m, DOUBLONS_POIDS_MIN);
+            double t = maintenant() - t0;
+            printf("%-26s %8.1f ms total            %8.2f M arcs/s (%d new)\n",
+                   passe ? "ajouter_arcs (again)" : "ajouter_arcs", 1e3 * t, m / t / 1e6, ajoutes);
+        }
+    }
+    free(lot);
+    graphe_value_liste_detruire(dedup);
+    arcs_generes_liberer(&arcs);
+
+    graphe_liste_detruire(naif);
+    graphe_liste_detruire(g);
+    graphe_value_liste_detruire(gv);
+    graphe_csr_detruire(c);
+    remove(chemin);
+    return 0;
+}
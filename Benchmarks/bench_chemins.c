@@ -0,0 +1,145 @@
+/* bench_chemins.c Point-to-point queries against a full Dijkstra on a grid
+   and on a random geometric graph (both road-like).
+   Usage: bench_chemins [nb_sommets] [nb_requetes] [nb_reperes] [poids_max] */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "GrapheValueListe.h"
+#include "algos_values.h"
+#include "algos_chemins.h"
+#include "generateurs.h"
+
+#define INF 1000000000
+
+typedef struct {
+    int cote;
+    int poids_min;
+} Grille;
+
+/* Manhattan distance times the smallest weight: admissible on a grid */
+static int heuristique_grille(int v, int cible, void *donnees) {
+    const Grille *gr = (const Grille *)donnees;
+    int dx = abs(v % gr->cote - cible % gr->cote);
+    int dy = abs(v / gr->cote - cible / gr->cote);
+    return (dx + dy) * gr->poids_min;
+}
+
+typedef enum { DIJKSTRA_ARRET, BIDIRECTIONNEL, A_ETOILE_GRILLE, ALT } Methode;
+
+static void mesurer(const char *nom, Methode m, ContexteChemin *c, const ReperesALT *r,
+                    Grille *gr, const int *paires, int nb_requetes, const int *dist_ref,
+                    double t_ref) {
+    double total = 0.0;
+    long regles = 0;
+    int identique = 1;
+    for (int i = 0; i < nb_requetes; ++i) {
+        int s = paires[2 * i], t = paires[2 * i + 1];
+        Chemin chemin;
+        double t0 = maintenant();
+        switch (m) {
+        case DIJKSTRA_ARRET:  chemin_a_etoile(c, s, t, NULL, NULL, &chemin); break;
+        case BIDIRECTIONNEL:  chemin_bidirectionnel(c, s, t, &chemin); break;
+        case A_ETOILE_GRILLE: chemin_a_etoile(c, s, t, heuristique_grille, gr, &chemin); break;
+        case ALT:             chemin_alt(c, r, s, t, &chemin); break;
+        }
+        total += maintenant() - t0;
+        regles += chemin.nb_regles;
+        if (chemin.distance != dist_ref[i]) identique = 0;
+    }
+    printf("  %-22s %10.3f ms/query %10ld settled  speedup %7.1fx  %s\n", nom,
+           1e3 * total / nb_requetes, regles / nb_requetes, t_ref / (total / nb_requetes),
+           identique ? "same distances" : "MISMATCH");
+}
+
+static void comparer(const char *titre, GrapheValueListe *g, Grille *gr, int nb_requetes,
+                     int nb_reperes) {
+    int n = graphe_value_liste_ordre(g);
+    int *dist = (int *)malloc(n * sizeof(int));
+    int *pred = (int *)malloc(n * sizeof(int));
+    int *paires = (int *)malloc(2 * nb_requetes * sizeof(int));
+    int *dist_ref = (int *)malloc(nb_requetes * sizeof(int));
+    ContexteChemin *c = contexte_chemin_creer(g);
+    if (!dist || !pred || !paires || !dist_ref || !c) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+    Aleatoire alea;
+    aleatoire_init(&alea, 7);
+    for (int i = 0; i < 2 * nb_requetes; ++i) paires[i] = aleatoire_entier(&alea, n);
+
+    /* baseline: settle the whole graph, then read the target */
+    int atteints = 0;
+    double t0 = maintenant();
+    for (int i = 0; i < nb_requetes; ++i) {
+        dijkstra(g, paires[2 * i], dist, pred);
+        dist_ref[i] = dist[paires[2 * i + 1]];
+        if (dist_ref[i] < INF) atteints++;
+    }
+    double t_ref = (maintenant() - t0) / nb_requetes;
+
+    t0 = maintenant();
+    ReperesALT *r = reperes_alt_creer(g, nb_reperes);
+    double t_reperes = maintenant() - t0;
+
+    printf("%s: n = %d, %d queries (%d reachable), %d landmarks built in %.1f ms\n", titre, n,
+           nb_requetes, atteints, r ? r->nb_reperes : 0, 1e3 * t_reperes);
+    printf("  %-22s %10.3f ms/query %10d settled\n", "dijkstra (full)", 1e3 * t_ref, n);
+    mesurer("dijkstra stopped", DIJKSTRA_ARRET, c, r, gr, paires, nb_requetes, dist_ref, t_ref);
+    mesurer("bidirectional", BIDIRECTIONNEL, c, r, gr, paires, nb_requetes, dist_ref, t_ref);
+    if (gr) mesurer("A* manhattan", A_ETOILE_GRILLE, c, r, gr, paires, nb_requetes, dist_ref, t_ref);
+    if (r) mesurer("A* ALT", ALT, c, r, gr, paires, nb_requetes, dist_ref, t_ref);
+
+    reperes_alt_detruire(r);
+    contexte_chemin_detruire(c);
+    free(dist);
+    free(pred);
+    free(paires);
+    free(dist_ref);
+}
+
+static GrapheValueListe *construire(ArcsGeneres *a) {
+    GrapheValueListe *g = graphe_value_liste_depuis_arcs(a->nb_sommets, a->oriente, a->src,
+                                                         a->dst, a->poids, a->nb_arcs);
+    if (!g) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+    return g;
+}
+
+int main(int argc, char **argv) {
+    int n           = argc > 1 ? atoi(argv[1]) : 250000;
+    int nb_requetes = argc > 2 ? atoi(argv[2]) : 100;
+    int nb_reperes  = argc > 3 ? atoi(argv[3]) : 8;
+    int poids_max   = argc > 4 ? atoi(argv[4]) : 100;
+    if (n <= 0 || nb_requetes <= 0 || nb_reperes <= 0 || poids_max <= 0) {
+        fprintf(stderr, "usage: %s [nb_sommets] [nb_requetes] [nb_reperes] [poids_max]\n", argv[0]);
+        return 1;
+    }
+
+    ArcsGeneres a;
+    if (!generer_graphe(&a, GEN_GRILLE, n, 4, 0, poids_max, 42)) {
+        fprintf(stderr, "generation failed\n");
+        return 1;
+    }
+    Grille gr = { 1, poids_max };
+    while ((long long)(gr.cote + 1) * (gr.cote + 1) <= a.nb_sommets) gr.cote++;
+    for (int i = 0; i < a.nb_arcs; ++i)
+        if (a.poids[i] < gr.poids_min) gr.poids_min = a.poids[i];
+    GrapheValueListe *g = construire(&a);
+    arcs_generes_liberer(&a);
+    comparer("grid", g, &gr, nb_requetes, nb_reperes);
+    graphe_value_liste_detruire(g);
+
+    /* mean degree 6, weights follow the euclidean length of the edges */
+    if (!generer_graphe(&a, GEN_GEOMETRIQUE, n, 6, 0, poids_max, 42) || !arcs_generes_nettoyer(&a)) {
+        fprintf(stderr, "generation failed\n");
+        return 1;
+    }
+    g = construire(&a);
+    arcs_generes_liberer(&a);
+    printf("\n");
+    comparer("geometric", g, NULL, nb_requetes, nb_reperes);
+    graphe_value_liste_detruire(g);
+    return 0;
+}
@@ -0,0 +1,142 @@
+/* bench_contraction.c Contraction hierarchy preprocessing, file round trip
+   and queries against Dijkstra, on a grid and a random geometric graph.
+   Usage: bench_contraction [nb_sommets] [nb_requetes] [nb_threads] [fichier] */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "GrapheValueListe.h"
+#include "algos_values.h"
+#include "algos_chemins.h"
+#include "algos_contraction.h"
+#include "generateurs.h"
+
+#define INF 1000000000
+
+static void comparer(const char *titre, GrapheValueListe *g, int nb_requetes, int nb_threads,
+                     const char *fichier) {
+    int n = graphe_value_liste_ordre(g);
+    int *dist = (int *)malloc(n * sizeof(int));
+    int *pred = (int *)malloc(n * sizeof(int));
+    int *paires = (int *)malloc(2 * nb_requetes * sizeof(int));
+    int *dist_ref = (int *)malloc(nb_requetes * sizeof(int));
+    ContexteChemin *cc = contexte_chemin_creer(g);
+    if (!dist || !pred || !paires || !dist_ref || !cc) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+    Aleatoire alea;
+    aleatoire_init(&alea, 7);
+    for (int i = 0; i < 2 * nb_requetes; ++i) paires[i] = aleatoire_entier(&alea, n);
+
+    double t0 = maintenant();
+    HierarchieContraction *h = hierarchie_construire(g, nb_threads);
+    double t_construction = maintenant() - t0;
+    if (!h) {
+        fprintf(stderr, "preprocessing failed\n");
+        exit(1);
+    }
+    t0 = maintenant();
+    int ecrit = hierarchie_ecrire(h, fichier);
+    double t_ecriture = maintenant() - t0;
+    t0 = maintenant();
+    HierarchieContraction *relue = ecrit ? hierarchie_ouvrir(fichier) : NULL;
+    double t_lecture = maintenant() - t0;
+    remove(fichier);
+    printf("%s: n = %d, %d arcs up / %d down, %d shortcuts, %d rounds\n", titre, n,
+           h->montant->nb_arcs, h->descendant->nb_arcs, h->nb_raccourcis, h->nb_rondes);
+    printf("  preprocessing %.2f s, write %.1f ms, read %.1f ms%s\n", t_construction,
+           1e3 * t_ecriture, 1e3 * t_lecture, relue ? "" : "  (FILE FAILED)");
+
+    /* full Dijkstra, a handful of queries is enough for the baseline */
+    int nb_ref = nb_requetes < 20 ? nb_requetes : 20;
+    t0 = maintenant();
+    for (int i = 0; i < nb_ref; ++i) dijkstra(g, paires[2 * i], dist, pred);
+    double t_dijkstra = (maintenant() - t0) / nb_ref;
+    for (int i = 0; i < nb_requetes; ++i) {
+        Chemin chemin;
+        chemin_bidirectionnel(cc, paires[2 * i], paires[2 * i + 1], &chemin);
+        dist_ref[i] = chemin.distance;
+    }
+    t0 = maintenant();
+    for (int i = 0; i < nb_requetes; ++i) {
+        Chemin chemin;
+        chemin_bidirectionnel(cc, paires[2 * i], paires[2 * i + 1], &chemin);
+    }
+    double t_bidir = (maintenant() - t0) / nb_requetes;
+
+    ContexteHierarchie *c = contexte_hierarchie_creer(relue ? relue : h);
+    int identique = 1;
+    t0 = maintenant();
+    for (int i = 0; i < nb_requetes; ++i)
+        if (hierarchie_distance(c, paires[2 * i], paires[2 * i + 1]) != dist_ref[i]) identique = 0;
+    double t_distance = (maintenant() - t0) / nb_requetes;
+    long regles = 0;
+    t0 = maintenant();
+    for (int i = 0; i < nb_requetes; ++i) {
+        Chemin chemin;
+        hierarchie_chemin(c, paires[2 * i], paires[2 * i + 1], &chemin);
+        regles += chemin.nb_regles;
+        if (chemin.distance != dist_ref[i]) identique = 0;
+    }
+    double t_chemin = (maintenant() - t0) / nb_requetes;
+
+    printf("  %-22s %12.1f us/query\n", "dijkstra (full)", 1e6 * t_dijkstra);
+    printf("  %-22s %12.1f us/query  speedup %8.1fx\n", "bidirectional", 1e6 * t_bidir,
+           t_dijkstra / t_bidir);
+    printf("  %-22s %12.1f us/query  speedup %8.1fx  %ld settled  %s\n", "hierarchy distance",
+           1e6 * t_distance, t_dijkstra / t_distance, regles / nb_requetes,
+           identique ? "same distances" : "MISMATCH");
+    printf("  %-22s %12.1f us/query  speedup %8.1fx\n", "hierarchy path", 1e6 * t_chemin,
+           t_dijkstra / t_chemin);
+
+    contexte_hierarchie_detruire(c);
+    hierarchie_detruire(relue);
+    hierarchie_detruire(h);
+    contexte_chemin_detruire(cc);
+    free(dist);
+    free(pred);
+    free(paires);
+    free(dist_ref);
+}
+
+static GrapheValueListe *construire(ArcsGeneres *a) {
+    GrapheValueListe *g = graphe_value_liste_depuis_arcs(a->nb_sommets, a->oriente, a->src,
+                                                         a->dst, a->poids, a->nb_arcs);
+    if (!g) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+    return g;
+}
+
+int main(int argc, char **argv) {
+    int n           = argc > 1 ? atoi(argv[1]) : 100000;
+    int nb_requetes = argc > 2 ? atoi(argv[2]) : 1000;
+    int nb_threads  = argc > 3 ? atoi(argv[3]) : 0;
+    const char *fichier = argc > 4 ? argv[4] : "bench_contraction.ch";
+    if (n <= 0 || nb_requetes <= 0) {
+        fprintf(stderr, "usage: %s [nb_sommets] [nb_requetes] [nb_threads] [fichier]\n", argv[0]);
+        return 1;
+    }
+
+    ArcsGeneres a;
+    if (!generer_graphe(&a, GEN_GRILLE, n, 4, 0, 100, 42)) {
+        fprintf(stderr, "generation failed\n");
+        return 1;
+    }
+    GrapheValueListe *g = construire(&a);
+    arcs_generes_liberer(&a);
+    comparer("grid", g, nb_requetes, nb_threads, fichier);
+    graphe_value_liste_detruire(g);
+
+    if (!generer_graphe(&a, GEN_GEOMETRIQUE, n, 6, 0, 100, 42) || !arcs_generes_nettoyer(&a)) {
+        fprintf(stderr, "generation failed\n");
+        return 1;
+    }
+    g = construire(&a);
+    arcs_generes_liberer(&a);
+    printf("\n");
+    comparer("geometric", g, nb_requetes, nb_threads, fichier);
+    graphe_value_liste_detruire(g);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/* bench_dijkstra.c Compares the Dijkstra variants on random sparse graphs,
+   then prints the instrumentation counters of one heap run.
+   Usage: bench_dijkstra [nb_sommets] [arcs_par_sommet] [poids_max] [nb_sources] */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "GrapheValueListe.h"
+#include "GrapheCSR.h"
+#include "algos_values.h"
+#include "algos_csr.h"
+#include "generateurs.h"
+#include "Instrumentation.h"
+
+typedef void (*FonctionDijkstra)(GrapheValueListe *g, int source, int *dist, int *pred);
+
+static GrapheValueListe *graphe_aleatoire(int n, int degre, int poids_max, uint64_t graine) {
+    ArcsGeneres a;
+    if (!generer_erdos_renyi(&a, n, (int)((long long)n * (degre - 1)), 1, poids_max, graine))
+        return NULL;
+    GrapheValueListe *g = graphe_value_liste_depuis_arcs(n, 1, a.src, a.dst, a.poids, a.nb_arcs);
+    arcs_generes_liberer(&a);
+    /* a ring keeps everything reachable, the rest is random */
+    Aleatoire r;
+    aleatoire_init(&r, graine + 1);
+    for (int u = 0; g && u < n; ++u)
+        graphe_value_liste_ajouter_arc(g, u, (u + 1) % n, 1 + aleatoire_entier(&r, poids_max));
+    return g;
+}
+
+static double mesurer(const char *nom, FonctionDijkstra f, GrapheValueListe *g,
+                      const int *sources, int nb_sources, int *dist, int *pred,
+                      const int *dist_ref, const int *pred_ref) {
+    int n = graphe_value_liste_ordre(g);
+    double total = 0.0;
+    int identique = 1;
+    for (int i = 0; i < nb_sources; ++i) {
+        double t0 = maintenant();
+        f(g, sources[i], dist, pred);
+        total += maintenant() - t0;
+        if (dist_ref && i == 0)
+            identique = !memcmp(dist, dist_ref, n * sizeof(int)) &&
+                        !memcmp(pred, pred_ref, n * sizeof(int));
+    }
+    printf("%-18s %10.3f ms/query  %s\n", nom, 1e3 * total / nb_sources,
+           dist_ref ? (identique ? "same dist/pred" : "MISMATCH") : "reference");
+    return total / nb_sources;
+}
+
+int main(int argc, char **argv) {
+    int n          = argc > 1 ? atoi(argv[1]) : 20000;
+    int degre      = argc > 2 ? atoi(argv[2]) : 8;
+    int poids_max  = argc > 3 ? atoi(argv[3]) : 100;
+    int nb_sources = argc > 4 ? atoi(argv[4]) : 5;
+    if (n <= 0 || degre <= 0 || poids_max <= 0 || nb_sources <= 0) {
+        fprintf(stderr, "usage: %s [nb_sommets] [arcs_par_sommet] [poids_max] [nb_sources]\n", argv[0]);
+        return 1;
+    }
+
+    GrapheValueListe *g = graphe_aleatoire(n, degre, poids_max, 42);
+    GrapheCSR *c = graphe_csr_depuis_value_liste(g);
+    int *dist = (int *)malloc(n * sizeof(int));
+    int *pred = (int *)malloc(n * sizeof(int));
+    int *dist_ref = (int *)malloc(n * sizeof(int));
+    int *pred_ref = (int *)malloc(n * sizeof(int));
+    int *sources = (int *)malloc(nb_sources * sizeof(int));
+    if (!g || !c || !dist || !pred || !dist_ref || !pred_ref || !sources) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+    Aleatoire r;
+    aleatoire_init(&r, 7);
+    for (int i = 0; i < nb_sources; ++i) sources[i] = aleatoire_entier(&r, n);
+
+    printf("n = %d, arcs = %d, weights in [1, %d], %d sources\n",
+           n, graphe_csr_nb_arcs(c), poids_max, nb_sources);
+
+    double t_ref = mesurer("dijkstra_tableau", dijkstra_tableau, g, sources, nb_sources,
+                           dist_ref, pred_ref, NULL, NULL);
+    dijkstra_tableau(g, sources[0], dist_ref, pred_ref);
+
+    double t_tas = mesurer("dijkstra (heap)", dijkstra, g, sources, nb_sources,
+                           dist, pred, dist_ref, pred_ref);
+    double t_seaux = mesurer("dijkstra_seaux", dijkstra_seaux, g, sources, nb_sources,
+                             dist, pred, dist_ref, pred_ref);
+
+    double total = 0.0;
+    for (int i = 0; i < nb_sources; ++i) {
+        double t0 = maintenant();
+        dijkstra_csr(c, sources[i], dist, pred);
+        total += maintenant() - t0;
+    }
+    dijkstra_csr(c, sources[0], dist, pred);
+    int identique = !memcmp(dist, dist_ref, n * sizeof(int)) &&
+                    !memcmp(pred, pred_ref, n * sizeof(int));
+    printf("%-18s %10.3f ms/query  %s\n", "dijkstra_csr", 1e3 * total / nb_sources,
+           identique ? "same dist/pred" : "MISMATCH");
+
+    printf("speedup heap = %.1fx, buckets = %.1fx, csr = %.1fx\n",
+           t_ref / t_tas, t_ref / t_seaux, t_ref / (total / nb_sources));
+
+    /* counters of one more heap run (zeros unless built with -DGRAPHE_INSTRUMENTATION) */
+    StatsGraphe stats;
+    instrumentation_activer_materiel();
+    instrumentation_reinitialiser();
+    dijkstra(g, sources[0], dist, pred);
+    instrumentation_lire(&stats);
+    instrumentation_desactiver_materiel();
+    printf("\n");
+    instrumentation_afficher(&stats, stdout);
+
+    free(sources);
+    free(dist);
+    free(pred);
+    free(dist_ref);
+    free(pred_ref);
+    graphe_csr_detruire(c);
+    graphe_value_liste_detruire(g);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/* bench_floyd.c All-pairs shortest paths: textbook Floyd-Warshall triple
+   loop against the tiled scalar, AVX2 and AVX-512 versions, on one and
+   several threads, with and without paths, on an Erdos-Renyi graph.
+   Usage: bench_floyd [nb_sommets] [degre_moyen] [nb_threads] */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "GrapheValueMatrice.h"
+#include "Parallele.h"
+#include "algos_floyd.h"
+#include "generateurs.h"
+
+#define INF 1000000000
+
+/* k, i, j over the whole matrix: each k streams all of it through the cache */
+static void floyd_naif(int *d, int n) {
+    for (int k = 0; k < n; ++k)
+        for (int i = 0; i < n; ++i) {
+            int dik = d[(size_t)i * n + k];
+            if (dik >= INF) continue;
+            for (int j = 0; j < n; ++j) {
+                int s = dik + d[(size_t)k * n + j];
+                if (s < d[(size_t)i * n + j]) d[(size_t)i * n + j] = s;
+            }
+        }
+}
+
+static int identiques(const DistancesToutesPaires *d, const int *ref, int n) {
+    for (int i = 0; i < n; ++i)
+        if (memcmp(d->dist + (size_t)i * d->pas, ref + (size_t)i * n, n * sizeof(int)) != 0) return 0;
+    return 1;
+}
+
+static void mesurer(const GrapheValueMatrice *g, const int *ref, double t_naif, VarianteFloyd v,
+                    int chemins, int nb_threads) {
+    int n = graphe_value_matrice_ordre(g);
+    double t0 = maintenant();
+    DistancesToutesPaires *d = floyd_warshall_variante(g, chemins, nb_threads, v);
+    double t = maintenant() - t0;
+    if (!d) {
+        fprintf(stderr, "floyd_warshall failed\n");
+        exit(1);
+    }
+    char titre[64];
+    snprintf(titre, sizeof(titre), "%s%s, %d thread%s", floyd_nom_variante(d->variante),
+             chemins ? " + paths" : "", nb_threads, nb_threads > 1 ? "s" : "");
+    printf("  %-30s %9.3f s  %7.2f Gupd/s  speedup %6.1fx  %s\n", titre, t,
+           (double)n * n * n / t * 1e-9, t_naif / t, identiques(d, ref, n) ? "same distances" : "MISMATCH");
+    distances_toutes_paires_detruire(d);
+}
+
+int main(int argc, char **argv) {
+    int n          = argc > 1 ? atoi(argv[1]) : 2000;
+    int degre      = argc > 2 ? atoi(argv[2]) : 16;
+    int nb_threads = argc > 3 ? atoi(argv[3]) : 0;
+    if (n <= 0 || degre < 0) {
+        fprintf(stderr, "usage: %s [nb_sommets] [degre_moyen] [nb_threads]\n", argv[0]);
+        return 1;
+    }
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+
+    ArcsGeneres a;
+    if (!generer_graphe(&a, GEN_ERDOS_RENYI, n, degre, 1, 100, 42)) {
+        fprintf(stderr, "generation failed\n");
+        return 1;
+    }
+    GrapheValueMatrice *g = graphe_value_matrice_creer(n, 1);
+    int *ref = (int *)malloc((size_t)n * n * sizeof(int));
+    if (!g || !ref) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+    for (int i = 0; i < n; ++i) graphe_value_matrice_ajouter_sommet(g);
+    for (int e = 0; e < a.nb_arcs; ++e) graphe_value_matrice_ajouter_arc(g, a.src[e], a.dst[e], a.poids[e]);
+    arcs_generes_liberer(&a);
+
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) {
+            int w = graphe_value_matrice_obtenir_poids(g, i, j);
+            ref[(size_t)i * n + j] = i == j ? 0 : (w > 0 ? w : INF);
+        }
+    double t0 = maintenant();
+    floyd_naif(ref, n);
+    double t_naif = maintenant() - t0;
+
+    printf("erdos-renyi: n = %d, degree %d, best version %s\n", n, degre,
+           floyd_nom_variante(floyd_meilleure_variante()));
+    printf("  %-30s %9.3f s  %7.2f Gupd/s\n", "textbook triple loop", t_naif,
+           (double)n * n * n / t_naif * 1e-9);
+    for (VarianteFloyd v = FLOYD_SCALAIRE; v <= FLOYD_AVX512; ++v) {
+        if (v != FLOYD_SCALAIRE && v > floyd_meilleure_variante()) continue;
+        mesurer(g, ref, t_naif, v, 0, 1);
+    }
+    VarianteFloyd meilleure = floyd_meilleure_variante();
+    mesurer(g, ref, t_naif, meilleure, 1, 1);
+    if (nb_threads > 1) {
+        mesurer(g, ref, t_naif, meilleure, 0, nb_threads);
+        mesurer(g, ref, t_naif, meilleure, 1, nb_threads);
+    }
+
+    free(ref);
+    graphe_value_matrice_detruire(g);
+    return 0;
+}
@@ -0,0 +1,214 @@
+/* bench_parallele.c Scaling of the multithreaded BFS, connected components,
+   delta-stepping and many-source Dijkstra (on a weighted grid, like a
+   road network).
+   Usage: bench_parallele [nb_sommets] [arcs_par_sommet] [threads_max] [repetitions] */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "GrapheListe.h"
+#include "GrapheValueListe.h"
+#include "GrapheCSR.h"
+#include "algos_csr.h"
+#include "algos_values.h"
+#include "algos_parallele.h"
+#include "Parallele.h"
+#include "generateurs.h"
+
+/* Non oriented random graph: low diameter, one giant component */
+static GrapheListe *graphe_aleatoire(int n, int degre, uint64_t graine) {
+    ArcsGeneres a;
+    if (!generer_erdos_renyi(&a, n, (int)((long long)n * (degre / 2)), 0, 1, graine)) return NULL;
+    GrapheListe *g = graphe_liste_depuis_arcs(n, 0, a.src, a.dst, a.nb_arcs);
+    arcs_generes_liberer(&a);
+    return g;
+}
+
+/* side x side grid, random weights in [1, 1000] */
+static GrapheValueListe *grille_valuee(int cote, uint64_t graine) {
+    ArcsGeneres a;
+    if (!generer_grille(&a, cote, cote, 0, 1000, graine)) return NULL;
+    GrapheValueListe *g = graphe_value_liste_depuis_arcs(a.nb_sommets, 0, a.src, a.dst, a.poids,
+                                                         a.nb_arcs);
+    arcs_generes_liberer(&a);
+    return g;
+}
+
+/* Thread counts to measure: the powers of two below threads_max, then
+   threads_max itself. Returns how many were written to liste. */
+#define NB_MESURES_MAX 32
+static int liste_threads(int threads_max, int *liste) {
+    int nb = 0;
+    for (int t = 1; t < threads_max && nb < NB_MESURES_MAX - 1; t *= 2) liste[nb++] = t;
+    liste[nb++] = threads_max;
+    return nb;
+}
+
+#define NB_SOURCES_LOT 16
+
+/* Sum of the reachable distances of each row, one total per thread */
+static void sommer_ligne(int indice_source, const int *dist, int id_thread, void *ctx) {
+    (void)indice_source;
+    long long *sommes = (long long *)ctx;
+    int n = (int)sommes[0];
+    long long s = 0;
+    for (int v = 0; v < n; ++v)
+        if (dist[v] < 1000000000) s += dist[v];
+    sommes[1 + id_thread] += s;
+}
+
+/* A hand-written loop of dijkstra() calls against the pooled batch */
+static void mesurer_multi_sources(GrapheValueListe *g, const GrapheCSR *c, int threads_max) {
+    int n = graphe_csr_ordre(c);
+    int sources[NB_SOURCES_LOT];
+    int *dist = (int *)malloc(n * sizeof(int));
+    int *pred = (int *)malloc(n * sizeof(int));
+    long long *sommes = (long long *)malloc((threads_max + 1) * sizeof(long long));
+    if (!dist || !pred || !sommes) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+    Aleatoire alea;
+    aleatoire_init(&alea, 11);
+    for (int i = 0; i < NB_SOURCES_LOT; ++i) sources[i] = aleatoire_entier(&alea, n);
+
+    long long reference = 0;
+    double t0 = maintenant();
+    for (int i = 0; i < NB_SOURCES_LOT; ++i) {
+        dijkstra(g, sources[i], dist, pred);
+        for (int v = 0; v < n; ++v)
+            if (dist[v] < 1000000000) reference += dist[v];
+    }
+    double t_ref = (maintenant() - t0) / NB_SOURCES_LOT;
+    printf("\n%d sources: dijkstra loop %8.2f ms/source\n", NB_SOURCES_LOT, 1e3 * t_ref);
+
+    printf("%8s %14s %8s\n", "threads", "batch ms/src", "speedup");
+    int threads[NB_MESURES_MAX];
+    int nb_mesures = liste_threads(threads_max, threads);
+    for (int i = 0; i < nb_mesures; ++i) {
+        int t = threads[i];
+        PoolThreads *pool = pool_threads_creer(t);
+        if (!pool) {
+            fprintf(stderr, "thread pool failed\n");
+            exit(1);
+        }
+        memset(sommes, 0, (threads_max + 1) * sizeof(long long));
+        sommes[0] = n;
+        t0 = maintenant();
+        int ok = dijkstra_multi_sources_csr_rappel(c, sources, NB_SOURCES_LOT, sommer_ligne, sommes, pool);
+        double tp = (maintenant() - t0) / NB_SOURCES_LOT;
+        long long total = 0;
+        for (int k = 1; k <= t; ++k) total += sommes[k];
+        printf("%8d %14.2f %7.1fx  %s\n", t, 1e3 * tp, t_ref / tp,
+               ok && total == reference ? "same distances" : "MISMATCH");
+        pool_threads_detruire(pool);
+    }
+
+    free(dist);
+    free(pred);
+    free(sommes);
+}
+
+static void mesurer_delta_stepping(int n, int threads_max, int repetitions) {
+    int cote = 1;
+    while ((cote + 1) * (cote + 1) <= n) cote++;
+    GrapheValueListe *g = grille_valuee(cote, 7);
+    GrapheCSR *c = graphe_csr_depuis_value_liste(g);
+    n = cote * cote;
+    int *dist = (int *)malloc(n * sizeof(int));
+    int *pred = (int *)malloc(n * sizeof(int));
+    int *dist_ref = (int *)malloc(n * sizeof(int));
+    int *pred_ref = (int *)malloc(n * sizeof(int));
+    if (!g || !c || !dist || !pred || !dist_ref || !pred_ref) {
+        fprintf(stderr, "allocation failed\n");
+        exit(1);
+    }
+
+    printf("\n%d x %d weighted grid\n", cote, cote);
+    double t0 = maintenant();
+    for (int r = 0; r < repetitions; ++r) dijkstra_csr(c, r % n, dist_ref, pred_ref);
+    double t_ref = (maintenant() - t0) / repetitions;
+    printf("dijkstra_csr: %8.2f ms\n", 1e3 * t_ref);
+
+    printf("%8s %14s %8s\n", "threads", "delta-step ms", "speedup");
+    int threads[NB_MESURES_MAX];
+    int nb_mesures = liste_threads(threads_max, threads);
+    for (int i = 0; i < nb_mesures; ++i) {
+        int t = threads[i];
+        t0 = maintenant();
+        for (int r = 0; r < repetitions; ++r) delta_stepping_csr(c, r % n, dist, pred, 0, t);
+        double tp = (maintenant() - t0) / repetitions;
+        int identique = !memcmp(dist, dist_ref, n * sizeof(int)) &&
+                        !memcmp(pred, pred_ref, n * sizeof(int));
+        printf("%8d %14.2f %7.1fx  %s\n", t, 1e3 * tp, t_ref / tp,
+               identique ? "same dist/pred" : "MISMATCH");
+    }
+
+    free(dist);
+    free(pred);
+    free(dist_ref);
+    free(pred_ref);
+    mesurer_multi_sources(g, c, threads_max);
+    graphe_csr_detruire(c);
+    graphe_value_liste_detruire(g);
+}
+
+int main(int argc, char **argv) {
+    int n           = argc > 1 ? atoi(argv[1]) : 1000000;
+    int degre       = argc > 2 ? atoi(argv[2]) : 16;
+    int threads_max = argc > 3 ? atoi(argv[3]) : parallele_nb_threads_defaut();
+    int repetitions = argc > 4 ? atoi(argv[4]) : 3;
+    if (n <= 0 || degre <= 0 || threads_max <= 0 || repetitions <= 0) {
+        fprintf(stderr, "usage: %s [nb_sommets] [arcs_par_sommet] [threads_max] [repetitions]\n", argv[0]);
+        return 1;
+    }
+
+    GrapheListe *g = graphe_aleatoire(n, degre, 42);
+    GrapheCSR *c = graphe_csr_depuis_liste(g);
+    int *dist = (int *)malloc(n * sizeof(int));
+    int *dist_ref = (int *)malloc(n * sizeof(int));
+    int *comp = (int *)malloc(n * sizeof(int));
+    if (!g || !c || !dist || !dist_ref || !comp) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+    printf("n = %d, arcs = %d, %d processors\n", n, graphe_csr_nb_arcs(c),
+           parallele_nb_threads_defaut());
+
+    double t0 = maintenant();
+    for (int r = 0; r < repetitions; ++r) bfs_distances_csr(c, r % n, dist_ref);
+    double t_bfs = (maintenant() - t0) / repetitions;
+    t0 = maintenant();
+    for (int r = 0; r < repetitions; ++r) graphe_csr_est_connexe(c);
+    double t_cc = (maintenant() - t0) / repetitions;
+    printf("sequential: bfs %8.2f ms, connectivity %8.2f ms\n", 1e3 * t_bfs, 1e3 * t_cc);
+
+    printf("%8s %12s %8s %14s %8s\n", "threads", "bfs ms", "speedup", "components ms", "speedup");
+    int threads[NB_MESURES_MAX];
+    int nb_mesures = liste_threads(threads_max, threads);
+    for (int i = 0; i < nb_mesures; ++i) {
+        int t = threads[i];
+        int nb = 0;
+        t0 = maintenant();
+        for (int r = 0; r < repetitions; ++r) bfs_distances_parallele_csr(c, r % n, dist, t);
+        double tp_bfs = (maintenant() - t0) / repetitions;
+        /* dist holds the last source: checked outside the timed loop */
+        bfs_distances_csr(c, (repetitions - 1) % n, dist_ref);
+        int identique = !memcmp(dist, dist_ref, n * sizeof(int));
+        t0 = maintenant();
+        for (int r = 0; r < repetitions; ++r) nb = composantes_connexes_parallele_csr(c, comp, t);
+        double tp_cc = (maintenant() - t0) / repetitions;
+        printf("%8d %12.2f %7.1fx %14.2f %7.1fx  %s, %d components\n", t,
+               1e3 * tp_bfs, t_bfs / tp_bfs, 1e3 * tp_cc, t_cc / tp_cc,
+               identique ? "same dist" : "MISMATCH", nb);
+    }
+
+    mesurer_delta_stepping(n, threads_max, repetitions);
+
+    free(dist);
+    free(dist_ref);
+    free(comp);
+    graphe_csr_detruire(c);
+    graphe_liste_detruire(g);
+    return 0;
+}
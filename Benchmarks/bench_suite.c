@@ -0,0 +1,569 @@
+/* bench_suite.c Same operations on the four representations, built from
+   the same synthetic graph.
+   Usage: bench_suite [generateur] [nb_sommets] [degre_moyen] [repetitions]
+                      [csv|json] [fichier] [oriente]
+   generateur is rmat, erdos-renyi, grille or geometrique (self loops and
+   repeated arcs removed). Each repetition builds every representation
+   again (creation of the vertices, then one ajouter_arc per arc) and
+   times existe_arc (half hits), the out-degree of every vertex, a BFS, a
+   DFS over the whole graph, the connectivity test and, for the weighted
+   ones, a Dijkstra, from a source drawn for that repetition. One row per
+   representation and operation gives the median and the percentiles of
+   the repetitions, in ms, to stdout or fichier.
+   The lists run the library algorithms (bfs_distances, dfs_composantes,
+   graphe_liste_est_connexe, dijkstra); the other cases use the generic
+   versions below, written on the neighbor iteration of each library.
+   Matrices larger than BENCH_MATRICE_OCTETS_MAX are skipped. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "GrapheListe.h"
+#include "GrapheValueListe.h"
+#include "GrapheMatrice.h"
+#include "GrapheValueMatrice.h"
+#include "FilePriorite.h"
+#include "algos_non_values.h"
+#include "algos_values.h"
+#include "generateurs.h"
+
+#ifndef BENCH_MATRICE_OCTETS_MAX
+#define BENCH_MATRICE_OCTETS_MAX (1ull << 30)
+#endif
+
+#define POIDS_MAX        1000
+#define NB_REQUETES_MAX  1000000 /* existe_arc calls per repetition */
+#define INF              1000000000
+
+/* ---------- the four libraries behind one interface ---------- */
+
+typedef struct {
+    const char *nom;
+    int value;
+    unsigned long long (*octets)(int n); /* NULL = no limit */
+    void *(*creer)(int n, int oriente);  /* n vertices, no arcs */
+    void (*ajouter_arc)(void *g, int u, int v, int poids);
+    void (*detruire)(void *g);
+    int (*existe_arc)(void *g, int u, int v);
+    int (*degre)(void *g, int v);
+    /* next neighbor of v, -1 at the end; *curseur starts at 0 */
+    int (*voisin)(void *g, int v, uintptr_t *curseur, int *poids);
+    /* library versions, NULL = generic one */
+    void (*bfs)(void *g, int source, int *dist);
+    int (*dfs)(void *g, int *composante);
+    int (*connexe)(void *g);
+    void (*dijkstra)(void *g, int source, int *dist, int *pred);
+} Representation;
+
+/* GrapheListe */
+static void *liste_creer(int n, int oriente) {
+    GrapheListe *g = graphe_liste_creer(n, oriente);
+    for (int i = 0; g && i < n; ++i) graphe_liste_ajouter_sommet(g);
+    return g;
+}
+static void liste_ajouter_arc(void *g, int u, int v, int poids) {
+    (void)poids;
+    graphe_liste_ajouter_arc((GrapheListe *)g, u, v);
+}
+static void liste_detruire(void *g) { graphe_liste_detruire((GrapheListe *)g); }
+static int liste_existe_arc(void *g, int u, int v) { return graphe_liste_existe_arc((GrapheListe *)g, u, v); }
+static int liste_degre(void *g, int v) { return graphe_liste_degre_sortant((GrapheListe *)g, v); }
+static int liste_voisin(void *g, int v, uintptr_t *curseur, int *poids) {
+    ArcListe *a = *curseur ? ((ArcListe *)*curseur)->suivant : graphe_liste_voisins((GrapheListe *)g, v);
+    if (!a) return -1;
+    *curseur = (uintptr_t)a;
+    if (poids) *poids = 1;
+    return a->dest;
+}
+static void liste_bfs(void *g, int source, int *dist) { bfs_distances((GrapheListe *)g, source, dist); }
+static int liste_dfs(void *g, int *composante) { return dfs_composantes((GrapheListe *)g, composante); }
+static int liste_connexe(void *g) { return graphe_liste_est_connexe((GrapheListe *)g); }
+
+/* GrapheValueListe */
+static void *value_liste_creer(int n, int oriente) {
+    GrapheValueListe *g = graphe_value_liste_creer(n, oriente);
+    for (int i = 0; g && i < n; ++i) graphe_value_liste_ajouter_sommet(g);
+    return g;
+}
+static void value_liste_ajouter_arc(void *g, int u, int v, int poids) {
+    graphe_value_liste_ajouter_arc((GrapheValueListe *)g, u, v, poids);
+}
+static void value_liste_detruire(void *g) { graphe_value_liste_detruire((GrapheValueListe *)g); }
+static int value_liste_existe_arc(void *g, int u, int v) {
+    return graphe_value_liste_existe_arc((GrapheValueListe *)g, u, v);
+}
+static int value_liste_degre(void *g, int v) {
+    return graphe_value_liste_degre_sortant((GrapheValueListe *)g, v);
+}
+static int value_liste_voisin(void *g, int v, uintptr_t *curseur, int *poids) {
+    ArcValueListe *a = *curseur ? ((ArcValueListe *)*curseur)->suivant
+                                : graphe_value_liste_voisins((GrapheValueListe *)g, v);
+    if (!a) return -1;
+    *curseur = (uintptr_t)a;
+    if (poids) *poids = a->poids;
+    return a->dest;
+}
+static void value_liste_dijkstra(void *g, int source, int *dist, int *pred) {
+    dijkstra((GrapheValueListe *)g, source, dist, pred);
+}
+
+/* GrapheMatrice */
+static unsigned long long matrice_octets(int n) {
+    return (unsigned long long)n * (((unsigned long long)n + 63) / 64) * 8;
+}
+static void *matrice_creer(int n, int oriente) {
+    GrapheMatrice *g = graphe_matrice_creer(n, oriente);
+    for (int i = 0; g && i < n; ++i) graphe_matrice_ajouter_sommet(g);
+    return g;
+}
+static void matrice_ajouter_arc(void *g, int u, int v, int poids) {
+    (void)poids;
+    graphe_matrice_ajouter_arc((GrapheMatrice *)g, u, v);
+}
+static void matrice_detruire(void *g) { graphe_matrice_detruire((GrapheMatrice *)g); }
+static int matrice_existe_arc(void *g, int u, int v) { return graphe_matrice_existe_arc((GrapheMatrice *)g, u, v); }
+static int matrice_degre(void *g, int v) { return graphe_matrice_degre_sortant((GrapheMatrice *)g, v); }
+static int matrice_voisin(void *g, int v, uintptr_t *curseur, int *poids) {
+    /* the cursor holds the last neighbor returned, plus one */
+    int w = graphe_matrice_voisin_suivant((GrapheMatrice *)g, v, (int)*curseur - 1);
+    if (w < 0) return -1;
+    *curseur = (uintptr_t)w + 1;
+    if (poids) *poids = 1;
+    return w;
+}
+
+/* GrapheValueMatrice, entries as narrow as POIDS_MAX allows */
+static TypePoids type_poids(void) {
+    return POIDS_MAX <= 255 ? POIDS_UINT8 : POIDS_MAX <= 65535 ? POIDS_UINT16 : POIDS_INT32;
+}
+static unsigned long long value_matrice_octets(int n) {
+    int taille = type_poids() == POIDS_UINT8 ? 1 : type_poids() == POIDS_UINT16 ? 2 : 4;
+    return (unsigned long long)n * n * taille;
+}
+static void *value_matrice_creer(int n, int oriente) {
+    GrapheValueMatrice *g = graphe_value_matrice_creer_type(n, oriente, type_poids());
+    for (int i = 0; g && i < n; ++i) graphe_value_matrice_ajouter_sommet(g);
+    return g;
+}
+static void value_matrice_ajouter_arc(void *g, int u, int v, int poids) {
+    graphe_value_matrice_ajouter_arc((GrapheValueMatrice *)g, u, v, poids);
+}
+static void value_matrice_detruire(void *g) { graphe_value_matrice_detruire((GrapheValueMatrice *)g); }
+static int value_matrice_existe_arc(void *g, int u, int v) {
+    return graphe_value_matrice_existe_arc((GrapheValueMatrice *)g, u, v);
+}
+static int value_matrice_degre(void *g, int v) {
+    return graphe_value_matrice_degre_sortant((GrapheValueMatrice *)g, v);
+}
+static int value_matrice_voisin(void *g, int v, uintptr_t *curseur, int *poids) {
+    GrapheValueMatrice *m = (GrapheValueMatrice *)g;
+    for (int w = (int)*curseur; w < m->nb_sommets; ++w) {
+        int p = graphe_value_matrice_obtenir_poids(m, v, w);
+        if (p > 0) {
+            *curseur = (uintptr_t)w + 1;
+            if (poids) *poids = p;
+            return w;
+        }
+    }
+    *curseur = (uintptr_t)m->nb_sommets;
+    return -1;
+}
+
+static const Representation representations[] = {
+    { "GrapheMatrice", 0, matrice_octets, matrice_creer, matrice_ajouter_arc, matrice_detruire,
+      matrice_existe_arc, matrice_degre, matrice_voisin, NULL, NULL, NULL, NULL },
+    { "GrapheListe", 0, NULL, liste_creer, liste_ajouter_arc, liste_detruire,
+      liste_existe_arc, liste_degre, liste_voisin, liste_bfs, liste_dfs, liste_connexe, NULL },
+    { "GrapheValueMatrice", 1, value_matrice_octets, value_matrice_creer, value_matrice_ajouter_arc,
+      value_matrice_detruire, value_matrice_existe_arc, value_matrice_degre, value_matrice_voisin,
+      NULL, NULL, NULL, NULL },
+    { "GrapheValueListe", 1, NULL, value_liste_creer, value_liste_ajouter_arc, value_liste_detruire,
+      value_liste_existe_arc, value_liste_degre, value_liste_voisin, NULL, NULL, NULL,
+      value_liste_dijkstra },
+};
+#define NB_REPRESENTATIONS ((int)(sizeof representations / sizeof representations[0]))
+
+/* ---------- generic traversals ---------- */
+
+typedef struct {
+    int n;
+    int *file;
+    uintptr_t *curseur;
+    FilePriorite *tas;
+} Espace;
+
+static void bfs_generique(const Representation *r, void *g, const Espace *e, int source, int *dist) {
+    for (int v = 0; v < e->n; ++v) dist[v] = -1;
+    int tete = 0, queue = 0;
+    dist[source] = 0;
+    e->file[queue++] = source;
+    while (tete < queue) {
+        int v = e->file[tete++];
+        uintptr_t c = 0;
+        int w;
+        while ((w = r->voisin(g, v, &c, NULL)) >= 0) {
+            if (dist[w] < 0) {
+                dist[w] = dist[v] + 1;
+                e->file[queue++] = w;
+            }
+        }
+    }
+}
+
+/* composante[v] = index of the DFS tree of v, trees started in increasing order */
+static int dfs_generique(const Representation *r, void *g, const Espace *e, int *composante) {
+    int nb = 0;
+    for (int v = 0; v < e->n; ++v) composante[v] = -1;
+    for (int racine = 0; racine < e->n; ++racine) {
+        if (composante[racine] >= 0) continue;
+        int sommet = 0;
+        e->file[sommet++] = racine;
+        e->curseur[racine] = 0;
+        composante[racine] = nb;
+        while (sommet > 0) {
+            int v = e->file[sommet - 1];
+            int w = r->voisin(g, v, &e->curseur[v], NULL);
+            if (w < 0) {
+                sommet--;
+            } else if (composante[w] < 0) {
+                composante[w] = nb;
+                e->curseur[w] = 0;
+                e->file[sommet++] = w;
+            }
+        }
+        nb++;
+    }
+    return nb;
+}
+
+static int connexe_generique(const Representation *r, void *g, const Espace *e, int *dist) {
+    if (e->n <= 1) return 1;
+    bfs_generique(r, g, e, 0, dist);
+    for (int v = 0; v < e->n; ++v)
+        if (dist[v] < 0) return 0;
+    return 1;
+}
+
+static void dijkstra_generique(const Representation *r, void *g, const Espace *e, int source,
+                               int *dist, int *pred) {
+    for (int v = 0; v < e->n; ++v) {
+        dist[v] = INF;
+        pred[v] = -1;
+    }
+    file_priorite_vider(e->tas);
+    dist[source] = 0;
+    file_priorite_inserer(e->tas, source, 0);
+    while (!file_priorite_est_vide(e->tas)) {
+        int d;
+        int v = file_priorite_extraire_min(e->tas, &d);
+        uintptr_t c = 0;
+        int w, poids;
+        while ((w = r->voisin(g, v, &c, &poids)) >= 0) {
+            if (d + poids < dist[w]) {
+                dist[w] = d + poids;
+                pred[w] = v;
+                file_priorite_inserer(e->tas, w, dist[w]);
+            }
+        }
+    }
+}
+
+/* ---------- measures ---------- */
+
+enum { OP_CREATION, OP_INSERTION, OP_EXISTE_ARC, OP_DEGRE, OP_BFS, OP_DFS, OP_CONNEXITE,
+       OP_DIJKSTRA, NB_OPERATIONS };
+static const char *noms_operations[NB_OPERATIONS] = {
+    "creation", "ajouter_arc", "existe_arc", "degre_sortant", "bfs", "dfs", "connexite", "dijkstra"
+};
+
+typedef struct {
+    const char *representation;
+    const char *operation;
+    long long operations; /* elementary operations in one repetition */
+    double *ms;           /* one time per repetition */
+} Serie;
+
+typedef struct {
+    double mediane, p90, p99, min, max, moyenne;
+} Resume;
+
+static int comparer_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* linear interpolation between the closest ranks */
+static double percentile(const double *trie, int nb, double p) {
+    double rang = p / 100.0 * (nb - 1);
+    int i = (int)rang;
+    if (i >= nb - 1) return trie[nb - 1];
+    return trie[i] + (rang - i) * (trie[i + 1] - trie[i]);
+}
+
+static void resumer(const Serie *s, int nb, Resume *r) {
+    double *t = (double *)malloc((size_t)nb * sizeof(double));
+    memset(r, 0, sizeof *r);
+    if (!t) return;
+    memcpy(t, s->ms, (size_t)nb * sizeof(double));
+    qsort(t, (size_t)nb, sizeof(double), comparer_doubles);
+    r->mediane = percentile(t, nb, 50.0);
+    r->p90 = percentile(t, nb, 90.0);
+    r->p99 = percentile(t, nb, 99.0);
+    r->min = t[0];
+    r->max = t[nb - 1];
+    for (int i = 0; i < nb; ++i) r->moyenne += t[i] / nb;
+    free(t);
+}
+
+/* Checksums of the results, compared between representations */
+typedef struct {
+    long long bfs, dijkstra;
+    int composantes, connexe;
+} Controle;
+
+static long long somme_atteints(const int *dist, int n, int absent) {
+    long long s = 0;
+    for (int v = 0; v < n; ++v)
+        if (dist[v] != absent) s += dist[v] + 1;
+    return s;
+}
+
+static double chrono_ms(double t0) {
+    return 1e3 * (maintenant() - t0);
+}
+
+/* Runs every repetition on one representation; fills series[op] (NULL
+   ms = not measured) and the checksums of the last repetition */
+static int mesurer(const Representation *r, const ArcsGeneres *a, const int *sources,
+                   const int *req_u, const int *req_v, int nb_requetes, int repetitions,
+                   Serie *series, Controle *ctl) {
+    int n = a->nb_sommets;
+    int *dist = (int *)malloc((size_t)n * sizeof(int));
+    int *pred = (int *)malloc((size_t)n * sizeof(int));
+    Espace e;
+    e.n = n;
+    e.file = (int *)malloc((size_t)n * sizeof(int));
+    e.curseur = (uintptr_t *)malloc((size_t)n * sizeof(uintptr_t));
+    e.tas = file_priorite_creer(n);
+    int ok = dist && pred && e.file && e.curseur && e.tas;
+    for (int op = 0; op < NB_OPERATIONS; ++op) {
+        series[op].representation = r->nom;
+        series[op].operation = noms_operations[op];
+        series[op].ms = NULL;
+    }
+    for (int op = 0; ok && op < NB_OPERATIONS; ++op) {
+        if (op == OP_DIJKSTRA && !r->value) continue;
+        series[op].ms = (double *)calloc((size_t)repetitions, sizeof(double));
+        if (!series[op].ms) ok = 0;
+    }
+    series[OP_CREATION].operations = n;
+    series[OP_INSERTION].operations = a->nb_arcs;
+    series[OP_EXISTE_ARC].operations = nb_requetes;
+    series[OP_DEGRE].operations = n;
+    series[OP_BFS].operations = series[OP_DFS].operations = series[OP_CONNEXITE].operations = 1;
+    series[OP_DIJKSTRA].operations = 1;
+
+    volatile long long puits = 0; /* keeps the query loops alive */
+    for (int k = 0; ok && k < repetitions; ++k) {
+        double t0 = maintenant();
+        void *g = r->creer(n, a->oriente);
+        series[OP_CREATION].ms[k] = chrono_ms(t0);
+        if (!g) {
+            ok = 0;
+            break;
+        }
+
+        t0 = maintenant();
+        for (int i = 0; i < a->nb_arcs; ++i) r->ajouter_arc(g, a->src[i], a->dst[i], a->poids[i]);
+        series[OP_INSERTION].ms[k] = chrono_ms(t0);
+
+        long long trouves = 0;
+        t0 = maintenant();
+        for (int i = 0; i < nb_requetes; ++i) trouves += r->existe_arc(g, req_u[i], req_v[i]);
+        series[OP_EXISTE_ARC].ms[k] = chrono_ms(t0);
+
+        long long degres = 0;
+        t0 = maintenant();
+        for (int v = 0; v < n; ++v) degres += r->degre(g, v);
+        series[OP_DEGRE].ms[k] = chrono_ms(t0);
+        puits += trouves + degres;
+
+        t0 = maintenant();
+        if (r->bfs) r->bfs(g, sources[k], dist);
+        else bfs_generique(r, g, &e, sources[k], dist);
+        series[OP_BFS].ms[k] = chrono_ms(t0);
+        ctl->bfs = somme_atteints(dist, n, -1);
+
+        t0 = maintenant();
+        ctl->composantes = r->dfs ? r->dfs(g, pred) : dfs_generique(r, g, &e, pred);
+        series[OP_DFS].ms[k] = chrono_ms(t0);
+
+        t0 = maintenant();
+        ctl->connexe = r->connexe ? r->connexe(g) : connexe_generique(r, g, &e, dist);
+        series[OP_CONNEXITE].ms[k] = chrono_ms(t0);
+
+        if (r->value) {
+            t0 = maintenant();
+            if (r->dijkstra) r->dijkstra(g, sources[k], dist, pred);
+            else dijkstra_generique(r, g, &e, sources[k], dist, pred);
+            series[OP_DIJKSTRA].ms[k] = chrono_ms(t0);
+            ctl->dijkstra = somme_atteints(dist, n, INF);
+        }
+        r->detruire(g);
+    }
+    (void)puits;
+    free(dist);
+    free(pred);
+    free(e.file);
+    free(e.curseur);
+    file_priorite_detruire(e.tas);
+    return ok;
+}
+
+/* ---------- output ---------- */
+
+static void ecrire_csv(FILE *f, const char *generateur, const ArcsGeneres *a, int repetitions,
+                       const Serie *series, int nb_series) {
+    fprintf(f, "generator,vertices,arcs,oriented,runs,representation,operation,ops_per_run,"
+               "median_ms,p90_ms,p99_ms,min_ms,max_ms,mean_ms\n");
+    for (int i = 0; i < nb_series; ++i) {
+        Resume r;
+        resumer(&series[i], repetitions, &r);
+        fprintf(f, "%s,%d,%d,%d,%d,%s,%s,%lld,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n", generateur,
+                a->nb_sommets, a->nb_arcs, a->oriente, repetitions, series[i].representation,
+                series[i].operation, series[i].operations, r.mediane, r.p90, r.p99, r.min, r.max,
+                r.moyenne);
+    }
+}
+
+static void ecrire_json(FILE *f, const char *generateur, const ArcsGeneres *a, int repetitions,
+                        const Serie *series, int nb_series) {
+    fprintf(f, "{\n  \"generator\": \"%s\",\n  \"vertices\": %d,\n  \"arcs\": %d,\n"
+               "  \"oriented\": %d,\n  \"runs\": %d,\n  \"results\": [\n",
+            generateur, a->nb_sommets, a->nb_arcs, a->oriente, repetitions);
+    for (int i = 0; i < nb_series; ++i) {
+        Resume r;
+        resumer(&series[i], repetitions, &r);
+        fprintf(f, "    {\"representation\": \"%s\", \"operation\": \"%s\", \"ops_per_run\": %lld, "
+                   "\"median_ms\": %.6f, \"p90_ms\": %.6f, \"p99_ms\": %.6f, \"min_ms\": %.6f, "
+                   "\"max_ms\": %.6f, \"mean_ms\": %.6f, \"samples_ms\": [",
+                series[i].representation, series[i].operation, series[i].operations, r.mediane,
+                r.p90, r.p99, r.min, r.max, r.moyenne);
+        for (int k = 0; k < repetitions; ++k)
+            fprintf(f, "%s%.6f", k ? ", " : "", series[i].ms[k]);
+        fprintf(f, "]}%s\n", i + 1 < nb_series ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char **argv) {
+    const char *nom    = argc > 1 ? argv[1] : "rmat";
+    int n              = argc > 2 ? atoi(argv[2]) : 16384;
+    int degre          = argc > 3 ? atoi(argv[3]) : 16;
+    int repetitions    = argc > 4 ? atoi(argv[4]) : 5;
+    const char *format = argc > 5 ? argv[5] : "csv";
+    const char *chemin = argc > 6 ? argv[6] : NULL;
+    int oriente        = argc > 7 ? atoi(argv[7]) != 0 : 0;
+    TypeGenerateur type;
+    if (!generateur_depuis_nom(nom, &type) || n <= 1 || degre <= 0 || repetitions <= 0 ||
+        (strcmp(format, "csv") && strcmp(format, "json"))) {
+        fprintf(stderr, "usage: %s [rmat|erdos-renyi|grille|geometrique] [nb_sommets] "
+                        "[degre_moyen] [repetitions] [csv|json] [fichier] [oriente]\n", argv[0]);
+        return 1;
+    }
+
+    ArcsGeneres a;
+    double t0 = maintenant();
+    if (!generer_graphe(&a, type, n, degre, oriente, POIDS_MAX, 42) || !arcs_generes_nettoyer(&a)) {
+        fprintf(stderr, "cannot generate the graph\n");
+        return 1;
+    }
+    n = a.nb_sommets;
+    fprintf(stderr, "%s: %d vertices, %d %s in %.1f ms\n", nom, n, a.nb_arcs,
+            oriente ? "arcs" : "edges", 1e3 * (maintenant() - t0));
+
+    /* same sources and queries for every representation */
+    Aleatoire alea;
+    aleatoire_init(&alea, 7);
+    int nb_requetes = a.nb_arcs < NB_REQUETES_MAX ? (a.nb_arcs > 1000 ? a.nb_arcs : 1000) : NB_REQUETES_MAX;
+    int *sources = (int *)malloc((size_t)repetitions * sizeof(int));
+    int *req_u = (int *)malloc((size_t)nb_requetes * sizeof(int));
+    int *req_v = (int *)malloc((size_t)nb_requetes * sizeof(int));
+    Serie *series = (Serie *)calloc((size_t)NB_REPRESENTATIONS * NB_OPERATIONS, sizeof(Serie));
+    if (!sources || !req_u || !req_v || !series) {
+        fprintf(stderr, "allocation failed\n");
+        return 1;
+    }
+    for (int k = 0; k < repetitions; ++k) sources[k] = aleatoire_entier(&alea, n);
+    for (int i = 0; i < nb_requetes; ++i) {
+        if (i % 2 == 0 && a.nb_arcs > 0) {
+            int j = aleatoire_entier(&alea, a.nb_arcs);
+            req_u[i] = a.src[j];
+            req_v[i] = a.dst[j];
+        } else {
+            req_u[i] = aleatoire_entier(&alea, n);
+            req_v[i] = aleatoire_entier(&alea, n);
+        }
+    }
+
+    int nb_series = 0;
+    Controle reference = { 0, 0, 0, 0 }, valuee = { 0, 0, 0, 0 };
+    int reference_prise = 0, valuee_prise = 0;
+    for (int i = 0; i < NB_REPRESENTATIONS; ++i) {
+        const Representation *r = &representations[i];
+        if (r->octets && r->octets(n) > BENCH_MATRICE_OCTETS_MAX) {
+            fprintf(stderr, "%-18s skipped (%.0f MB matrix)\n", r->nom, r->octets(n) / 1e6);
+            continue;
+        }
+        Controle ctl = { 0, 0, 0, 0 };
+        t0 = maintenant();
+        if (!mesurer(r, &a, sources, req_u, req_v, nb_requetes, repetitions,
+                     &series[nb_series], &ctl)) {
+            fprintf(stderr, "%-18s failed (out of memory)\n", r->nom);
+            for (int op = 0; op < NB_OPERATIONS; ++op) free(series[nb_series + op].ms);
+            memset(&series[nb_series], 0, NB_OPERATIONS * sizeof(Serie));
+            continue;
+        }
+        fprintf(stderr, "%-18s %.1f s, %d components\n", r->nom, maintenant() - t0, ctl.composantes);
+
+        /* every representation must agree with the first one measured */
+        if (!reference_prise) {
+            reference = ctl;
+            reference_prise = 1;
+        } else if (ctl.bfs != reference.bfs || ctl.composantes != reference.composantes ||
+                   ctl.connexe != reference.connexe) {
+            fprintf(stderr, "%-18s MISMATCH on bfs / dfs / connexite\n", r->nom);
+        }
+        if (r->value) {
+            if (!valuee_prise) {
+                valuee = ctl;
+                valuee_prise = 1;
+            } else if (ctl.dijkstra != valuee.dijkstra) {
+                fprintf(stderr, "%-18s MISMATCH on dijkstra\n", r->nom);
+            }
+        }
+        /* keep only the measured operations, in order */
+        int k = nb_series;
+        for (int op = 0; op < NB_OPERATIONS; ++op)
+            if (series[nb_series + op].ms) series[k++] = series[nb_series + op];
+        nb_series = k;
+    }
+
+    FILE *f = chemin ? fopen(chemin, "w") : stdout;
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", chemin);
+        return 1;
+    }
+    if (!strcmp(format, "json")) ecrire_json(f, nom, &a, repetitions, series, nb_series);
+    else ecrire_csv(f, nom, &a, repetitions, series, nb_series);
+    if (chemin) fclose(f);
+
+    for (int i = 0; i < nb_series; ++i) free(series[i].ms);
+    free(series);
+    free(sources);
+    free(req_u);
+    free(req_v);
+    arcs_generes_liberer(&a);
+    return 0;
+}
@@ -0,0 +1,379 @@
+/* generateurs.c */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "generateurs.h"
+
+static const char *noms[] = { "rmat", "erdos-renyi", "grille", "geometrique" };
+
+/* ---------- random numbers ---------- */
+
+void aleatoire_init(Aleatoire *r, uint64_t graine) {
+    r->etat = graine;
+}
+
+uint64_t aleatoire_suivant(Aleatoire *r) {
+    uint64_t z = (r->etat += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+int aleatoire_entier(Aleatoire *r, int n) {
+    if (n <= 0) return 0;
+    /* high 32 bits scaled to [0, n), no modulo bias worth mentioning */
+    return (int)(((aleatoire_suivant(r) >> 32) * (uint64_t)n) >> 32);
+}
+
+double aleatoire_reel(Aleatoire *r) {
+    return (double)(aleatoire_suivant(r) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* ---------- arc arrays ---------- */
+
+static void vider(ArcsGeneres *a) {
+    memset(a, 0, sizeof *a);
+}
+
+static int preparer(ArcsGeneres *a, int nb_sommets, int capacite, int oriente) {
+    vider(a);
+    if (capacite < 1) capacite = 1;
+    a->src = (int *)malloc((size_t)capacite * sizeof(int));
+    a->dst = (int *)malloc((size_t)capacite * sizeof(int));
+    a->poids = (int *)malloc((size_t)capacite * sizeof(int));
+    if (!a->src || !a->dst || !a->poids) {
+        arcs_generes_liberer(a);
+        return 0;
+    }
+    a->nb_sommets = nb_sommets;
+    a->capacite = capacite;
+    a->oriente = oriente ? 1 : 0;
+    return 1;
+}
+
+static int ajouter(ArcsGeneres *a, int u, int v, int poids) {
+    if (a->nb_arcs == a->capacite) {
+        if (a->capacite > (1 << 30)) return 0;
+        int capacite = 2 * a->capacite;
+        int *s = (int *)realloc(a->src, (size_t)capacite * sizeof(int));
+        if (s) a->src = s;
+        int *d = (int *)realloc(a->dst, (size_t)capacite * sizeof(int));
+        if (d) a->dst = d;
+        int *p = (int *)realloc(a->poids, (size_t)capacite * sizeof(int));
+        if (p) a->poids = p;
+        if (!s || !d || !p) return 0;
+        a->capacite = capacite;
+    }
+    a->src[a->nb_arcs] = u;
+    a->dst[a->nb_arcs] = v;
+    a->poids[a->nb_arcs] = poids;
+    a->nb_arcs++;
+    return 1;
+}
+
+void arcs_generes_liberer(ArcsGeneres *a) {
+    if (!a) return;
+    free(a->src);
+    free(a->dst);
+    free(a->poids);
+    vider(a);
+}
+
+/* Stable counting sort of the arcs on cle[] (src or dst) into the t* arrays */
+static int trier_par(const ArcsGeneres *a, const int *cle, int *ts, int *td, int *tp) {
+    int *debut = (int *)calloc((size_t)a->nb_sommets + 1, sizeof(int));
+    if (!debut) return 0;
+    for (int i = 0; i < a->nb_arcs; ++i) debut[cle[i] + 1]++;
+    for (int v = 0; v < a->nb_sommets; ++v) debut[v + 1] += debut[v];
+    for (int i = 0; i < a->nb_arcs; ++i) {
+        int p = debut[cle[i]]++;
+        ts[p] = a->src[i];
+        td[p] = a->dst[i];
+        tp[p] = a->poids[i];
+    }
+    free(debut);
+    return 1;
+}
+
+int arcs_generes_nettoyer(ArcsGeneres *a) {
+    if (!a || !a->src) return 0;
+    int m = a->nb_arcs;
+    if (!a->oriente) {
+        for (int i = 0; i < m; ++i) {
+            if (a->src[i] > a->dst[i]) {
+                int t = a->src[i];
+                a->src[i] = a->dst[i];
+                a->dst[i] = t;
+            }
+        }
+    }
+    size_t taille = (m > 0 ? (size_t)m : 1) * sizeof(int);
+    int *ts = (int *)malloc(taille);
+    int *td = (int *)malloc(taille);
+    int *tp = (int *)malloc(taille);
+    int ok = ts && td && tp;
+    /* radix sort on (src, dst): by destination, then stably by source */
+    if (ok) ok = trier_par(a, a->dst, ts, td, tp);
+    if (ok) {
+        int *s = a->src, *d = a->dst, *p = a->poids;
+        a->src = ts;
+        a->dst = td;
+        a->poids = tp;
+        ts = s;
+        td = d;
+        tp = p;
+        ok = trier_par(a, a->src, ts, td, tp);
+    }
+    if (ok) {
+        int k = 0;
+        for (int i = 0; i < m; ++i) {
+            if (ts[i] == td[i]) continue;
+            if (k > 0 && ts[i] == ts[k - 1] && td[i] == td[k - 1]) continue;
+            ts[k] = ts[i];
+            td[k] = td[i];
+            tp[k] = tp[i];
+            k++;
+        }
+        free(a->src);
+        free(a->dst);
+        free(a->poids);
+        a->src = ts;
+        a->dst = td;
+        a->poids = tp;
+        a->nb_arcs = k;
+        return 1;
+    }
+    free(ts);
+    free(td);
+    free(tp);
+    return 0;
+}
+
+/* ---------- generators ---------- */
+
+static int poids_aleatoire(Aleatoire *r, int poids_max) {
+    return 1 + aleatoire_entier(r, poids_max);
+}
+
+int generer_rmat(ArcsGeneres *a, int echelle, int nb_arcs, double pa, double pb, double pc,
+                 int oriente, int poids_max, uint64_t graine) {
+    if (!a) return 0;
+    vider(a);
+    if (echelle < 0 || echelle > 30 || nb_arcs < 0 || poids_max <= 0) return 0;
+    if (pa < 0 || pb < 0 || pc < 0 || pa + pb + pc > 1.0) return 0;
+    int n = 1 << echelle;
+    if (!preparer(a, n, nb_arcs, oriente)) return 0;
+
+    Aleatoire r;
+    aleatoire_init(&r, graine);
+    double ab = pa + pb, abc = pa + pb + pc;
+    for (int i = 0; i < nb_arcs; ++i) {
+        int u = 0, v = 0;
+        for (int bit = n >> 1; bit > 0; bit >>= 1) {
+            double x = aleatoire_reel(&r);
+            if (x >= abc) {
+                u |= bit;
+                v |= bit;
+            } else if (x >= ab) {
+                u |= bit;
+            } else if (x >= pa) {
+                v |= bit;
+            }
+        }
+        a->src[i] = u;
+        a->dst[i] = v;
+        a->poids[i] = poids_aleatoire(&r, poids_max);
+    }
+    a->nb_arcs = nb_arcs;
+
+    /* without the shuffle vertex 0 is the hub and ids follow the degrees */
+    int *perm = (int *)malloc((size_t)n * sizeof(int));
+    if (!perm) {
+        arcs_generes_liberer(a);
+        return 0;
+    }
+    for (int v = 0; v < n; ++v) perm[v] = v;
+    for (int v = n - 1; v > 0; --v) {
+        int w = aleatoire_entier(&r, v + 1);
+        int t = perm[v];
+        perm[v] = perm[w];
+        perm[w] = t;
+    }
+    for (int i = 0; i < nb_arcs; ++i) {
+        a->src[i] = perm[a->src[i]];
+        a->dst[i] = perm[a->dst[i]];
+    }
+    free(perm);
+    return 1;
+}
+
+int generer_erdos_renyi(ArcsGeneres *a, int nb_sommets, int nb_arcs, int oriente,
+                        int poids_max, uint64_t graine) {
+    if (!a) return 0;
+    vider(a);
+    if (nb_sommets < 2 || nb_arcs < 0 || poids_max <= 0) return 0;
+    if (!preparer(a, nb_sommets, nb_arcs, oriente)) return 0;
+
+    Aleatoire r;
+    aleatoire_init(&r, graine);
+    for (int i = 0; i < nb_arcs; ++i) {
+        int u = aleatoire_entier(&r, nb_sommets);
+        int v = aleatoire_entier(&r, nb_sommets - 1);
+        if (v >= u) v++;
+        a->src[i] = u;
+        a->dst[i] = v;
+        a->poids[i] = poids_aleatoire(&r, poids_max);
+    }
+    a->nb_arcs = nb_arcs;
+    return 1;
+}
+
+int generer_grille(ArcsGeneres *a, int cote_x, int cote_y, int oriente, int poids_max,
+                   uint64_t graine) {
+    if (!a) return 0;
+    vider(a);
+    if (cote_x <= 0 || cote_y <= 0 || poids_max <= 0) return 0;
+    long long n = (long long)cote_x * cote_y;
+    long long m = (2 * n - cote_x - cote_y) * (oriente ? 2 : 1);
+    if (n > (1 << 30) || m > (1 << 30)) return 0;
+    if (!preparer(a, (int)n, (int)m, oriente)) return 0;
+
+    Aleatoire r;
+    aleatoire_init(&r, graine);
+    for (int y = 0; y < cote_y; ++y) {
+        for (int x = 0; x < cote_x; ++x) {
+            int v = y * cote_x + x;
+            for (int k = 0; k < 2; ++k) {
+                int w = k == 0 ? (x + 1 < cote_x ? v + 1 : -1) : (y + 1 < cote_y ? v + cote_x : -1);
+                if (w < 0) continue;
+                int poids = poids_aleatoire(&r, poids_max);
+                ajouter(a, v, w, poids);
+                if (oriente) ajouter(a, w, v, poids);
+            }
+        }
+    }
+    return 1;
+}
+
+int generer_geometrique(ArcsGeneres *a, int nb_sommets, double rayon, int oriente,
+                        int poids_max, uint64_t graine) {
+    if (!a) return 0;
+    vider(a);
+    if (nb_sommets <= 0 || !(rayon > 0.0) || poids_max <= 0) return 0;
+    /* cells of side >= rayon: the neighbors of a point are in its own
+       cell or one of the 8 around it */
+    int k = rayon >= 1.0 ? 1 : (int)(1.0 / rayon);
+    while ((long long)k * k > 4LL * nb_sommets + 16) k /= 2;
+    if (k < 1) k = 1;
+    int nb_cases = k * k;
+
+    double *x = (double *)malloc((size_t)nb_sommets * sizeof(double));
+    double *y = (double *)malloc((size_t)nb_sommets * sizeof(double));
+    int *debut = (int *)calloc((size_t)nb_cases + 1, sizeof(int));
+    int *ordre = (int *)malloc((size_t)nb_sommets * sizeof(int));
+    int *cases = (int *)malloc((size_t)nb_sommets * sizeof(int));
+    int ok = x && y && debut && ordre && cases && preparer(a, nb_sommets, nb_sommets, oriente);
+    if (ok) {
+        Aleatoire r;
+        aleatoire_init(&r, graine);
+        for (int i = 0; i < nb_sommets; ++i) {
+            x[i] = aleatoire_reel(&r);
+            y[i] = aleatoire_reel(&r);
+            int cx = (int)(x[i] * k), cy = (int)(y[i] * k);
+            cases[i] = (cy < k ? cy : k - 1) * k + (cx < k ? cx : k - 1);
+            debut[cases[i] + 1]++;
+        }
+        for (int c = 0; c < nb_cases; ++c) debut[c + 1] += debut[c];
+        /* filled from the end of each cell, debut[c + 1] comes back to
+           the start of cell c + 1 */
+        for (int i = nb_sommets - 1; i >= 0; --i) ordre[--debut[cases[i] + 1]] = i;
+        memmove(debut, debut + 1, (size_t)nb_cases * sizeof(int));
+        debut[nb_cases] = nb_sommets;
+
+        double r2 = rayon * rayon;
+        for (int i = 0; ok && i < nb_sommets; ++i) {
+            int cx = cases[i] % k, cy = cases[i] / k;
+            for (int dy = -1; ok && dy <= 1; ++dy) {
+                for (int dx = -1; ok && dx <= 1; ++dx) {
+                    int nx = cx + dx, ny = cy + dy;
+                    if (nx < 0 || ny < 0 || nx >= k || ny >= k) continue;
+                    int c = ny * k + nx;
+                    for (int p = debut[c]; ok && p < debut[c + 1]; ++p) {
+                        int j = ordre[p];
+                        if (j <= i) continue;
+                        double ex = x[i] - x[j], ey = y[i] - y[j];
+                        double d2 = ex * ex + ey * ey;
+                        if (d2 >= r2) continue;
+                        int poids = 1 + (int)(sqrt(d2) / rayon * (poids_max - 1));
+                        ok = ajouter(a, i, j, poids);
+                        if (ok && oriente) ok = ajouter(a, j, i, poids);
+                    }
+                }
+            }
+        }
+    }
+    free(x);
+    free(y);
+    free(debut);
+    free(ordre);
+    free(cases);
+    if (!ok) arcs_generes_liberer(a);
+    return ok;
+}
+
+int generer_graphe(ArcsGeneres *a, TypeGenerateur type, int nb_sommets, int degre_moyen,
+                   int oriente, int poids_max, uint64_t graine) {
+    if (!a) return 0;
+    vider(a);
+    if (nb_sommets <= 1 || degre_moyen <= 0) return 0;
+    /* a non oriented edge shows up in two lists */
+    long long m = (long long)nb_sommets * degre_moyen / (oriente ? 1 : 2);
+    switch (type) {
+    case GEN_RMAT: {
+        int echelle = 0;
+        while ((1LL << echelle) < nb_sommets) echelle++;
+        m = (m << echelle) / nb_sommets;
+        if (m > (1 << 30)) return 0;
+        return generer_rmat(a, echelle, (int)m, 0.57, 0.19, 0.19, oriente, poids_max, graine);
+    }
+    case GEN_ERDOS_RENYI:
+        if (m > (1 << 30)) return 0;
+        return generer_erdos_renyi(a, nb_sommets, (int)m, oriente, poids_max, graine);
+    case GEN_GRILLE: {
+        int cote = (int)sqrt((double)nb_sommets);
+        while ((long long)(cote + 1) * (cote + 1) <= nb_sommets) cote++;
+        while ((long long)cote * cote > nb_sommets) cote--;
+        return generer_grille(a, cote, cote, oriente, poids_max, graine);
+    }
+    case GEN_GEOMETRIQUE: {
+        /* n pi r^2 points fall within the radius of a point */
+        double rayon = sqrt(degre_moyen / (3.14159265358979323846 * nb_sommets));
+        return generer_geometrique(a, nb_sommets, rayon, oriente, poids_max, graine);
+    }
+    }
+    return 0;
+}
+
+const char *generateur_nom(TypeGenerateur type) {
+    if ((int)type < 0 || (int)type >= (int)(sizeof noms / sizeof noms[0])) return "?";
+    return noms[type];
+}
+
+int generateur_depuis_nom(const char *nom, TypeGenerateur *type) {
+    if (!nom || !type) return 0;
+    for (int i = 0; i < (int)(sizeof noms / sizeof noms[0]); ++i) {
+        if (!strcmp(nom, noms[i])) {
+            *type = (TypeGenerateur)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+double maintenant(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
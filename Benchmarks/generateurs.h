@@ -0,0 +1,76 @@
+/* generateurs.h Synthetic graphs for the benchmarks */
+#ifndef GENERATEURS_H
+#define GENERATEURS_H
+
+#include <stdint.h>
+
+/* All generators are deterministic for a given seed and return plain arc
+   arrays, so that every representation can be built from the same graph.
+   For a non oriented graph each edge appears once. Weights are in
+   [1, poids_max]. The functions return 1 = ok, 0 on invalid arguments
+   or lack of memory (the arrays are then left empty). */
+
+typedef enum {
+    GEN_RMAT = 0,    /* R-MAT / Kronecker, skewed degrees (Graph500) */
+    GEN_ERDOS_RENYI, /* G(n, m), uniform endpoints */
+    GEN_GRILLE,      /* 2D grid with 4 neighbors, like a road network */
+    GEN_GEOMETRIQUE  /* random points of the unit square, edges under a radius */
+} TypeGenerateur;
+
+typedef struct {
+    int nb_sommets;
+    int nb_arcs;
+    int capacite;
+    int oriente;
+    int *src;
+    int *dst;
+    int *poids;
+} ArcsGeneres;
+
+/* splitmix64, small and good enough for generating graphs */
+typedef struct {
+    uint64_t etat;
+} Aleatoire;
+
+void     aleatoire_init(Aleatoire *r, uint64_t graine);
+uint64_t aleatoire_suivant(Aleatoire *r);
+int      aleatoire_entier(Aleatoire *r, int n); /* uniform in [0, n) */
+double   aleatoire_reel(Aleatoire *r);          /* uniform in [0, 1) */
+
+/* R-MAT on 2^echelle vertices with nb_arcs arcs; pa, pb, pc are the
+   probabilities of the top-left, top-right and bottom-left quadrants
+   (0.57, 0.19, 0.19 in Graph500). Vertex ids are shuffled afterwards.
+   Self loops and duplicates are kept, see arcs_generes_nettoyer. */
+int generer_rmat(ArcsGeneres *a, int echelle, int nb_arcs, double pa, double pb, double pc,
+                 int oriente, int poids_max, uint64_t graine);
+/* nb_arcs arcs with uniform endpoints (self loops excluded) */
+int generer_erdos_renyi(ArcsGeneres *a, int nb_sommets, int nb_arcs, int oriente,
+                        int poids_max, uint64_t graine);
+/* cote_x * cote_y vertices, vertex y * cote_x + x linked to its right and
+   lower neighbors; oriented grids get both directions of each edge */
+int generer_grille(ArcsGeneres *a, int cote_x, int cote_y, int oriente, int poids_max,
+                   uint64_t graine);
+/* nb_sommets uniform points, an edge between two points closer than
+   rayon, weighted by the distance scaled to [1, poids_max]; oriented
+   graphs get both directions */
+int generer_geometrique(ArcsGeneres *a, int nb_sommets, double rayon, int oriente,
+                        int poids_max, uint64_t graine);
+
+/* About nb_sommets vertices whose lists hold degre_moyen neighbors on
+   average, before cleaning (R-MAT rounds the order up to a power of two,
+   the grid down to a square and always has degree 4) */
+int generer_graphe(ArcsGeneres *a, TypeGenerateur type, int nb_sommets, int degre_moyen,
+                   int oriente, int poids_max, uint64_t graine);
+
+/* Removes self loops and repeated arcs (repeated edges if non oriented),
+   keeping the first weight; the arcs end up sorted by source */
+int arcs_generes_nettoyer(ArcsGeneres *a);
+void arcs_generes_liberer(ArcsGeneres *a);
+
+const char *generateur_nom(TypeGenerateur type);
+int generateur_depuis_nom(const char *nom, TypeGenerateur *type); /* 1 = ok */
+
+/* Wall clock in seconds, for the timings of the benchmarks */
+double maintenant(void);
+
+#endif /* GENERATEURS_H */
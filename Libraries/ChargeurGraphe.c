@@ -0,0 +1,312 @@
+/* ChargeurGraphe.c */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ChargeurGraphe.h"
+#include "Parallele.h"
+
+#ifdef _WIN32
+#define CHARGEUR_SANS_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+#define ENTIER_MAX 2147483647LL
+
+/* ---------- File mapping ---------- */
+
+typedef struct {
+    const char *donnees;
+    size_t taille;
+    int mappe; /* 1 = munmap, 0 = free */
+} Fichier;
+
+static int ouvrir_fichier(const char *chemin, Fichier *f) {
+    f->donnees = NULL;
+    f->taille = 0;
+    f->mappe = 0;
+#ifndef CHARGEUR_SANS_MMAP
+    int fd = open(chemin, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return 0;
+    }
+    f->taille = (size_t)st.st_size;
+    if (f->taille > 0) {
+        void *p = mmap(NULL, f->taille, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            return 0;
+        }
+        posix_madvise(p, f->taille, POSIX_MADV_SEQUENTIAL);
+        f->donnees = (const char *)p;
+        f->mappe = 1;
+    }
+    close(fd);
+    return 1;
+#else
+    /* no mmap: read the whole file at once */
+    FILE *fp = fopen(chemin, "rb");
+    if (!fp) return 0;
+    if (fseek(fp, 0, SEEK_END) != 0) {
+        fclose(fp);
+        return 0;
+    }
+    long taille = ftell(fp);
+    rewind(fp);
+    char *buf = taille > 0 ? (char *)malloc((size_t)taille) : NULL;
+    if (taille < 0 || (taille > 0 && (!buf || fread(buf, 1, (size_t)taille, fp) != (size_t)taille))) {
+        free(buf);
+        fclose(fp);
+        return 0;
+    }
+    fclose(fp);
+    f->donnees = buf;
+    f->taille = (size_t)taille;
+    return 1;
+#endif
+}
+
+static void fermer_fichier(Fichier *f) {
+#ifndef CHARGEUR_SANS_MMAP
+    if (f->mappe) munmap((void *)f->donnees, f->taille);
+#else
+    free((void *)f->donnees);
+#endif
+    f->donnees = NULL;
+}
+
+/* ---------- Parsing ---------- */
+
+typedef struct {
+    const char *debut;  /* lines starting in [debut, fin) belong to the chunk */
+    const char *fin;
+    int nb_arcs;
+    int max_id;
+    int ignorees;
+    int decalage;       /* first arc index of the chunk (second pass) */
+} Morceau;
+
+typedef struct {
+    Morceau *morceaux;
+    int *src;           /* NULL during the counting pass */
+    int *dst;
+    int *poids;         /* NULL if the weights are not wanted */
+} Analyse;
+
+static inline int est_blanc(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+/* Hand-rolled parser, bounded by fin (the mapping is not NUL terminated) */
+static void analyser_morceau(Morceau *m, int *src, int *dst, int *poids) {
+    const char *p = m->debut, *fin = m->fin;
+    int nb = 0, max_id = -1, ignorees = 0;
+
+    while (p < fin) {
+        while (p < fin && est_blanc(*p)) p++;
+        if (p == fin) break;
+        if (*p == '\n') {
+            p++;
+            continue;
+        }
+        if (*p == '#' || *p == '%') {
+            while (p < fin && *p != '\n') p++;
+            continue;
+        }
+
+        long long x[3];
+        int k = 0, correct = 1;
+        while (k < 3 && p < fin && *p != '\n') {
+            int negatif = 0;
+            if (*p == '-') {
+                negatif = 1;
+                p++;
+            }
+            if (p == fin || *p < '0' || *p > '9') {
+                correct = 0;
+                break;
+            }
+            long long v = 0;
+            while (p < fin && *p >= '0' && *p <= '9') {
+                if (v <= ENTIER_MAX) v = v * 10 + (*p - '0');
+                p++;
+            }
+            x[k++] = negatif ? -v : v;
+            while (p < fin && est_blanc(*p)) p++;
+        }
+        while (p < fin && *p != '\n') p++; /* extra columns are ignored */
+
+        if (!correct || k < 2 || x[0] < 0 || x[1] < 0 || x[0] >= ENTIER_MAX ||
+            x[1] >= ENTIER_MAX || (k == 3 && (x[2] > ENTIER_MAX || x[2] < -ENTIER_MAX))) {
+            ignorees++;
+            continue;
+        }
+        if (src) {
+            int i = m->decalage + nb;
+            src[i] = (int)x[0];
+            dst[i] = (int)x[1];
+            if (poids) poids[i] = k == 3 ? (int)x[2] : 1;
+        }
+        nb++;
+        if (x[0] > max_id) max_id = (int)x[0];
+        if (x[1] > max_id) max_id = (int)x[1];
+    }
+
+    m->nb_arcs = nb;
+    m->max_id = max_id;
+    m->ignorees = ignorees;
+}
+
+static void tache_analyse(int id, int nb, void *arg) {
+    (void)nb;
+    Analyse *a = (Analyse *)arg;
+    analyser_morceau(&a->morceaux[id], a->src, a->dst, a->poids);
+}
+
+typedef struct {
+    int nb_sommets;
+    int nb_arcs;
+    int *src;
+    int *dst;
+    int *poids;
+} ListeArcs;
+
+/* Maps the file and fills the arc arrays; the clock starts in the caller */
+static int lire_arcs(const char *chemin, int avec_poids, int nb_threads,
+                     ListeArcs *arcs, BilanChargement *bilan) {
+    Fichier f;
+    memset(arcs, 0, sizeof(*arcs));
+    if (!chemin || !ouvrir_fichier(chemin, &f)) return 0;
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+    if ((size_t)nb_threads > f.taille / 4096 + 1) nb_threads = (int)(f.taille / 4096 + 1);
+
+    Analyse a;
+    a.morceaux = (Morceau *)calloc(nb_threads, sizeof(Morceau));
+    a.src = a.dst = a.poids = NULL;
+    int ok = a.morceaux != NULL;
+
+    if (ok) {
+        /* cut into equal chunks, each boundary moved to the next line start */
+        const char *fin = f.donnees + f.taille;
+        for (int t = 0; t < nb_threads; ++t) {
+            const char *p = f.donnees + f.taille / nb_threads * t;
+            if (t > 0) {
+                while (p < fin && p[-1] != '\n') p++;
+            }
+            a.morceaux[t].debut = p;
+        }
+        for (int t = 0; t < nb_threads; ++t)
+            a.morceaux[t].fin = t + 1 < nb_threads ? a.morceaux[t + 1].debut : fin;
+        if (f.taille == 0)
+            for (int t = 0; t < nb_threads; ++t) a.morceaux[t].debut = a.morceaux[t].fin = NULL;
+
+        /* counting pass */
+        ok = parallele_executer(nb_threads, tache_analyse, &a);
+    }
+
+    long long total = 0;
+    int max_id = -1, ignorees = 0;
+    for (int t = 0; ok && t < nb_threads; ++t) {
+        a.morceaux[t].decalage = (int)total;
+        total += a.morceaux[t].nb_arcs;
+        if (a.morceaux[t].max_id > max_id) max_id = a.morceaux[t].max_id;
+        ignorees += a.morceaux[t].ignorees;
+    }
+    if (ok && (total > ENTIER_MAX || max_id >= ENTIER_MAX)) ok = 0;
+
+    if (ok) {
+        size_t n = total > 0 ? (size_t)total : 1;
+        a.src = (int *)malloc(n * sizeof(int));
+        a.dst = (int *)malloc(n * sizeof(int));
+        a.poids = avec_poids ? (int *)malloc(n * sizeof(int)) : NULL;
+        ok = a.src && a.dst && (!avec_poids || a.poids);
+        /* filling pass, each chunk writes at its own offset */
+        if (ok) ok = parallele_executer(nb_threads, tache_analyse, &a);
+    }
+
+    if (ok) {
+        arcs->nb_sommets = max_id + 1;
+        arcs->nb_arcs = (int)total;
+        arcs->src = a.src;
+        arcs->dst = a.dst;
+        arcs->poids = a.poids;
+        if (bilan) {
+            bilan->nb_sommets = arcs->nb_sommets;
+            bilan->nb_arcs = arcs->nb_arcs;
+            bilan->lignes_ignorees = ignorees;
+            bilan->octets = f.taille;
+        }
+    } else {
+        free(a.src);
+        free(a.dst);
+        free(a.poids);
+    }
+    free(a.morceaux);
+    fermer_fichier(&f);
+    return ok;
+}
+
+static void liberer_arcs(ListeArcs *arcs) {
+    free(arcs->src);
+    free(arcs->dst);
+    free(arcs->poids);
+}
+
+static void terminer_bilan(BilanChargement *bilan, double t0, double t1) {
+    if (!bilan) return;
+    double t2 = instrumentation_horloge();
+    bilan->secondes_analyse = t1 - t0;
+    bilan->secondes_construction = t2 - t1;
+    bilan->arcs_par_seconde = t2 > t0 ? bilan->nb_arcs / (t2 - t0) : 0.0;
+}
+
+/* PUBLIC API */
+
+GrapheListe *charger_graphe_liste(const char *chemin, int oriente, int nb_threads,
+                                  BilanChargement *bilan) {
+    double t0 = instrumentation_horloge();
+    ListeArcs arcs;
+    if (!lire_arcs(chemin, 0, nb_threads, &arcs, bilan)) return NULL;
+    double t1 = instrumentation_horloge();
+    GrapheListe *g = graphe_liste_depuis_arcs(arcs.nb_sommets, oriente,
+                                              arcs.src, arcs.dst, arcs.nb_arcs);
+    liberer_arcs(&arcs);
+    terminer_bilan(bilan, t0, t1);
+    return g;
+}
+
+GrapheValueListe *charger_graphe_value_liste(const char *chemin, int oriente, int nb_threads,
+                                             BilanChargement *bilan) {
+    double t0 = instrumentation_horloge();
+    ListeArcs arcs;
+    if (!lire_arcs(chemin, 1, nb_threads, &arcs, bilan)) return NULL;
+    double t1 = instrumentation_horloge();
+    GrapheValueListe *g = graphe_value_liste_depuis_arcs(arcs.nb_sommets, oriente, arcs.src,
+                                                         arcs.dst, arcs.poids, arcs.nb_arcs);
+    liberer_arcs(&arcs);
+    terminer_bilan(bilan, t0, t1);
+    return g;
+}
+
+GrapheCSR *charger_graphe_csr(const char *chemin, int oriente, int value, int nb_threads,
+                              BilanChargement *bilan) {
+    double t0 = instrumentation_horloge();
+    ListeArcs arcs;
+    if (!lire_arcs(chemin, value, nb_threads, &arcs, bilan)) return NULL;
+    double t1 = instrumentation_horloge();
+    GrapheCSR *c = graphe_csr_depuis_arcs(arcs.nb_sommets, oriente, arcs.src, arcs.dst,
+                                          value ? arcs.poids : NULL, arcs.nb_arcs);
+    liberer_arcs(&arcs);
+    terminer_bilan(bilan, t0, t1);
+    return c;
+}
@@ -0,0 +1,37 @@
+/* ChargeurGraphe.h */
+#ifndef CHARGEUR_GRAPHE_H
+#define CHARGEUR_GRAPHE_H
+
+#include <stddef.h>
+#include "GrapheListe.h"
+#include "GrapheValueListe.h"
+#include "GrapheCSR.h"
+
+/* Text edge lists (SNAP style): one arc "u v" or "u v w" per line,
+   separated by spaces, tabs or commas; lines starting with '#' or '%'
+   are comments. Vertex ids are kept as they are (order = largest id + 1),
+   a missing weight counts as 1.
+   The file is memory-mapped and parsed by nb_threads threads (<= 0: one
+   per processor) in chunks cut at line boundaries: a counting pass sizes
+   the arc arrays, a second pass fills them, then the graph is built in
+   bulk (graphe_*_depuis_arcs). */
+
+typedef struct {
+    int nb_sommets;
+    int nb_arcs;              /* arc lines read */
+    int lignes_ignorees;      /* malformed lines */
+    size_t octets;            /* file size */
+    double secondes_analyse;  /* mapping + both parsing passes */
+    double secondes_construction;
+    double arcs_par_seconde;  /* nb_arcs / total time */
+} BilanChargement;
+
+/* bilan may be NULL; NULL is returned if the file cannot be read */
+GrapheListe *charger_graphe_liste(const char *chemin, int oriente, int nb_threads,
+                                  BilanChargement *bilan);
+GrapheValueListe *charger_graphe_value_liste(const char *chemin, int oriente, int nb_threads,
+                                             BilanChargement *bilan);
+GrapheCSR *charger_graphe_csr(const char *chemin, int oriente, int value, int nb_threads,
+                              BilanChargement *bilan);
+
+#endif /* CHARGEUR_GRAPHE_H */
@@ -0,0 +1,137 @@
+/* FilePriorite.c */
+#include <stdio.h>
+#include <stdlib.h>
+#include "FilePriorite.h"
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+#define ARITE 4
+
+/* a < b in (key, vertex) order */
+static int plus_petit(const FilePriorite *f, int a, int b) {
+    if (f->cle[a] != f->cle[b]) return f->cle[a] < f->cle[b];
+    return a < b;
+}
+
+static void placer(FilePriorite *f, int i, int v) {
+    f->tas[i] = v;
+    f->pos[v] = i;
+}
+
+static void remonter(FilePriorite *f, int i) {
+    int v = f->tas[i];
+    while (i > 0) {
+        int parent = (i - 1) / ARITE;
+        int p = f->tas[parent];
+        if (!plus_petit(f, v, p)) break;
+        placer(f, i, p);
+        i = parent;
+    }
+    placer(f, i, v);
+}
+
+static void descendre(FilePriorite *f, int i) {
+    int v = f->tas[i];
+    for (;;) {
+        int premier = ARITE * i + 1;
+        if (premier >= f->taille) break;
+        int dernier = premier + ARITE;
+        if (dernier > f->taille) dernier = f->taille;
+
+        int meilleur = premier;
+        for (int c = premier + 1; c < dernier; ++c)
+            if (plus_petit(f, f->tas[c], f->tas[meilleur])) meilleur = c;
+
+        if (!plus_petit(f, f->tas[meilleur], v)) break;
+        placer(f, i, f->tas[meilleur]);
+        i = meilleur;
+    }
+    placer(f, i, v);
+}
+
+/* PUBLIC API */
+
+FilePriorite *file_priorite_creer(int capacite) {
+    FilePriorite *f = (FilePriorite *)malloc(sizeof(FilePriorite));
+    if (!f) return NULL;
+    if (capacite <= 0) capacite = 1;
+
+    f->tas = (int *)malloc(capacite * sizeof(int));
+    f->pos = (int *)malloc(capacite * sizeof(int));
+    f->cle = (int *)malloc(capacite * sizeof(int));
+    if (!f->tas || !f->pos || !f->cle) {
+        free(f->tas);
+        free(f->pos);
+        free(f->cle);
+        free(f);
+        return NULL;
+    }
+    for (int v = 0; v < capacite; ++v) f->pos[v] = -1;
+    f->taille   = 0;
+    f->capacite = capacite;
+    return f;
+}
+
+void file_priorite_detruire(FilePriorite *f) {
+    if (!f) return;
+    free(f->tas);
+    free(f->pos);
+    free(f->cle);
+    free(f);
+}
+
+void file_priorite_vider(FilePriorite *f) {
+    if (!f) return;
+    for (int i = 0; i < f->taille; ++i) f->pos[f->tas[i]] = -1;
+    f->taille = 0;
+}
+
+int file_priorite_est_vide(const FilePriorite *f) {
+    return !f || f->taille == 0;
+}
+
+int file_priorite_contient(const FilePriorite *f, int v) {
+    if (!f || v < 0 || v >= f->capacite) return 0;
+    return f->pos[v] != -1;
+}
+
+void file_priorite_inserer(FilePriorite *f, int v, int cle) {
+    if (!f || v < 0 || v >= f->capacite) return;
+    if (f->pos[v] != -1) {
+        file_priorite_diminuer_cle(f, v, cle);
+        return;
+    }
+    INSTR_COMPTER(STAT_TAS_INSERTIONS, 1);
+    f->cle[v] = cle;
+    f->tas[f->taille] = v;
+    f->pos[v] = f->taille;
+    f->taille++;
+    remonter(f, f->taille - 1);
+}
+
+void file_priorite_diminuer_cle(FilePriorite *f, int v, int cle) {
+    if (!f || v < 0 || v >= f->capacite) return;
+    if (f->pos[v] == -1 || cle >= f->cle[v]) return;
+    INSTR_COMPTER(STAT_TAS_DIMINUTIONS, 1);
+    f->cle[v] = cle;
+    remonter(f, f->pos[v]);
+}
+
+int file_priorite_min(const FilePriorite *f) {
+    if (!f || f->taille == 0) return -1;
+    return f->tas[0];
+}
+
+int file_priorite_extraire_min(FilePriorite *f, int *cle) {
+    if (!f || f->taille == 0) return -1;
+    INSTR_COMPTER(STAT_TAS_EXTRACTIONS, 1);
+    int v = f->tas[0];
+    if (cle) *cle = f->cle[v];
+    f->pos[v] = -1;
+    f->taille--;
+    if (f->taille > 0) {
+        placer(f, 0, f->tas[f->taille]);
+        descendre(f, 0);
+    }
+    return v;
+}
@@ -0,0 +1,30 @@
+/* FilePriorite.h */
+#ifndef FILE_PRIORITE_H
+#define FILE_PRIORITE_H
+
+/* Indexed 4-ary min-heap on vertices 0 .. capacite-1, with decrease-key.
+   Ties on the key are broken by the smallest vertex, so extraction order
+   is fully deterministic. */
+
+typedef struct {
+    int taille;    /* number of vertices currently in the heap */
+    int capacite;  /* vertices are numbered from 0 to capacite-1 */
+    int *tas;      /* tas[i] = vertex stored at heap position i */
+    int *pos;      /* pos[v] = position of v in tas, -1 if absent */
+    int *cle;      /* cle[v] = current key of v (valid while v is present) */
+} FilePriorite;
+
+/* Creation / destruction */
+FilePriorite *file_priorite_creer(int capacite);
+void file_priorite_detruire(FilePriorite *f);
+void file_priorite_vider(FilePriorite *f); /* O(taille), keeps the buffers */
+
+/* Operations */
+int  file_priorite_est_vide(const FilePriorite *f);
+int  file_priorite_contient(const FilePriorite *f, int v);
+void file_priorite_inserer(FilePriorite *f, int v, int cle);      /* or decrease if present */
+void file_priorite_diminuer_cle(FilePriorite *f, int v, int cle); /* ignored if not smaller */
+int  file_priorite_min(const FilePriorite *f);                    /* -1 if empty */
+int  file_priorite_extraire_min(FilePriorite *f, int *cle);       /* -1 if empty */
+
+#endif /* FILE_PRIORITE_H */
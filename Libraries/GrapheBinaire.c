@@ -0,0 +1,396 @@
+/* GrapheBinaire.c */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "GrapheBinaire.h"
+#include "Octets.h"
+
+#ifdef _WIN32
+#define BINAIRE_SANS_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+#define TAILLE_ENTETE 64
+#define ALIGNEMENT    64
+#define TAILLE_TAMPON 4096
+
+static const char MAGIE[8] = { 'G', 'R', 'A', 'P', 'H', 'E', 'B', '\0' };
+
+static int hote_little_endian(void) {
+    const uint16_t x = 1;
+    return *(const unsigned char *)&x == 1;
+}
+
+static uint64_t aligner(uint64_t x) {
+    return (x + ALIGNEMENT - 1) / ALIGNEMENT * ALIGNEMENT;
+}
+
+/* ---------- Writing ---------- */
+
+/* Any of the graph types seen as rows of (destination, weight) */
+typedef struct {
+    const void *g;
+    int nb_sommets;
+    int oriente;
+    int value;
+    int (*degre)(const void *g, int v);
+    int (*ligne)(const void *g, int v, int *dest, int *poids); /* row length; poids may be NULL */
+} SourceBinaire;
+
+typedef struct {
+    FILE *f;
+    uint64_t position;
+    unsigned char octets[TAILLE_TAMPON * 4];
+    int ok;
+} Ecrivain;
+
+static void ecrire_octets(Ecrivain *e, const void *p, size_t n) {
+    if (e->ok && n && fwrite(p, 1, n, e->f) != n) e->ok = 0;
+    e->position += n;
+}
+
+static void completer(Ecrivain *e, uint64_t position) {
+    static const unsigned char zeros[ALIGNEMENT] = { 0 };
+    while (e->position < position) {
+        uint64_t n = position - e->position;
+        ecrire_octets(e, zeros, n < ALIGNEMENT ? (size_t)n : ALIGNEMENT);
+    }
+}
+
+/* int32 values, converted to little-endian if needed */
+static void ecrire_entiers(Ecrivain *e, const int *t, size_t n) {
+    if (hote_little_endian()) {
+        ecrire_octets(e, t, n * sizeof(int32_t));
+        return;
+    }
+    while (n > 0) {
+        size_t k = n < TAILLE_TAMPON ? n : TAILLE_TAMPON;
+        for (size_t i = 0; i < k; ++i) octets_poser_u32(e->octets + 4 * i, (uint32_t)t[i]);
+        ecrire_octets(e, e->octets, 4 * k);
+        t += k;
+        n -= k;
+    }
+}
+
+static int ecrire(const SourceBinaire *s, const char *chemin) {
+    if (!s->g || !chemin) return 0;
+    int n = s->nb_sommets;
+
+    long long m = 0;
+    int degre_max = 0;
+    for (int v = 0; v < n; ++v) {
+        int d = s->degre(s->g, v);
+        m += d;
+        if (d > degre_max) degre_max = d;
+    }
+    if (m > 2147483647LL) return 0;
+
+    uint64_t off_debut = TAILLE_ENTETE;
+    uint64_t off_dest = aligner(off_debut + 4 * ((uint64_t)n + 1));
+    uint64_t off_poids = s->value ? aligner(off_dest + 4 * (uint64_t)m) : 0;
+    uint64_t taille = s->value ? off_poids + 4 * (uint64_t)m : off_dest + 4 * (uint64_t)m;
+
+    unsigned char entete[TAILLE_ENTETE];
+    memset(entete, 0, sizeof entete);
+    memcpy(entete, MAGIE, 8);
+    octets_poser_u32(entete + 8, GRAPHE_BINAIRE_VERSION);
+    octets_poser_u32(entete + 12, (s->oriente ? 1u : 0u) | (s->value ? 2u : 0u));
+    octets_poser_u64(entete + 16, (uint64_t)n);
+    octets_poser_u64(entete + 24, (uint64_t)m);
+    octets_poser_u64(entete + 32, off_debut);
+    octets_poser_u64(entete + 40, off_dest);
+    octets_poser_u64(entete + 48, off_poids);
+    octets_poser_u64(entete + 56, taille);
+
+    Ecrivain *e = (Ecrivain *)malloc(sizeof(Ecrivain));
+    int *dest = (int *)malloc(((size_t)degre_max + 1) * sizeof(int));
+    int *poids = (int *)malloc(((size_t)degre_max + 1) * sizeof(int));
+    if (!e || !dest || !poids || !(e->f = fopen(chemin, "wb"))) {
+        free(e);
+        free(dest);
+        free(poids);
+        return 0;
+    }
+    e->position = 0;
+    e->ok = 1;
+    ecrire_octets(e, entete, sizeof entete);
+
+    /* offsets, a buffer at a time */
+    int cumul = 0, k = 0;
+    for (int v = 0; v <= n; ++v) {
+        dest[k++] = cumul;
+        if (v < n) cumul += s->degre(s->g, v);
+        if (k == degre_max + 1 || v == n) {
+            ecrire_entiers(e, dest, k);
+            k = 0;
+        }
+    }
+
+    completer(e, off_dest);
+    for (int v = 0; v < n; ++v) {
+        ecrire_entiers(e, dest, s->ligne(s->g, v, dest, NULL));
+    }
+    if (s->value) {
+        completer(e, off_poids);
+        for (int v = 0; v < n; ++v) {
+            ecrire_entiers(e, poids, s->ligne(s->g, v, dest, poids));
+        }
+    }
+
+    int ok = e->ok && e->position == taille;
+    if (fclose(e->f) != 0) ok = 0;
+    free(e);
+    free(dest);
+    free(poids);
+    if (!ok) remove(chemin);
+    return ok;
+}
+
+static int degre_liste(const void *g, int v) {
+    return graphe_liste_degre_sortant((const GrapheListe *)g, v);
+}
+
+static int ligne_liste(const void *g, int v, int *dest, int *poids) {
+    (void)poids;
+    int k = 0;
+    for (ArcListe *a = graphe_liste_voisins((const GrapheListe *)g, v); a; a = a->suivant)
+        dest[k++] = a->dest;
+    return k;
+}
+
+static int degre_value_liste(const void *g, int v) {
+    return graphe_value_liste_degre_sortant((const GrapheValueListe *)g, v);
+}
+
+static int ligne_value_liste(const void *g, int v, int *dest, int *poids) {
+    int k = 0;
+    for (ArcValueListe *a = graphe_value_liste_voisins((const GrapheValueListe *)g, v); a; a = a->suivant) {
+        dest[k] = a->dest;
+        if (poids) poids[k] = a->poids;
+        k++;
+    }
+    return k;
+}
+
+static int degre_matrice(const void *g, int v) {
+    return graphe_matrice_degre_sortant((const GrapheMatrice *)g, v);
+}
+
+static int ligne_matrice(const void *g, int v, int *dest, int *poids) {
+    (void)poids;
+    int k = 0;
+    for (int u = graphe_matrice_voisin_suivant((const GrapheMatrice *)g, v, -1); u >= 0;
+         u = graphe_matrice_voisin_suivant((const GrapheMatrice *)g, v, u))
+        dest[k++] = u;
+    return k;
+}
+
+static int degre_value_matrice(const void *g, int v) {
+    return graphe_value_matrice_degre_sortant((const GrapheValueMatrice *)g, v);
+}
+
+static int ligne_value_matrice(const void *g, int v, int *dest, int *poids) {
+    const GrapheValueMatrice *m = (const GrapheValueMatrice *)g;
+    int n = graphe_value_matrice_ordre(m), k = 0;
+    for (int u = 0; u < n; ++u) {
+        if (!graphe_value_matrice_existe_arc(m, v, u)) continue;
+        dest[k] = u;
+        if (poids) poids[k] = graphe_value_matrice_obtenir_poids(m, v, u);
+        k++;
+    }
+    return k;
+}
+
+static int degre_csr(const void *g, int v) {
+    return graphe_csr_degre_sortant((const GrapheCSR *)g, v);
+}
+
+static int ligne_csr(const void *g, int v, int *dest, int *poids) {
+    const GrapheCSR *c = (const GrapheCSR *)g;
+    int d = c->debut[v + 1] - c->debut[v];
+    memcpy(dest, c->dest + c->debut[v], d * sizeof(int));
+    if (poids && c->poids) memcpy(poids, c->poids + c->debut[v], d * sizeof(int));
+    return d;
+}
+
+/* ---------- Reading ---------- */
+
+typedef struct {
+    void *adresse;
+    size_t taille;
+} Projection;
+
+static void liberer_projection(void *ressource) {
+    Projection *p = (Projection *)ressource;
+    if (!p) return;
+#ifndef BINAIRE_SANS_MMAP
+    munmap(p->adresse, p->taille);
+#else
+    free(p->adresse);
+#endif
+    free(p);
+}
+
+/* Whole file in memory: mapped when possible, read otherwise */
+static Projection *projeter(const char *chemin) {
+    Projection *p = (Projection *)malloc(sizeof(Projection));
+    if (!p) return NULL;
+#ifndef BINAIRE_SANS_MMAP
+    int fd = open(chemin, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < TAILLE_ENTETE) {
+        if (fd >= 0) close(fd);
+        free(p);
+        return NULL;
+    }
+    p->taille = (size_t)st.st_size;
+    p->adresse = mmap(NULL, p->taille, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p->adresse == MAP_FAILED) {
+        free(p);
+        return NULL;
+    }
+#else
+    FILE *f = fopen(chemin, "rb");
+    long taille = -1;
+    if (f && fseek(f, 0, SEEK_END) == 0) taille = ftell(f);
+    if (!f || taille < TAILLE_ENTETE) {
+        if (f) fclose(f);
+        free(p);
+        return NULL;
+    }
+    rewind(f);
+    p->taille = (size_t)taille;
+    p->adresse = malloc(p->taille);
+    if (!p->adresse || fread(p->adresse, 1, p->taille, f) != p->taille) {
+        fclose(f);
+        free(p->adresse);
+        free(p);
+        return NULL;
+    }
+    fclose(f);
+#endif
+    return p;
+}
+
+static int verifier_contenu(const GrapheCSR *g) {
+    if (g->debut[0] != 0 || g->debut[g->nb_sommets] != g->nb_arcs) return 0;
+    for (int v = 0; v < g->nb_sommets; ++v)
+        if (g->debut[v + 1] < g->debut[v]) return 0;
+    for (int k = 0; k < g->nb_arcs; ++k)
+        if (g->dest[k] < 0 || g->dest[k] >= g->nb_sommets) return 0;
+    return 1;
+}
+
+static int *copier_entiers(const unsigned char *p, size_t n) {
+    int *t = (int *)malloc((n ? n : 1) * sizeof(int));
+    if (!t) return NULL;
+    for (size_t i = 0; i < n; ++i) t[i] = (int)octets_lire_u32(p + 4 * i);
+    return t;
+}
+
+/* [off, off + longueur) inside the file, without overflowing on a
+   hostile offset (longueur is at most 4 * 2^31 here) */
+static int section_valide(uint64_t off, uint64_t longueur, uint64_t taille) {
+    return off <= taille && longueur <= taille - off;
+}
+
+GrapheCSR *graphe_binaire_ouvrir(const char *chemin, int verifier) {
+    if (!chemin) return NULL;
+    Projection *p = projeter(chemin);
+    if (!p) return NULL;
+    const unsigned char *o = (const unsigned char *)p->adresse;
+
+    uint32_t drapeaux = octets_lire_u32(o + 12);
+    uint64_t n = octets_lire_u64(o + 16), m = octets_lire_u64(o + 24);
+    uint64_t off_debut = octets_lire_u64(o + 32), off_dest = octets_lire_u64(o + 40);
+    uint64_t off_poids = octets_lire_u64(o + 48), taille = octets_lire_u64(o + 56);
+    int value = (drapeaux & 2u) != 0;
+    int valide = memcmp(o, MAGIE, 8) == 0 && octets_lire_u32(o + 8) == GRAPHE_BINAIRE_VERSION &&
+                 taille == p->taille && n < 2147483647ULL && m <= 2147483647ULL &&
+                 off_debut % ALIGNEMENT == 0 && off_dest % ALIGNEMENT == 0 &&
+                 off_poids % ALIGNEMENT == 0 && off_debut >= TAILLE_ENTETE &&
+                 section_valide(off_debut, 4 * (n + 1), taille) &&
+                 section_valide(off_dest, 4 * m, taille) &&
+                 off_debut + 4 * (n + 1) <= off_dest &&
+                 (value ? section_valide(off_poids, 4 * m, taille) && off_poids >= off_dest + 4 * m
+                        : off_poids == 0);
+    GrapheCSR *g = valide ? (GrapheCSR *)malloc(sizeof(GrapheCSR)) : NULL;
+    if (!g) {
+        liberer_projection(p);
+        return NULL;
+    }
+    g->nb_sommets = (int)n;
+    g->nb_arcs = (int)m;
+    g->oriente = (drapeaux & 1u) != 0;
+
+#ifndef BINAIRE_SANS_MMAP
+    if (hote_little_endian()) {
+        /* zero copy: the sections are aligned, point straight into the mapping */
+        g->debut = (int *)(void *)(o + off_debut);
+        g->dest = (int *)(void *)(o + off_dest);
+        g->poids = value ? (int *)(void *)(o + off_poids) : NULL;
+        g->liberer = liberer_projection;
+        g->ressource = p;
+        if (verifier && !verifier_contenu(g)) {
+            graphe_csr_detruire(g);
+            return NULL;
+        }
+        return g;
+    }
+#endif
+
+    /* copy, converting from little-endian */
+    g->debut = copier_entiers(o + off_debut, (size_t)n + 1);
+    g->dest = copier_entiers(o + off_dest, (size_t)m);
+    g->poids = value ? copier_entiers(o + off_poids, (size_t)m) : NULL;
+    g->liberer = NULL;
+    g->ressource = NULL;
+    liberer_projection(p);
+    if (!g->debut || !g->dest || (value && !g->poids) || (verifier && !verifier_contenu(g))) {
+        graphe_csr_detruire(g);
+        return NULL;
+    }
+    return g;
+}
+
+/* PUBLIC API (writers) */
+
+int graphe_binaire_ecrire_liste(const GrapheListe *g, const char *chemin) {
+    SourceBinaire s = { g, graphe_liste_ordre(g), graphe_liste_est_oriente(g), 0,
+                        degre_liste, ligne_liste };
+    return ecrire(&s, chemin);
+}
+
+int graphe_binaire_ecrire_value_liste(const GrapheValueListe *g, const char *chemin) {
+    SourceBinaire s = { g, graphe_value_liste_ordre(g), graphe_value_liste_est_oriente(g), 1,
+                        degre_value_liste, ligne_value_liste };
+    return ecrire(&s, chemin);
+}
+
+int graphe_binaire_ecrire_matrice(const GrapheMatrice *g, const char *chemin) {
+    SourceBinaire s = { g, graphe_matrice_ordre(g), graphe_matrice_est_oriente(g), 0,
+                        degre_matrice, ligne_matrice };
+    return ecrire(&s, chemin);
+}
+
+int graphe_binaire_ecrire_value_matrice(const GrapheValueMatrice *g, const char *chemin) {
+    SourceBinaire s = { g, graphe_value_matrice_ordre(g), graphe_value_matrice_est_oriente(g), 1,
+                        degre_value_matrice, ligne_value_matrice };
+    return ecrire(&s, chemin);
+}
+
+int graphe_binaire_ecrire_csr(const GrapheCSR *g, const char *chemin) {
+    SourceBinaire s = { g, graphe_csr_ordre(g), graphe_csr_est_oriente(g), graphe_csr_est_value(g),
+                        degre_csr, ligne_csr };
+    return ecrire(&s, chemin);
+}
@@ -0,0 +1,43 @@
+/* GrapheBinaire.h */
+#ifndef GRAPHE_BINAIRE_H
+#define GRAPHE_BINAIRE_H
+
+#include "GrapheListe.h"
+#include "GrapheValueListe.h"
+#include "GrapheMatrice.h"
+#include "GrapheValueMatrice.h"
+#include "GrapheCSR.h"
+
+/* Binary graph files, laid out so that a mapped file is directly a CSR:
+
+     offset 0   header, 64 bytes, little-endian:
+                  char     magie[8]    "GRAPHEB\0"
+                  uint32   version     GRAPHE_BINAIRE_VERSION
+                  uint32   drapeaux    bit 0 = oriented, bit 1 = weighted
+                  int64    nb_sommets
+                  int64    nb_arcs
+                  uint64   offset of debut, dest and poids (0 = no weights)
+                  uint64   file size
+     then       int32 debut[nb_sommets + 1], int32 dest[nb_arcs],
+                int32 poids[nb_arcs], each section 64-byte aligned.
+
+   Rows hold the neighbors in the order of the graph they were written
+   from (list order, ascending for matrices). */
+
+#define GRAPHE_BINAIRE_VERSION 1
+
+/* Writers, 1 = ok */
+int graphe_binaire_ecrire_liste(const GrapheListe *g, const char *chemin);
+int graphe_binaire_ecrire_value_liste(const GrapheValueListe *g, const char *chemin);
+int graphe_binaire_ecrire_matrice(const GrapheMatrice *g, const char *chemin);
+int graphe_binaire_ecrire_value_matrice(const GrapheValueMatrice *g, const char *chemin);
+int graphe_binaire_ecrire_csr(const GrapheCSR *g, const char *chemin);
+
+/* Read-only view: the arrays of the returned snapshot point into the
+   mapped file, nothing is copied or parsed, and graphe_csr_detruire
+   unmaps it (hosts without mmap or big-endian ones get a copy).
+   Only the header is checked unless verifier is set, which also checks
+   the offsets and destinations in O(V+E). NULL if the file is invalid. */
+GrapheCSR *graphe_binaire_ouvrir(const char *chemin, int verifier);
+
+#endif /* GRAPHE_BINAIRE_H */
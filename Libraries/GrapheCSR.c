@@ -0,0 +1,198 @@
+/* GrapheCSR.c */
+#include <stdio.h>
+#include <stdlib.h>
+#include "GrapheCSR.h"
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+static GrapheCSR *allouer_csr(int nb_sommets, int nb_arcs, int oriente, int value) {
+    GrapheCSR *g = (GrapheCSR *)malloc(sizeof(GrapheCSR));
+    if (!g) return NULL;
+    g->nb_sommets = nb_sommets;
+    g->nb_arcs    = nb_arcs;
+    g->oriente    = oriente ? 1 : 0;
+    g->liberer    = NULL;
+    g->ressource  = NULL;
+    g->debut = (int *)malloc((nb_sommets + 1) * sizeof(int));
+    /* +1 so that an empty graph still gets a valid pointer */
+    g->dest  = (int *)malloc((nb_arcs + 1) * sizeof(int));
+    g->poids = value ? (int *)malloc((nb_arcs + 1) * sizeof(int)) : NULL;
+    if (!g->debut || !g->dest || (value && !g->poids)) {
+        graphe_csr_detruire(g);
+        return NULL;
+    }
+    return g;
+}
+
+/* PUBLIC API */
+
+GrapheCSR *graphe_csr_depuis_liste(const GrapheListe *g) {
+    if (!g) return NULL;
+    int n = graphe_liste_ordre(g);
+
+    /* 1) count arcs */
+    int m = 0;
+    for (int v = 0; v < n; ++v)
+        for (ArcListe *a = graphe_liste_voisins(g, v); a; a = a->suivant) m++;
+
+    GrapheCSR *c = allouer_csr(n, m, graphe_liste_est_oriente(g), 0);
+    if (!c) return NULL;
+
+    /* 2) copy lists in order */
+    int k = 0;
+    for (int v = 0; v < n; ++v) {
+        c->debut[v] = k;
+        for (ArcListe *a = graphe_liste_voisins(g, v); a; a = a->suivant)
+            c->dest[k++] = a->dest;
+    }
+    c->debut[n] = k;
+    return c;
+}
+
+GrapheCSR *graphe_csr_depuis_value_liste(const GrapheValueListe *g) {
+    if (!g) return NULL;
+    int n = graphe_value_liste_ordre(g);
+
+    int m = 0;
+    for (int v = 0; v < n; ++v)
+        for (ArcValueListe *a = graphe_value_liste_voisins(g, v); a; a = a->suivant) m++;
+
+    GrapheCSR *c = allouer_csr(n, m, graphe_value_liste_est_oriente(g), 1);
+    if (!c) return NULL;
+
+    int k = 0;
+    for (int v = 0; v < n; ++v) {
+        c->debut[v] = k;
+        for (ArcValueListe *a = graphe_value_liste_voisins(g, v); a; a = a->suivant) {
+            c->dest[k]  = a->dest;
+            c->poids[k] = a->poids;
+            k++;
+        }
+    }
+    c->debut[n] = k;
+    return c;
+}
+
+GrapheCSR *graphe_csr_depuis_arcs(int nb_sommets, int oriente, const int *src,
+                                  const int *dst, const int *poids, int nb_arcs) {
+    if (nb_sommets < 0 || nb_arcs < 0 || (nb_arcs > 0 && (!src || !dst))) return NULL;
+
+    /* same filtering as the list insertions */
+    long long m = 0;
+    for (int i = 0; i < nb_arcs; ++i) {
+        int u = src[i], v = dst[i];
+        if (u < 0 || v < 0 || u >= nb_sommets || v >= nb_sommets) continue;
+        if (poids && poids[i] <= 0) continue;
+        m += oriente ? 1 : 2;
+    }
+    if (m > 2147483647LL) return NULL;
+
+    GrapheCSR *c = allouer_csr(nb_sommets, (int)m, oriente, poids != NULL);
+    if (!c) return NULL;
+    for (int v = 0; v <= nb_sommets; ++v) c->debut[v] = 0;
+    for (int i = 0; i < nb_arcs; ++i) {
+        int u = src[i], v = dst[i];
+        if (u < 0 || v < 0 || u >= nb_sommets || v >= nb_sommets) continue;
+        if (poids && poids[i] <= 0) continue;
+        c->debut[u + 1]++;
+        if (!oriente) c->debut[v + 1]++;
+    }
+    for (int v = 0; v < nb_sommets; ++v) c->debut[v + 1] += c->debut[v];
+
+    /* fill each row from its end: the lists prepend, so the latest arc comes first */
+    int *pos = (int *)malloc(((size_t)nb_sommets + 1) * sizeof(int));
+    if (!pos) {
+        graphe_csr_detruire(c);
+        return NULL;
+    }
+    for (int v = 0; v < nb_sommets; ++v) pos[v] = c->debut[v + 1];
+    for (int i = 0; i < nb_arcs; ++i) {
+        int u = src[i], v = dst[i];
+        if (u < 0 || v < 0 || u >= nb_sommets || v >= nb_sommets) continue;
+        if (poids && poids[i] <= 0) continue;
+        int k = --pos[u];
+        c->dest[k] = v;
+        if (poids) c->poids[k] = poids[i];
+        if (!oriente) {
+            k = --pos[v];
+            c->dest[k] = u;
+            if (poids) c->poids[k] = poids[i];
+        }
+    }
+    free(pos);
+    return c;
+}
+
+/* Counting sort of the arcs by destination: sources of v end up in
+   increasing order, parallel arcs keep their relative order. */
+GrapheCSR *graphe_csr_transposer(const GrapheCSR *g) {
+    if (!g) return NULL;
+    int n = g->nb_sommets;
+    GrapheCSR *t = allouer_csr(n, g->nb_arcs, g->oriente, g->poids != NULL);
+    if (!t) return NULL;
+
+    for (int v = 0; v <= n; ++v) t->debut[v] = 0;
+    for (int k = 0; k < g->nb_arcs; ++k) t->debut[g->dest[k] + 1]++;
+    for (int v = 0; v < n; ++v) t->debut[v + 1] += t->debut[v];
+
+    int *pos = (int *)malloc((n + 1) * sizeof(int));
+    if (!pos) {
+        graphe_csr_detruire(t);
+        return NULL;
+    }
+    for (int v = 0; v < n; ++v) pos[v] = t->debut[v];
+    for (int u = 0; u < n; ++u) {
+        for (int k = g->debut[u]; k < g->debut[u + 1]; ++k) {
+            int p = pos[g->dest[k]]++;
+            t->dest[p] = u;
+            if (t->poids) t->poids[p] = g->poids[k];
+        }
+    }
+    free(pos);
+    return t;
+}
+
+void graphe_csr_detruire(GrapheCSR *g) {
+    if (!g) return;
+    if (g->liberer) {
+        g->liberer(g->ressource);
+    } else {
+        free(g->debut);
+        free(g->dest);
+        free(g->poids);
+    }
+    free(g);
+}
+
+int graphe_csr_ordre(const GrapheCSR *g) {
+    if (!g) return 0;
+    return g->nb_sommets;
+}
+
+int graphe_csr_nb_arcs(const GrapheCSR *g) {
+    if (!g) return 0;
+    return g->nb_arcs;
+}
+
+int graphe_csr_degre_sortant(const GrapheCSR *g, int v) {
+    if (!g || v < 0 || v >= g->nb_sommets) return 0;
+    return g->debut[v + 1] - g->debut[v];
+}
+
+int graphe_csr_est_oriente(const GrapheCSR *g) {
+    if (!g) return 0;
+    return g->oriente;
+}
+
+int graphe_csr_est_value(const GrapheCSR *g) {
+    if (!g) return 0;
+    return g->poids != NULL;
+}
+
+int graphe_csr_existe_arc(const GrapheCSR *g, int u, int v) {
+    if (!g) return 0;
+    if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return 0;
+    for (int k = g->debut[u]; k < g->debut[u + 1]; ++k)
+        if (g->dest[k] == v) return 1;
+    return 0;
+}
@@ -0,0 +1,44 @@
+/* GrapheCSR.h */
+#ifndef GRAPHE_CSR_H
+#define GRAPHE_CSR_H
+
+#include "GrapheListe.h"
+#include "GrapheValueListe.h"
+
+/* Read-only "compressed sparse row" snapshot of a list graph.
+   Neighbors of v are dest[debut[v]] .. dest[debut[v+1]-1], in the same
+   order as in the adjacency list the snapshot was built from.
+   poids is NULL when the snapshot comes from an unweighted graph. */
+
+typedef struct {
+    int nb_sommets;
+    int nb_arcs;    /* number of stored arcs (2 per edge if non oriented) */
+    int oriente;    /* 0 = non oriented, 1 = oriented */
+    int *debut;     /* nb_sommets + 1 offsets into dest / poids */
+    int *dest;      /* nb_arcs destinations */
+    int *poids;     /* nb_arcs weights, or NULL */
+    /* External storage (a mapped file, see GrapheBinaire): the arrays are
+       released by liberer(ressource) instead of free; NULL otherwise */
+    void (*liberer)(void *ressource);
+    void *ressource;
+} GrapheCSR;
+
+/* Creation / destruction (O(V+E)) */
+GrapheCSR *graphe_csr_depuis_liste(const GrapheListe *g);
+GrapheCSR *graphe_csr_depuis_value_liste(const GrapheValueListe *g);
+GrapheCSR *graphe_csr_transposer(const GrapheCSR *g); /* reverse of every arc */
+/* Straight from arc arrays (poids may be NULL), neighbors in the order
+   graphe_csr_depuis_liste would give after the same insertions */
+GrapheCSR *graphe_csr_depuis_arcs(int nb_sommets, int oriente, const int *src,
+                                  const int *dst, const int *poids, int nb_arcs);
+void graphe_csr_detruire(GrapheCSR *g);
+
+/* Info */
+int graphe_csr_ordre(const GrapheCSR *g);
+int graphe_csr_nb_arcs(const GrapheCSR *g);
+int graphe_csr_degre_sortant(const GrapheCSR *g, int v);
+int graphe_csr_est_oriente(const GrapheCSR *g);
+int graphe_csr_est_value(const GrapheCSR *g);
+int graphe_csr_existe_arc(const GrapheCSR *g, int u, int v);
+
+#endif /* GRAPHE_CSR_H */
@@ -2,6 +2,10 @@
 #ifndef GRAPHE_LISTE_H
 #define GRAPHE_LISTE_H
 
+#include "PoolArcs.h"
+#include "IndexVoisins.h"
+#include "UnionFind.h"
+
 /* Node in adjacency list */
 typedef struct ArcListe {
     int dest;
@@ -13,20 +17,77 @@ typedef struct {
     int capacite;
     int oriente;    /* 0 = non oriented, 1 = oriented */
     ArcListe **adj; /* adj[i] = list of neighbors of i */
+    PoolArcs pool;  /* every ArcListe node of the graph comes from here */
+    /* Optional predecessor tracking (NULL when disabled) */
+    int *deg_entrant; /* deg_entrant[i] = number of arcs ending at i */
+    ArcListe **pred;  /* pred[i] = list of sources of arcs ending at i
+                         (oriented graphs only, adj is its own reverse otherwise) */
+    /* Hash index of the long lists (NULL until one is needed): index[i] is
+       built once a lookup walks past INDEX_VOISINS_SEUIL nodes of adj[i] */
+    IndexVoisins **index;
+    /* Stable ids (NULL until enabled, see below) */
+    int *id_externe;  /* id_externe[i] = id of vertex i, -1 for a removed vertex */
+    int *interne;     /* interne[id] = current index of vertex id, -1 once removed */
+    int nb_ids;       /* ids handed out so far */
+    int capacite_ids;
+    int nb_supprimes; /* removed vertices still holding an index */
+    /* Incremental connectivity (NULL until enabled) */
+    UnionFind *connexite;
+    int connexite_perimee; /* 1 = an arc was deleted, rebuild before use */
 } GrapheListe;
 
+/* One arc of a batch */
+typedef struct {
+    int u;
+    int v;
+} CoupleArc;
+
 /* Creation / destruction */
 GrapheListe *graphe_liste_creer(int capacite_initiale, int oriente);
 void graphe_liste_detruire(GrapheListe *g);
 
+/* Bulk construction: nb_sommets vertices and the arcs src[i] -> dst[i],
+   giving the same lists as graphe_liste_ajouter_arc called in array
+   order (invalid arcs skipped), but with every list contiguous */
+GrapheListe *graphe_liste_depuis_arcs(int nb_sommets, int oriente,
+                                      const int *src, const int *dst, int nb_arcs);
+
 /* Vertices */
 int  graphe_liste_ajouter_sommet(GrapheListe *g);
+/* The last vertex takes the index of v. With the predecessors enabled
+   only the lists of v, last and their neighbors are touched, but each
+   neighbor list of last is walked to rename it: O(sum of the degrees of
+   the neighbors of v and last). Otherwise every list is scanned (O(V+E)). */
 void graphe_liste_supprimer_sommet(GrapheListe *g, int v);
 
+/* Lazy removal with stable ids. Once enabled (predecessors are enabled
+   too), every vertex has an id that never changes: the current index
+   at activation, then the next unused id for each new vertex.
+   supprimer_sommet_differe only drops the arcs of v and marks it
+   removed; the removed vertices keep their index (isolated, counted by
+   the order) until compacter_sommets renumbers the others in O(V+E),
+   order kept, which happens by itself once a quarter of the indices
+   are removed: O(1 + E/V) per removal amortized, against the neighbor
+   list walks of supprimer_sommet on high degree neighborhoods. Indices
+   are only stable between two compactions, ids always are. */
+int  graphe_liste_activer_ids_stables(GrapheListe *g); /* 1 = ok */
+void graphe_liste_supprimer_sommet_differe(GrapheListe *g, int v);
+int  graphe_liste_compacter_sommets(GrapheListe *g); /* vertices dropped */
+int  graphe_liste_est_supprime(const GrapheListe *g, int v);
+int  graphe_liste_id_sommet(const GrapheListe *g, int v);   /* -1 if removed */
+int  graphe_liste_sommet_id(const GrapheListe *g, int id);  /* current index, -1 if removed */
+
 /* Edges / arcs */
 void graphe_liste_ajouter_arc(GrapheListe *g, int u, int v);
 void graphe_liste_supprimer_arc(GrapheListe *g, int u, int v);
 int  graphe_liste_existe_arc(GrapheListe *g, int u, int v);
+/* Batch insertion without duplicates: the arcs are grouped by source
+   (counting sort), arcs repeated in the batch or already in the graph
+   are dropped and the new ones are prepended in one pass per list.
+   (u, v) and (v, u) are the same edge in a non oriented graph.
+   Returns the number of arcs (edges if non oriented) added, -1 if out
+   of memory. O(V + nb_arcs + degrees of the sources touched). */
+int  graphe_liste_ajouter_arcs(GrapheListe *g, const CoupleArc *arcs, int nb_arcs);
 
 /* Info */
 int graphe_liste_ordre(const GrapheListe *g);
@@ -38,4 +99,29 @@ int graphe_liste_est_oriente(const GrapheListe *g);
 /* Helper to iterate neighbors */
 ArcListe *graphe_liste_voisins(const GrapheListe *g, int v);
 
+/* Predecessors: once enabled, in-degree counters and reverse lists are
+   kept up to date by every modification, so graphe_liste_degre_entrant
+   is O(1) and predecessors are iterated in O(in-degree). */
+int  graphe_liste_activer_predecesseurs(GrapheListe *g); /* 1 = ok */
+void graphe_liste_desactiver_predecesseurs(GrapheListe *g);
+int  graphe_liste_predecesseurs_actifs(const GrapheListe *g);
+ArcListe *graphe_liste_predecesseurs(const GrapheListe *g, int v); /* NULL if disabled */
+
+/* Incremental connectivity, arcs taken as edges: once enabled, every
+   insertion merges two components of a union-find (path compression,
+   union by rank), so the queries below are almost O(1). A deletion only
+   marks it stale; the next query rebuilds it in O(V+E). Removed vertices
+   (see supprimer_sommet_differe) are not counted. The graph is connected
+   (weakly if oriented) iff graphe_liste_nb_composantes <= 1. */
+int  graphe_liste_activer_connexite(GrapheListe *g); /* 1 = ok */
+void graphe_liste_desactiver_connexite(GrapheListe *g);
+int  graphe_liste_connexite_active(const GrapheListe *g);
+int  graphe_liste_nb_composantes(GrapheListe *g); /* -1 if disabled */
+int  graphe_liste_meme_composante(GrapheListe *g, int u, int v);
+
+/* Memory: rebuild every list contiguously (vertex by vertex, order kept)
+   and read the node allocation counters */
+int  graphe_liste_compacter(GrapheListe *g); /* 1 = ok */
+void graphe_liste_stats_allocation(const GrapheListe *g, StatsPool *stats);
+
 #endif /* GRAPHE_LISTE_H */
@@ -1,38 +1,80 @@
-
 /* GrapheMatrice.c */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "GrapheMatrice.h"
 
-static int **allouer_matrice(int n) {
-    int **m = (int **)malloc(n * sizeof(int *));
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+#define ALIGNEMENT     64 /* bytes, one cache line */
+#define MOTS_PAR_LIGNE_CACHE (ALIGNEMENT / (int)sizeof(uint64_t))
+
+#if defined(__GNUC__)
+#define POPCOUNT64(x) __builtin_popcountll(x)
+#define CTZ64(x)      __builtin_ctzll(x)
+#else
+static int POPCOUNT64(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+}
+static int CTZ64(uint64_t x) {
+    int n = 0;
+    while (!(x & 1)) { x >>= 1; n++; }
+    return n;
+}
+#endif
+
+#define MOT(j)  ((j) >> 6)
+#define BIT(j)  ((uint64_t)1 << ((j) & 63))
+
+static uint64_t *ligne(const GrapheMatrice *g, int i) {
+    return g->bits + (size_t)i * g->mots_par_ligne;
+}
+
+/* Number of words needed to hold n columns, rounded up to a cache line */
+static int mots_pour(int n) {
+    int mots = (n + 63) / 64;
+    return (mots + MOTS_PAR_LIGNE_CACHE - 1) / MOTS_PAR_LIGNE_CACHE * MOTS_PAR_LIGNE_CACHE;
+}
+
+/* Zeroed, 64-byte aligned block of n rows of 'mots' words */
+static uint64_t *allouer_matrice(int n, int mots) {
+    size_t taille = (size_t)n * mots * sizeof(uint64_t); /* multiple of ALIGNEMENT */
+#ifdef _WIN32
+    uint64_t *m = (uint64_t *)_aligned_malloc(taille, ALIGNEMENT);
+#else
+    uint64_t *m = (uint64_t *)aligned_alloc(ALIGNEMENT, taille);
+#endif
     if (!m) return NULL;
-    for (int i = 0; i < n; ++i) {
-        m[i] = (int *)calloc(n, sizeof(int));
-        if (!m[i]) {
-            for (int j = 0; j < i; ++j) free(m[j]);
-            free(m);
-            return NULL;
-        }
-    }
+    memset(m, 0, taille);
     return m;
 }
 
-static void liberer_matrice(int **m, int n) {
-    if (!m) return;
-    for (int i = 0; i < n; ++i) free(m[i]);
+static void liberer_matrice(uint64_t *m) {
+#ifdef _WIN32
+    _aligned_free(m);
+#else
     free(m);
+#endif
 }
 
 static int redimensionner(GrapheMatrice *g, int nouvelle_capacite) {
-    int **nouvelle = allouer_matrice(nouvelle_capacite);
+    int mots = mots_pour(nouvelle_capacite);
+    uint64_t *nouvelle = allouer_matrice(nouvelle_capacite, mots);
     if (!nouvelle) return 0;
     for (int i = 0; i < g->nb_sommets; ++i)
-        for (int j = 0; j < g->nb_sommets; ++j)
-            nouvelle[i][j] = g->adj[i][j];
-    liberer_matrice(g->adj, g->capacite);
-    g->adj = nouvelle;
+        memcpy(nouvelle + (size_t)i * mots, ligne(g, i), g->mots_par_ligne * sizeof(uint64_t));
+    liberer_matrice(g->bits);
+    g->bits = nouvelle;
     g->capacite = nouvelle_capacite;
+    g->mots_par_ligne = mots;
     return 1;
 }
 
@@ -43,8 +85,9 @@ GrapheMatrice *graphe_matrice_creer(int capacite_initiale, int oriente) {
     if (!g) return NULL;
     if (capacite_initiale <= 0) capacite_initiale = 1;
 
-    g->adj = allouer_matrice(capacite_initiale);
-    if (!g->adj) {
+    g->mots_par_ligne = mots_pour(capacite_initiale);
+    g->bits = allouer_matrice(capacite_initiale, g->mots_par_ligne);
+    if (!g->bits) {
         free(g);
         return NULL;
     }
@@ -56,7 +99,7 @@ GrapheMatrice *graphe_matrice_creer(int capacite_initiale, int oriente) {
 
 void graphe_matrice_detruire(GrapheMatrice *g) {
     if (!g) return;
-    liberer_matrice(g->adj, g->capacite);
+    liberer_matrice(g->bits);
     free(g);
 }
 
@@ -68,7 +111,8 @@ int graphe_matrice_ajouter_sommet(GrapheMatrice *g) {
     }
     int v = g->nb_sommets;
     g->nb_sommets++;
-    /* New row/column already initialized to 0 by calloc/redimensionner */
+    /* New row/column already 0: rows are zeroed on allocation and
+       removed vertices are cleared */
     return v;
 }
 
@@ -77,20 +121,22 @@ void graphe_matrice_supprimer_sommet(GrapheMatrice *g, int v) {
     if (v < 0 || v >= g->nb_sommets) return;
 
     int last = g->nb_sommets - 1;
+    int mots = MOT(last) + 1; /* words actually used by a row */
     if (v != last) {
         /* Move last row into row v */
-        for (int j = 0; j < g->nb_sommets; ++j)
-            g->adj[v][j] = g->adj[last][j];
+        memcpy(ligne(g, v), ligne(g, last), mots * sizeof(uint64_t));
         /* Move last column into column v */
-        for (int i = 0; i < g->nb_sommets; ++i)
-            g->adj[i][v] = g->adj[i][last];
+        for (int i = 0; i < g->nb_sommets; ++i) {
+            uint64_t *l = ligne(g, i);
+            if (l[MOT(last)] & BIT(last)) l[MOT(v)] |= BIT(v);
+            else l[MOT(v)] &= ~BIT(v);
+        }
     }
 
-    /* Clear last row/col (optional) */
-    for (int j = 0; j < g->nb_sommets; ++j) {
-        g->adj[last][j] = 0;
-        g->adj[j][last] = 0;
-    }
+    /* Clear last row/col so the new vertex of a later insertion starts empty */
+    memset(ligne(g, last), 0, mots * sizeof(uint64_t));
+    for (int i = 0; i < g->nb_sommets; ++i)
+        ligne(g, i)[MOT(last)] &= ~BIT(last);
 
     g->nb_sommets--;
 }
@@ -98,23 +144,23 @@ void graphe_matrice_supprimer_sommet(GrapheMatrice *g, int v) {
 void graphe_matrice_ajouter_arc(GrapheMatrice *g, int u, int v) {
     if (!g) return;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return;
-    g->adj[u][v] = 1;
+    ligne(g, u)[MOT(v)] |= BIT(v);
     if (!g->oriente)
-        g->adj[v][u] = 1;
+        ligne(g, v)[MOT(u)] |= BIT(u);
 }
 
 void graphe_matrice_supprimer_arc(GrapheMatrice *g, int u, int v) {
     if (!g) return;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return;
-    g->adj[u][v] = 0;
+    ligne(g, u)[MOT(v)] &= ~BIT(v);
     if (!g->oriente)
-        g->adj[v][u] = 0;
+        ligne(g, v)[MOT(u)] &= ~BIT(u);
 }
 
 int graphe_matrice_existe_arc(const GrapheMatrice *g, int u, int v) {
     if (!g) return 0;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return 0;
-    return g->adj[u][v] != 0;
+    return (ligne(g, u)[MOT(v)] & BIT(v)) != 0;
 }
 
 int graphe_matrice_ordre(const GrapheMatrice *g) {
@@ -124,18 +170,35 @@ int graphe_matrice_ordre(const GrapheMatrice *g) {
 
 int graphe_matrice_degre_sortant(const GrapheMatrice *g, int v) {
     if (!g || v < 0 || v >= g->nb_sommets) return 0;
+    const uint64_t *l = ligne(g, v);
+    int mots = MOT(g->nb_sommets - 1) + 1;
     int deg = 0;
-    for (int j = 0; j < g->nb_sommets; ++j)
-        if (g->adj[v][j]) deg++;
+    for (int k = 0; k < mots; ++k)
+        deg += POPCOUNT64(l[k]);
     return deg;
 }
 
 int graphe_matrice_degre_entrant(const GrapheMatrice *g, int v) {
     if (!g || v < 0 || v >= g->nb_sommets) return 0;
-    int deg = 0;
-    for (int i = 0; i < g->nb_sommets; ++i)
-        if (g->adj[i][v]) deg++;
-    return deg;
+    /* Symmetric matrix: the column is the row */
+    if (!g->oriente) return graphe_matrice_degre_sortant(g, v);
+
+    /* Branch-free column scan with 4 independent accumulators */
+    const uint64_t *p = g->bits + MOT(v);
+    size_t pas = (size_t)g->mots_par_ligne;
+    int decalage = v & 63;
+    int n = g->nb_sommets;
+    uint64_t d0 = 0, d1 = 0, d2 = 0, d3 = 0;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        d0 += (p[(size_t)i * pas] >> decalage) & 1;
+        d1 += (p[(size_t)(i + 1) * pas] >> decalage) & 1;
+        d2 += (p[(size_t)(i + 2) * pas] >> decalage) & 1;
+        d3 += (p[(size_t)(i + 3) * pas] >> decalage) & 1;
+    }
+    for (; i < n; ++i)
+        d0 += (p[(size_t)i * pas] >> decalage) & 1;
+    return (int)(d0 + d1 + d2 + d3);
 }
 
 int graphe_matrice_degre(const GrapheMatrice *g, int v) {
@@ -147,3 +210,20 @@ int graphe_matrice_est_oriente(const GrapheMatrice *g) {
     if (!g) return 0;
     return g->oriente;
 }
+
+int graphe_matrice_voisin_suivant(const GrapheMatrice *g, int v, int precedent) {
+    if (!g || v < 0 || v >= g->nb_sommets) return -1;
+    int j = precedent + 1;
+    if (j < 0) j = 0;
+    if (j >= g->nb_sommets) return -1;
+
+    const uint64_t *l = ligne(g, v);
+    int mots = MOT(g->nb_sommets - 1) + 1;
+    int k = MOT(j);
+    uint64_t mot = l[k] & (~(uint64_t)0 << (j & 63));
+    while (!mot) {
+        if (++k >= mots) return -1; /* skip whole zero words */
+        mot = l[k];
+    }
+    return k * 64 + CTZ64(mot);
+}
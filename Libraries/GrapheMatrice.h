@@ -3,14 +3,20 @@
 #ifndef GRAPHE_MATRICE_H
 #define GRAPHE_MATRICE_H
 
+#include <stdint.h>
+
 /* Graph represented by adjacency matrix (0/1).
-   Vertices are numbered from 0 to nb_sommets-1. */
+   Vertices are numbered from 0 to nb_sommets-1.
+   The matrix is bit-packed: one bit per arc, rows of mots_par_ligne 64-bit
+   words stored in a single 64-byte aligned block. Every row starts on a
+   cache line, and bits of columns >= nb_sommets are always 0. */
 
 typedef struct {
-    int nb_sommets;   /* current number of vertices (order) */
-    int capacite;     /* capacity of adjacency matrix */
-    int oriente;      /* 0 = non oriented, 1 = oriented */
-    int **adj;        /* adj[i][j] = 1 if edge i->j exists, 0 otherwise */
+    int nb_sommets;     /* current number of vertices (order) */
+    int capacite;       /* capacity of adjacency matrix */
+    int oriente;        /* 0 = non oriented, 1 = oriented */
+    int mots_par_ligne; /* row stride in 64-bit words (multiple of 8) */
+    uint64_t *bits;     /* bit j of row i = 1 if edge i->j exists */
 } GrapheMatrice;
 
 /* Creation / destruction */
@@ -33,4 +39,8 @@ int graphe_matrice_degre_entrant(const GrapheMatrice *g, int v);
 int graphe_matrice_degre(const GrapheMatrice *g, int v); /* for non-oriented */
 int graphe_matrice_est_oriente(const GrapheMatrice *g);
 
+/* Helper to iterate neighbors: smallest neighbor of v greater than
+   precedent (use -1 to start), or -1 when there is none. */
+int graphe_matrice_voisin_suivant(const GrapheMatrice *g, int v, int precedent);
+
 #endif /* GRAPHE_MATRICE_H */
@@ -1,11 +1,47 @@
 /* GrapheValueListe.c */
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include "GrapheValueListe.h"
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
 
 static int redimensionner(GrapheValueListe *g, int nouvelle_capacite) {
     ArcValueListe **nouveau = (ArcValueListe **)calloc(nouvelle_capacite, sizeof(ArcValueListe *));
     if (!nouveau) return 0;
+    if (g->deg_entrant) {
+        int *deg = (int *)realloc(g->deg_entrant, nouvelle_capacite * sizeof(int));
+        if (!deg) {
+            free(nouveau);
+            return 0;
+        }
+        g->deg_entrant = deg;
+    }
+    if (g->pred) {
+        ArcValueListe **pred = (ArcValueListe **)realloc(g->pred, nouvelle_capacite * sizeof(ArcValueListe *));
+        if (!pred) {
+            free(nouveau);
+            return 0;
+        }
+        g->pred = pred;
+    }
+    if (g->index) {
+        IndexVoisins **index = (IndexVoisins **)realloc(g->index, nouvelle_capacite * sizeof(IndexVoisins *));
+        if (!index) {
+            free(nouveau);
+            return 0;
+        }
+        for (int i = g->capacite; i < nouvelle_capacite; ++i) index[i] = NULL;
+        g->index = index;
+    }
+    if (g->id_externe) {
+        int *ids = (int *)realloc(g->id_externe, nouvelle_capacite * sizeof(int));
+        if (!ids) {
+            free(nouveau);
+            return 0;
+        }
+        g->id_externe = ids;
+    }
     for (int i = 0; i < g->nb_sommets; ++i)
         nouveau[i] = g->adj[i];
     free(g->adj);
@@ -14,22 +50,267 @@ static int redimensionner(GrapheValueListe *g, int nouvelle_capacite) {
     return 1;
 }
 
-static void supprimer_arc_une_direction(GrapheValueListe *g, int u, int v) {
-    if (!g) return;
-    if (u < 0 || u >= g->nb_sommets) return;
-    ArcValueListe *cur = g->adj[u];
+/* Unlink and recycle the first node of *tete going to dest (1 if found) */
+static int retirer_noeud(GrapheValueListe *g, ArcValueListe **tete, int dest) {
+    ArcValueListe *cur = *tete;
     ArcValueListe *prev = NULL;
 
     while (cur) {
-        if (cur->dest == v) {
+        if (cur->dest == dest) {
             if (prev) prev->suivant = cur->suivant;
-            else g->adj[u] = cur->suivant;
-            free(cur);
-            return;
+            else *tete = cur->suivant;
+            pool_arcs_liberer(&g->pool, cur);
+            return 1;
         }
         prev = cur;
         cur = cur->suivant;
     }
+    return 0;
+}
+
+/* ---------- Neighbor index ---------- */
+
+static ArcValueListe **resoudre_lien(GrapheValueListe *g, int u, const EntreeIndex *e) {
+    return e->lien ? (ArcValueListe **)e->lien : &g->adj[u];
+}
+
+static void oublier_index(GrapheValueListe *g, int u) {
+    if (!g->index || !g->index[u]) return;
+    index_voisins_detruire(g->index[u]);
+    g->index[u] = NULL;
+}
+
+/* Every node moved or every id changed */
+static void oublier_tous_les_index(GrapheValueListe *g) {
+    if (!g->index) return;
+    for (int v = 0; v < g->capacite; ++v) index_voisins_detruire(g->index[v]);
+    free(g->index);
+    g->index = NULL;
+}
+
+/* Index of adj[u] (about nb nodes); the list stays usable without it */
+static void construire_index(GrapheValueListe *g, int u, int nb) {
+    if (!g->index) {
+        g->index = (IndexVoisins **)calloc(g->capacite, sizeof(IndexVoisins *));
+        if (!g->index) return;
+    }
+    IndexVoisins *idx = index_voisins_creer(nb);
+    if (!idx) return;
+    for (ArcValueListe **lien = &g->adj[u]; *lien; lien = &(*lien)->suivant) {
+        EntreeIndex *e = index_voisins_inserer(idx, (*lien)->dest);
+        if (!e) {
+            index_voisins_detruire(idx);
+            return;
+        }
+        if (e->nb++ == 0) e->lien = lien == &g->adj[u] ? NULL : (ArcValueListe **)lien;
+        idx->nb_arcs++;
+    }
+    g->index[u] = idx;
+}
+
+/* Link to the first node of adj[u] going to v, NULL if none.
+   A walk past INDEX_VOISINS_SEUIL nodes indexes the list. */
+static ArcValueListe **chercher_lien(GrapheValueListe *g, int u, int v) {
+    if (g->index && g->index[u]) {
+        EntreeIndex *e = index_voisins_chercher(g->index[u], v);
+        return e ? resoudre_lien(g, u, e) : NULL;
+    }
+    int nb = 0;
+    ArcValueListe **trouve = NULL;
+    for (ArcValueListe **lien = &g->adj[u]; *lien; lien = &(*lien)->suivant) {
+        if ((*lien)->dest == v) {
+            trouve = lien;
+            break;
+        }
+        nb++;
+    }
+    if (nb >= INDEX_VOISINS_SEUIL) construire_index(g, u, nb);
+    return trouve;
+}
+
+/* A node was just pushed at the head of adj[u] */
+static void indexer_tete(GrapheValueListe *g, int u) {
+    IndexVoisins *idx = g->index ? g->index[u] : NULL;
+    if (!idx) return;
+    ArcValueListe *node = g->adj[u];
+    if (node->suivant) {
+        /* the former head is now reached through node->suivant */
+        EntreeIndex *ancienne = index_voisins_chercher(idx, node->suivant->dest);
+        if (ancienne && !ancienne->lien) ancienne->lien = &node->suivant;
+    }
+    EntreeIndex *e = index_voisins_inserer(idx, node->dest);
+    if (!e) {
+        oublier_index(g, u);
+        return;
+    }
+    e->lien = NULL;
+    e->nb++;
+    idx->nb_arcs++;
+}
+
+/* Unlink and recycle the first node of adj[u] going to v (1 if found) */
+static int retirer_voisin(GrapheValueListe *g, int u, int v) {
+    ArcValueListe **lien = chercher_lien(g, u, v); /* may index a long list */
+    if (!lien) return 0;
+    ArcValueListe *node = *lien;
+    IndexVoisins *idx = g->index ? g->index[u] : NULL;
+    if (!idx) {
+        *lien = node->suivant;
+        pool_arcs_liberer(&g->pool, node);
+        return 1;
+    }
+    EntreeIndex *e = index_voisins_chercher(idx, v);
+    *lien = node->suivant;
+    if (node->suivant) {
+        EntreeIndex *f = index_voisins_chercher(idx, node->suivant->dest);
+        if (f->lien == &node->suivant) f->lien = e->lien;
+    }
+    if (--e->nb == 0) {
+        index_voisins_retirer(idx, e);
+    } else {
+        /* parallel arcs: the next one is further down the list */
+        while ((*lien)->dest != v) lien = &(*lien)->suivant;
+        e->lien = lien == &g->adj[u] ? NULL : lien;
+    }
+    idx->nb_arcs--;
+    pool_arcs_liberer(&g->pool, node);
+    if (idx->nb_arcs < INDEX_VOISINS_SEUIL / 2) oublier_index(g, u);
+    return 1;
+}
+
+static void supprimer_arc_une_direction(GrapheValueListe *g, int u, int v) {
+    if (!g) return;
+    if (u < 0 || u >= g->nb_sommets) return;
+    if (!retirer_voisin(g, u, v)) return;
+    if (g->deg_entrant && v >= 0 && v < g->nb_sommets) {
+        g->deg_entrant[v]--;
+        if (g->pred) retirer_noeud(g, &g->pred[v], u);
+    }
+}
+
+/* ---------- Vertex removal ---------- */
+
+static int sommet_vivant(const GrapheValueListe *g, int v) {
+    return !g->id_externe || g->id_externe[v] >= 0;
+}
+
+/* Every arc out of and into v removed through the predecessor lists,
+   which the callers keep: the lists of v and of its neighbors only */
+static void detacher_sommet(GrapheValueListe *g, int v) {
+    while (g->adj[v]) graphe_value_liste_supprimer_arc(g, v, g->adj[v]->dest);
+    if (g->oriente)
+        while (g->pred[v]) graphe_value_liste_supprimer_arc(g, g->pred[v]->dest, v);
+}
+
+/* Arcs u -> ancien of adj[u] now go to nouveau, which u has no arc to */
+static void renommer_voisin(GrapheValueListe *g, int u, int ancien, int nouveau) {
+    ArcValueListe **lien = chercher_lien(g, u, ancien);
+    if (!lien) return;
+    IndexVoisins *idx = g->index ? g->index[u] : NULL;
+    EntreeIndex *e = idx ? index_voisins_chercher(idx, ancien) : NULL;
+    int nb = e ? e->nb : -1; /* unknown without index: up to the end */
+    for (ArcValueListe *a = *lien; a && nb != 0; a = a->suivant) {
+        if (a->dest == ancien) {
+            a->dest = nouveau;
+            nb--;
+        }
+    }
+    if (!e) return;
+    void *premier = e->lien;
+    int k = e->nb;
+    index_voisins_retirer(idx, e);
+    EntreeIndex *f = index_voisins_inserer(idx, nouveau);
+    if (!f) {
+        oublier_index(g, u);
+        return;
+    }
+    f->lien = premier;
+    f->nb = k;
+    idx->nb_arcs += k;
+}
+
+/* v has no arc left: last takes its index, which only touches the lists
+   of last's neighbors, but each of them is walked (up to its last arc
+   to last with an index, to its end otherwise): O(sum of their degrees).
+   The lazy removal never calls this, its compaction renames in one pass. */
+static void deplacer_dernier(GrapheValueListe *g, int v, int last) {
+    if (g->oriente) {
+        for (ArcValueListe *p = g->pred[last]; p; p = p->suivant)
+            renommer_voisin(g, p->dest, last, v);
+        for (ArcValueListe *a = g->adj[last]; a; a = a->suivant) {
+            int w = a->dest == v ? last : a->dest; /* loops were renamed just above */
+            for (ArcValueListe *r = g->pred[w]; r; r = r->suivant)
+                if (r->dest == last) r->dest = v;
+        }
+    } else {
+        renommer_voisin(g, last, last, v); /* loops */
+        for (ArcValueListe *a = g->adj[last]; a; a = a->suivant)
+            if (a->dest != v) renommer_voisin(g, a->dest, last, v);
+    }
+    oublier_index(g, v);
+    g->adj[v] = g->adj[last];
+    g->adj[last] = NULL;
+    if (g->pred) {
+        g->pred[v] = g->pred[last];
+        g->pred[last] = NULL;
+    }
+    g->deg_entrant[v] = g->deg_entrant[last];
+    if (g->index) {
+        g->index[v] = g->index[last];
+        g->index[last] = NULL;
+    }
+}
+
+/* Ids after v was removed and last moved to its index */
+static void oublier_id(GrapheValueListe *g, int v, int last) {
+    if (!g->id_externe) return;
+    if (g->id_externe[v] >= 0) g->interne[g->id_externe[v]] = -1;
+    else g->nb_supprimes--;
+    if (v == last) return;
+    g->id_externe[v] = g->id_externe[last];
+    if (g->id_externe[v] >= 0) g->interne[g->id_externe[v]] = v;
+}
+
+/* (Re)build deg_entrant and pred from adj. pred lists are filled in
+   increasing source order, parallel arcs in adjacency order. */
+static int construire_predecesseurs(GrapheValueListe *g) {
+    ArcValueListe **queue = NULL;
+    if (g->pred) {
+        queue = (ArcValueListe **)malloc(g->capacite * sizeof(ArcValueListe *));
+        if (!queue) return 0;
+    }
+    for (int v = 0; v < g->nb_sommets; ++v) {
+        g->deg_entrant[v] = 0;
+        if (g->pred) {
+            ArcValueListe *cur = g->pred[v];
+            while (cur) {
+                ArcValueListe *tmp = cur;
+                cur = cur->suivant;
+                pool_arcs_liberer(&g->pool, tmp);
+            }
+            g->pred[v] = NULL;
+            queue[v] = NULL;
+        }
+    }
+    for (int u = 0; u < g->nb_sommets; ++u) {
+        for (ArcValueListe *a = g->adj[u]; a; a = a->suivant) {
+            g->deg_entrant[a->dest]++;
+            if (!g->pred) continue;
+            ArcValueListe *node = (ArcValueListe *)pool_arcs_allouer(&g->pool);
+            if (!node) {
+                free(queue);
+                return 0;
+            }
+            node->dest = u;
+            node->poids = a->poids;
+            node->suivant = NULL;
+            if (queue[a->dest]) queue[a->dest]->suivant = node;
+            else g->pred[a->dest] = node;
+            queue[a->dest] = node;
+        }
+    }
+    free(queue);
+    return 1;
 }
 
 /* PUBLIC API */
@@ -47,23 +328,97 @@ GrapheValueListe *graphe_value_liste_creer(int capacite_initiale, int oriente) {
     g->nb_sommets = 0;
     g->capacite   = capacite_initiale;
     g->oriente    = oriente ? 1 : 0;
+    pool_arcs_init(&g->pool, sizeof(ArcValueListe));
+    g->deg_entrant = NULL;
+    g->pred       = NULL;
+    g->index      = NULL;
+    g->id_externe = NULL;
+    g->interne    = NULL;
+    g->nb_ids     = 0;
+    g->capacite_ids = 0;
+    g->nb_supprimes = 0;
     return g;
 }
 
 void graphe_value_liste_detruire(GrapheValueListe *g) {
     if (!g) return;
-    for (int i = 0; i < g->nb_sommets; ++i) {
-        ArcValueListe *cur = g->adj[i];
-        while (cur) {
-            ArcValueListe *tmp = cur;
-            cur = cur->suivant;
-            free(tmp);
-        }
-    }
+    pool_arcs_vider(&g->pool); /* one free per block, not per arc */
     free(g->adj);
+    free(g->deg_entrant);
+    free(g->pred);
+    oublier_tous_les_index(g);
+    free(g->id_externe);
+    free(g->interne);
     free(g);
 }
 
+static int arc_valide(int nb_sommets, int u, int v, int poids) {
+    return u >= 0 && v >= 0 && u < nb_sommets && v < nb_sommets && poids > 0;
+}
+
+GrapheValueListe *graphe_value_liste_depuis_arcs(int nb_sommets, int oriente, const int *src,
+                                                 const int *dst, const int *poids, int nb_arcs) {
+    if (nb_sommets < 0 || nb_arcs < 0 || (nb_arcs > 0 && (!src || !dst || !poids))) return NULL;
+    GrapheValueListe *g = graphe_value_liste_creer(nb_sommets, oriente);
+    if (!g) return NULL;
+    g->nb_sommets = nb_sommets;
+
+    /* counting sort by source, segments filled from their end (see GrapheListe) */
+    size_t *fin = (size_t *)calloc((size_t)nb_sommets + 1, sizeof(size_t));
+    if (!fin) {
+        graphe_value_liste_detruire(g);
+        return NULL;
+    }
+    for (int i = 0; i < nb_arcs; ++i) {
+        if (!arc_valide(nb_sommets, src[i], dst[i], poids[i])) continue;
+        fin[src[i] + 1]++;
+        if (!g->oriente) fin[dst[i] + 1]++;
+    }
+    for (int v = 0; v < nb_sommets; ++v) fin[v + 1] += fin[v];
+    size_t total = fin[nb_sommets];
+    for (int v = 0; v < nb_sommets; ++v) fin[v] = fin[v + 1];
+
+    int *dests = (int *)malloc((total ? total : 1) * sizeof(int));
+    int *valeurs = (int *)malloc((total ? total : 1) * sizeof(int));
+    if (!dests || !valeurs || !pool_arcs_reserver(&g->pool, total)) {
+        free(fin);
+        free(dests);
+        free(valeurs);
+        graphe_value_liste_detruire(g);
+        return NULL;
+    }
+    for (int i = 0; i < nb_arcs; ++i) {
+        int u = src[i], v = dst[i];
+        if (!arc_valide(nb_sommets, u, v, poids[i])) continue;
+        size_t k = --fin[u];
+        dests[k] = v;
+        valeurs[k] = poids[i];
+        if (!g->oriente) {
+            k = --fin[v];
+            dests[k] = u;
+            valeurs[k] = poids[i];
+        }
+    }
+
+    for (int v = 0; v < nb_sommets; ++v) {
+        size_t fin_v = v + 1 < nb_sommets ? fin[v + 1] : total;
+        ArcValueListe **lien = &g->adj[v];
+        for (size_t k = fin[v]; k < fin_v; ++k) {
+            ArcValueListe *node = (ArcValueListe *)pool_arcs_allouer(&g->pool);
+            node->dest = dests[k];
+            node->poids = valeurs[k];
+            *lien = node;
+            lien = &node->suivant;
+        }
+        *lien = NULL;
+    }
+
+    free(fin);
+    free(dests);
+    free(valeurs);
+    return g;
+}
+
 int graphe_value_liste_ajouter_sommet(GrapheValueListe *g) {
     if (!g) return -1;
     if (g->nb_sommets == g->capacite) {
@@ -71,23 +426,45 @@ int graphe_value_liste_ajouter_sommet(GrapheValueListe *g) {
         if (!redimensionner(g, nouvelle_cap)) return -1;
     }
     int v = g->nb_sommets;
+    if (g->id_externe) {
+        if (g->nb_ids == g->capacite_ids) {
+            int *interne = (int *)realloc(g->interne, 2 * (size_t)g->capacite_ids * sizeof(int));
+            if (!interne) return -1;
+            g->interne = interne;
+            g->capacite_ids *= 2;
+        }
+        g->id_externe[v] = g->nb_ids;
+        g->interne[g->nb_ids++] = v;
+    }
     g->nb_sommets++;
     g->adj[v] = NULL;
+    if (g->deg_entrant) g->deg_entrant[v] = 0;
+    if (g->pred) g->pred[v] = NULL;
     return v;
 }
 
 void graphe_value_liste_supprimer_sommet(GrapheValueListe *g, int v) {
     if (!g) return;
     if (v < 0 || v >= g->nb_sommets) return;
-
     int last = g->nb_sommets - 1;
 
+    if (g->deg_entrant) {
+        /* predecessors kept: only the arcs of v and last are touched */
+        detacher_sommet(g, v);
+        if (v != last) deplacer_dernier(g, v, last);
+        oublier_id(g, v, last);
+        g->nb_sommets--;
+        return;
+    }
+
+    oublier_tous_les_index(g); /* ids are remapped below */
+
     /* 1) remove all arcs from v */
     ArcValueListe *cur = g->adj[v];
     while (cur) {
         ArcValueListe *tmp = cur;
         cur = cur->suivant;
-        free(tmp);
+        pool_arcs_liberer(&g->pool, tmp);
     }
     g->adj[v] = NULL;
 
@@ -102,7 +479,7 @@ void graphe_value_liste_supprimer_sommet(GrapheValueListe *g, int v) {
                 if (prev) prev->suivant = node->suivant;
                 else g->adj[i] = node->suivant;
                 node = node->suivant;
-                free(tmp);
+                pool_arcs_liberer(&g->pool, tmp);
             } else {
                 if (node->dest == last) {
                     node->dest = v;
@@ -119,31 +496,328 @@ void graphe_value_liste_supprimer_sommet(GrapheValueListe *g, int v) {
         g->adj[last] = NULL;
     }
 
+    oublier_id(g, v, last);
     g->nb_sommets--;
 }
 
+int graphe_value_liste_activer_ids_stables(GrapheValueListe *g) {
+    if (!g) return 0;
+    if (g->id_externe) return 1;
+    if (!graphe_value_liste_activer_predecesseurs(g)) return 0;
+    int capacite_ids = g->nb_sommets > 0 ? g->nb_sommets : 1;
+    g->id_externe = (int *)malloc(g->capacite * sizeof(int));
+    g->interne = (int *)malloc(capacite_ids * sizeof(int));
+    if (!g->id_externe || !g->interne) {
+        free(g->id_externe);
+        free(g->interne);
+        g->id_externe = NULL;
+        g->interne = NULL;
+        return 0;
+    }
+    for (int v = 0; v < g->nb_sommets; ++v) {
+        g->id_externe[v] = v;
+        g->interne[v] = v;
+    }
+    g->nb_ids = g->nb_sommets;
+    g->capacite_ids = capacite_ids;
+    g->nb_supprimes = 0;
+    return 1;
+}
+
+void graphe_value_liste_supprimer_sommet_differe(GrapheValueListe *g, int v) {
+    if (!g || v < 0 || v >= g->nb_sommets) return;
+    if (!graphe_value_liste_activer_ids_stables(g) || g->id_externe[v] < 0) return;
+    /* they may have been disabled since the ids were */
+    if (!graphe_value_liste_activer_predecesseurs(g)) return;
+    detacher_sommet(g, v);
+    g->interne[g->id_externe[v]] = -1;
+    g->id_externe[v] = -1;
+    g->nb_supprimes++;
+    /* one O(V+E) pass per quarter of the indices removed */
+    if (4 * g->nb_supprimes >= g->nb_sommets) graphe_value_liste_compacter_sommets(g);
+}
+
+int graphe_value_liste_compacter_sommets(GrapheValueListe *g) {
+    if (!g || !g->id_externe || g->nb_supprimes == 0) return 0;
+    int n = g->nb_sommets;
+    int *nouveau = (int *)malloc(n * sizeof(int));
+    if (!nouveau) return 0;
+    int k = 0;
+    for (int v = 0; v < n; ++v) nouveau[v] = g->id_externe[v] >= 0 ? k++ : -1;
+
+    /* removed vertices have no arc left; survivors only move down */
+    oublier_tous_les_index(g);
+    for (int v = 0; v < n; ++v) {
+        int w = nouveau[v];
+        if (w < 0) continue;
+        for (ArcValueListe *a = g->adj[v]; a; a = a->suivant) a->dest = nouveau[a->dest];
+        g->adj[w] = g->adj[v];
+        if (g->pred) {
+            for (ArcValueListe *a = g->pred[v]; a; a = a->suivant) a->dest = nouveau[a->dest];
+            g->pred[w] = g->pred[v];
+        }
+        if (g->deg_entrant) g->deg_entrant[w] = g->deg_entrant[v];
+        g->id_externe[w] = g->id_externe[v];
+        g->interne[g->id_externe[w]] = w;
+    }
+    for (int v = k; v < n; ++v) {
+        g->adj[v] = NULL;
+        if (g->pred) g->pred[v] = NULL;
+    }
+    free(nouveau);
+    g->nb_sommets = k;
+    g->nb_supprimes = 0;
+    return n - k;
+}
+
+int graphe_value_liste_est_supprime(const GrapheValueListe *g, int v) {
+    if (!g || !g->id_externe || v < 0 || v >= g->nb_sommets) return 0;
+    return g->id_externe[v] < 0;
+}
+
+int graphe_value_liste_id_sommet(const GrapheValueListe *g, int v) {
+    if (!g || v < 0 || v >= g->nb_sommets) return -1;
+    return g->id_externe ? g->id_externe[v] : v;
+}
+
+int graphe_value_liste_sommet_id(const GrapheValueListe *g, int id) {
+    if (!g || id < 0) return -1;
+    if (!g->id_externe) return id < g->nb_sommets ? id : -1;
+    return id < g->nb_ids ? g->interne[id] : -1;
+}
+
 void graphe_value_liste_ajouter_arc(GrapheValueListe *g, int u, int v, int poids) {
     if (!g) return;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return;
     if (poids <= 0) return; /* assume strictly positive */
+    if (!sommet_vivant(g, u) || !sommet_vivant(g, v)) return;
+
+    /* both nodes allocated first, so that a failure leaves no half arc
+       and no in-degree counted for it */
+    int double_noeud = !g->oriente || g->pred;
+    ArcValueListe *node = (ArcValueListe *)pool_arcs_allouer(&g->pool);
+    ArcValueListe *node2 = node && double_noeud ? (ArcValueListe *)pool_arcs_allouer(&g->pool) : NULL;
+    if (!node || (double_noeud && !node2)) {
+        pool_arcs_liberer(&g->pool, node);
+        return;
+    }
 
     /* add u -> v */
-    ArcValueListe *node = (ArcValueListe *)malloc(sizeof(ArcValueListe));
-    if (!node) return;
     node->dest = v;
     node->poids = poids;
     node->suivant = g->adj[u];
     g->adj[u] = node;
+    indexer_tete(g, u);
+    if (g->deg_entrant) g->deg_entrant[v]++;
 
     if (!g->oriente) {
         /* add v -> u */
-        ArcValueListe *node2 = (ArcValueListe *)malloc(sizeof(ArcValueListe));
-        if (!node2) return;
         node2->dest = u;
         node2->poids = poids;
         node2->suivant = g->adj[v];
         g->adj[v] = node2;
+        indexer_tete(g, v);
+        if (g->deg_entrant) g->deg_entrant[u]++;
+    } else if (g->pred) {
+        /* record u as a predecessor of v */
+        node2->dest = u;
+        node2->poids = poids;
+        node2->suivant = g->pred[v];
+        g->pred[v] = node2;
+    }
+}
+
+/* ---------- Batch insertion ---------- */
+
+/* Weight b merged into a, a being the first occurrence */
+static int fusionner_poids(int a, int b, PolitiqueDoublons politique) {
+    if (politique == DOUBLONS_POIDS_MIN) return b < a ? b : a;
+    if (politique == DOUBLONS_SOMME) return a > INT_MAX - b ? INT_MAX : a + b;
+    return a;
+}
+
+/* Valid arcs of the batch grouped by source in input order, an edge of a
+   non oriented graph under its smaller end, then repeated destinations
+   of a group merged into their first occurrence. debut gets n+1 offsets
+   into dst / poids, marque (n entries) is left at -1. */
+static void grouper_arcs(const GrapheValueListe *g, const TripletArc *arcs, int nb_arcs,
+                         PolitiqueDoublons politique, size_t *debut, int *dst, int *poids,
+                         int *marque) {
+    int n = g->nb_sommets;
+    for (int i = 0; i < nb_arcs; ++i) {
+        const TripletArc *a = &arcs[i];
+        if (!arc_valide(n, a->u, a->v, a->poids) || !sommet_vivant(g, a->u) || !sommet_vivant(g, a->v))
+            continue;
+        debut[(!g->oriente && a->v < a->u ? a->v : a->u) + 1]++;
+    }
+    for (int v = 0; v < n; ++v) debut[v + 1] += debut[v];
+    for (int i = 0; i < nb_arcs; ++i) {
+        const TripletArc *a = &arcs[i];
+        if (!arc_valide(n, a->u, a->v, a->poids) || !sommet_vivant(g, a->u) || !sommet_vivant(g, a->v))
+            continue;
+        int x = a->u, y = a->v;
+        if (!g->oriente && y < x) {
+            x = a->v;
+            y = a->u;
+        }
+        size_t k = debut[x]++;
+        dst[k] = y;
+        poids[k] = a->poids;
+    }
+    for (int v = n; v > 0; --v) debut[v] = debut[v - 1];
+    debut[0] = 0;
+
+    size_t m = 0, lecture = 0;
+    for (int x = 0; x < n; ++x) {
+        size_t fin_x = debut[x + 1];
+        debut[x] = m;
+        for (size_t k = lecture; k < fin_x; ++k) {
+            int y = dst[k];
+            if (marque[y] >= 0) {
+                poids[marque[y]] = fusionner_poids(poids[marque[y]], poids[k], politique);
+                continue;
+            }
+            marque[y] = (int)m;
+            dst[m] = y;
+            poids[m] = poids[k];
+            m++;
+        }
+        lecture = fin_x;
+        for (size_t k = debut[x]; k < m; ++k) marque[dst[k]] = -1;
+    }
+    debut[n] = m;
+}
+
+int graphe_value_liste_ajouter_arcs(GrapheValueListe *g, const TripletArc *arcs, int nb_arcs,
+                                    PolitiqueDoublons politique) {
+    if (!g || nb_arcs < 0 || (nb_arcs > 0 && !arcs)) return -1;
+    int n = g->nb_sommets;
+    size_t taille = nb_arcs > 0 ? (size_t)nb_arcs : 1;
+    size_t *debut = (size_t *)calloc((size_t)n + 1, sizeof(size_t));
+    int *marque = (int *)malloc(((size_t)n + 1) * sizeof(int));
+    int *dst = (int *)malloc(taille * sizeof(int));
+    int *poids = (int *)malloc(taille * sizeof(int));
+    if (!debut || !marque || !dst || !poids) {
+        free(debut);
+        free(marque);
+        free(dst);
+        free(poids);
+        return -1;
+    }
+    for (int v = 0; v < n; ++v) marque[v] = -1;
+    grouper_arcs(g, arcs, nb_arcs, politique, debut, dst, poids, marque);
+
+    if (!g->oriente) {
+        /* every edge x-y becomes x->y and y->x, regrouped by source */
+        size_t m = debut[n];
+        size_t *debut2 = (size_t *)calloc((size_t)n + 1, sizeof(size_t));
+        int *dst2 = (int *)malloc((2 * m + 1) * sizeof(int));
+        int *poids2 = (int *)malloc((2 * m + 1) * sizeof(int));
+        if (!debut2 || !dst2 || !poids2) {
+            free(debut2);
+            free(dst2);
+            free(poids2);
+            free(debut);
+            free(marque);
+            free(dst);
+            free(poids);
+            return -1;
+        }
+        for (int x = 0; x < n; ++x)
+            for (size_t k = debut[x]; k < debut[x + 1]; ++k) {
+                debut2[x + 1]++;
+                if (dst[k] != x) debut2[dst[k] + 1]++;
+            }
+        for (int v = 0; v < n; ++v) debut2[v + 1] += debut2[v];
+        for (int x = 0; x < n; ++x)
+            for (size_t k = debut[x]; k < debut[x + 1]; ++k) {
+                int y = dst[k];
+                size_t i = debut2[x]++;
+                dst2[i] = y;
+                poids2[i] = poids[k];
+                if (y == x) continue; /* a loop is stored twice in x's list, see below */
+                i = debut2[y]++;
+                dst2[i] = x;
+                poids2[i] = poids[k];
+            }
+        for (int v = n; v > 0; --v) debut2[v] = debut2[v - 1];
+        debut2[0] = 0;
+        free(debut);
+        free(dst);
+        free(poids);
+        debut = debut2;
+        dst = dst2;
+        poids = poids2;
+    }
+
+    /* arcs already in the graph: one walk per source list, weights merged,
+       the batch entry marked with dst = -1 */
+    size_t nouveaux = 0;
+    int ajoutes = 0;
+    for (int x = 0; x < n; ++x) {
+        if (debut[x] == debut[x + 1]) continue;
+        for (size_t k = debut[x]; k < debut[x + 1]; ++k) marque[dst[k]] = (int)k;
+        for (ArcValueListe *a = g->adj[x]; a; a = a->suivant) {
+            int k = marque[a->dest];
+            if (k < 0) continue;
+            a->poids = fusionner_poids(a->poids, poids[k], politique);
+            dst[k] = -1;
+            if (g->pred) {
+                for (ArcValueListe *rev = g->pred[a->dest]; rev; rev = rev->suivant) {
+                    if (rev->dest == x) {
+                        rev->poids = a->poids;
+                        break;
+                    }
+                }
+            }
+            /* both nodes of a non oriented loop are merged */
+            if (g->oriente || a->dest != x) marque[a->dest] = -1;
+        }
+        marque[x] = -1;
+        for (size_t k = debut[x]; k < debut[x + 1]; ++k) {
+            int y = dst[k];
+            if (y < 0) continue;
+            marque[y] = -1;
+            nouveaux += (g->oriente && g->pred) || (!g->oriente && y == x) ? 2 : 1;
+            if (g->oriente || x <= y) ajoutes++;
+        }
+    }
+
+    /* new arcs, prepended in input order as graphe_value_liste_ajouter_arc would */
+    if (!pool_arcs_reserver(&g->pool, nouveaux)) ajoutes = -1;
+    for (int x = 0; ajoutes >= 0 && x < n; ++x) {
+        if (debut[x] < debut[x + 1]) oublier_index(g, x); /* rebuilt by the next lookup */
+        for (size_t k = debut[x]; k < debut[x + 1]; ++k) {
+            int y = dst[k];
+            if (y < 0) continue;
+            ArcValueListe *node = (ArcValueListe *)pool_arcs_allouer(&g->pool);
+            node->dest = y;
+            node->poids = poids[k];
+            node->suivant = g->adj[x];
+            g->adj[x] = node;
+            if (g->deg_entrant) g->deg_entrant[y]++;
+            if (!g->oriente && y == x) {
+                ArcValueListe *jumeau = (ArcValueListe *)pool_arcs_allouer(&g->pool);
+                jumeau->dest = x;
+                jumeau->poids = poids[k];
+                jumeau->suivant = g->adj[x];
+                g->adj[x] = jumeau;
+                if (g->deg_entrant) g->deg_entrant[x]++;
+            } else if (g->oriente && g->pred) {
+                ArcValueListe *rev = (ArcValueListe *)pool_arcs_allouer(&g->pool);
+                rev->dest = x;
+                rev->poids = poids[k];
+                rev->suivant = g->pred[y];
+                g->pred[y] = rev;
+            }
+        }
     }
+
+    free(debut);
+    free(marque);
+    free(dst);
+    free(poids);
+    return ajoutes;
 }
 
 void graphe_value_liste_supprimer_arc(GrapheValueListe *g, int u, int v) {
@@ -156,27 +830,16 @@ void graphe_value_liste_supprimer_arc(GrapheValueListe *g, int u, int v) {
 int graphe_value_liste_existe_arc(GrapheValueListe *g, int u, int v) {
     if (!g) return 0;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return 0;
-
-    ArcValueListe *cur = g->adj[u];
-    while (cur) {
-        if (cur->dest == v) return 1;
-        cur = cur->suivant;
-    }
-    return 0;
+    return chercher_lien(g, u, v) != NULL;
 }
 
 int graphe_value_liste_obtenir_poids(GrapheValueListe *g, int u, int v, int *poids) {
     if (!g || !poids) return 0;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return 0;
-    ArcValueListe *cur = g->adj[u];
-    while (cur) {
-        if (cur->dest == v) {
-            *poids = cur->poids;
-            return 1;
-        }
-        cur = cur->suivant;
-    }
-    return 0;
+    ArcValueListe **lien = chercher_lien(g, u, v);
+    if (!lien) return 0;
+    *poids = (*lien)->poids;
+    return 1;
 }
 
 void graphe_value_liste_modifier_poids(GrapheValueListe *g, int u, int v, int nouveau_poids) {
@@ -189,13 +852,19 @@ void graphe_value_liste_modifier_poids(GrapheValueListe *g, int u, int v, int no
     }
 
     /* try to find existing arc */
-    ArcValueListe *cur = g->adj[u];
-    while (cur) {
-        if (cur->dest == v) {
-            cur->poids = nouveau_poids;
-            return;
+    ArcValueListe **lien = chercher_lien(g, u, v);
+    if (lien) {
+        (*lien)->poids = nouveau_poids;
+        if (g->pred) {
+            /* keep the reverse copy of the arc in sync */
+            for (ArcValueListe *rev = g->pred[v]; rev; rev = rev->suivant) {
+                if (rev->dest == u) {
+                    rev->poids = nouveau_poids;
+                    break;
+                }
+            }
         }
-        cur = cur->suivant;
+        return;
     }
     /* if not found, add arc */
     graphe_value_liste_ajouter_arc(g, u, v, nouveau_poids);
@@ -208,6 +877,7 @@ int graphe_value_liste_ordre(const GrapheValueListe *g) {
 
 int graphe_value_liste_degre_sortant(const GrapheValueListe *g, int v) {
     if (!g || v < 0 || v >= g->nb_sommets) return 0;
+    if (g->index && g->index[v]) return g->index[v]->nb_arcs;
     int deg = 0;
     ArcValueListe *cur = g->adj[v];
     while (cur) {
@@ -219,6 +889,7 @@ int graphe_value_liste_degre_sortant(const GrapheValueListe *g, int v) {
 
 int graphe_value_liste_degre_entrant(const GrapheValueListe *g, int v) {
     if (!g || v < 0 || v >= g->nb_sommets) return 0;
+    if (g->deg_entrant) return g->deg_entrant[v];
     int deg = 0;
     for (int i = 0; i < g->nb_sommets; ++i) {
         ArcValueListe *cur = g->adj[i];
@@ -243,3 +914,106 @@ ArcValueListe *graphe_value_liste_voisins(const GrapheValueListe *g, int v) {
     if (!g || v < 0 || v >= g->nb_sommets) return NULL;
     return g->adj[v];
 }
+
+/* Copy n lists into dst, allocating from p, preserving node order */
+static int copier_listes(ArcValueListe **src, ArcValueListe **dst, int n, PoolArcs *p) {
+    for (int v = 0; v < n; ++v) {
+        ArcValueListe **queue = &dst[v];
+        for (ArcValueListe *cur = src[v]; cur; cur = cur->suivant) {
+            ArcValueListe *copie = (ArcValueListe *)pool_arcs_allouer(p);
+            if (!copie) return 0;
+            copie->dest = cur->dest;
+            copie->poids = cur->poids;
+            copie->suivant = NULL;
+            *queue = copie;
+            queue = &copie->suivant;
+        }
+    }
+    return 1;
+}
+
+int graphe_value_liste_compacter(GrapheValueListe *g) {
+    if (!g) return 0;
+    PoolArcs neuf;
+    pool_arcs_init(&neuf, sizeof(ArcValueListe));
+
+    /* Copy into a fresh pool: the nodes of a vertex become consecutive.
+       The old lists stay valid until every copy succeeded. */
+    ArcValueListe **nouveau = (ArcValueListe **)calloc(g->capacite, sizeof(ArcValueListe *));
+    ArcValueListe **nouveau_pred = NULL;
+    if (g->pred) nouveau_pred = (ArcValueListe **)calloc(g->capacite, sizeof(ArcValueListe *));
+    if (!nouveau || (g->pred && !nouveau_pred) ||
+        !copier_listes(g->adj, nouveau, g->nb_sommets, &neuf) ||
+        (g->pred && !copier_listes(g->pred, nouveau_pred, g->nb_sommets, &neuf))) {
+        pool_arcs_vider(&neuf);
+        free(nouveau);
+        free(nouveau_pred);
+        return 0;
+    }
+
+    /* node counters cover the whole life of the graph, not the copy */
+    neuf.stats.allocations   = g->pool.stats.allocations;
+    neuf.stats.liberations   = g->pool.stats.liberations;
+    neuf.stats.recyclages    = g->pool.stats.recyclages;
+    neuf.stats.appels_malloc += g->pool.stats.appels_malloc;
+
+    pool_arcs_vider(&g->pool);
+    free(g->adj);
+    free(g->pred);
+    g->adj = nouveau;
+    g->pred = nouveau_pred;
+    g->pool = neuf;
+    oublier_tous_les_index(g);
+    return 1;
+}
+
+void graphe_value_liste_stats_allocation(const GrapheValueListe *g, StatsPool *stats) {
+    if (!g || !stats) return;
+    *stats = g->pool.stats;
+}
+
+int graphe_value_liste_activer_predecesseurs(GrapheValueListe *g) {
+    if (!g) return 0;
+    if (g->deg_entrant) return 1;
+    g->deg_entrant = (int *)malloc(g->capacite * sizeof(int));
+    if (!g->deg_entrant) return 0;
+    if (g->oriente) {
+        g->pred = (ArcValueListe **)calloc(g->capacite, sizeof(ArcValueListe *));
+        if (!g->pred || !construire_predecesseurs(g)) {
+            graphe_value_liste_desactiver_predecesseurs(g);
+            return 0;
+        }
+    } else {
+        construire_predecesseurs(g);
+    }
+    return 1;
+}
+
+void graphe_value_liste_desactiver_predecesseurs(GrapheValueListe *g) {
+    if (!g) return;
+    if (g->pred) {
+        for (int v = 0; v < g->nb_sommets; ++v) {
+            ArcValueListe *cur = g->pred[v];
+            while (cur) {
+                ArcValueListe *tmp = cur;
+                cur = cur->suivant;
+                pool_arcs_liberer(&g->pool, tmp);
+            }
+        }
+    }
+    free(g->pred);
+    free(g->deg_entrant);
+    g->pred = NULL;
+    g->deg_entrant = NULL;
+}
+
+int graphe_value_liste_predecesseurs_actifs(const GrapheValueListe *g) {
+    if (!g) return 0;
+    return g->deg_entrant != NULL;
+}
+
+ArcValueListe *graphe_value_liste_predecesseurs(const GrapheValueListe *g, int v) {
+    if (!g || !g->deg_entrant || v < 0 || v >= g->nb_sommets) return NULL;
+    if (!g->oriente) return g->adj[v];
+    return g->pred[v];
+}
@@ -2,6 +2,9 @@
 #ifndef GRAPHE_VALUE_LISTE_H
 #define GRAPHE_VALUE_LISTE_H
 
+#include "PoolArcs.h"
+#include "IndexVoisins.h"
+
 typedef struct ArcValueListe {
     int dest;
     int poids;
@@ -13,20 +16,84 @@ typedef struct {
     int capacite;
     int oriente;
     ArcValueListe **adj; /* list of neighbors with weights */
+    PoolArcs pool;       /* every ArcValueListe node of the graph comes from here */
+    /* Optional predecessor tracking (NULL when disabled) */
+    int *deg_entrant;     /* deg_entrant[i] = number of arcs ending at i */
+    ArcValueListe **pred; /* pred[i] = sources (and weights) of arcs ending at i
+                             (oriented graphs only, adj is its own reverse otherwise) */
+    /* Hash index of the long lists (NULL until one is needed): index[i] is
+       built once a lookup walks past INDEX_VOISINS_SEUIL nodes of adj[i] */
+    IndexVoisins **index;
+    /* Stable ids (NULL until enabled, see below) */
+    int *id_externe;  /* id_externe[i] = id of vertex i, -1 for a removed vertex */
+    int *interne;     /* interne[id] = current index of vertex id, -1 once removed */
+    int nb_ids;       /* ids handed out so far */
+    int capacite_ids;
+    int nb_supprimes; /* removed vertices still holding an index */
 } GrapheValueListe;
 
+/* One arc of a batch */
+typedef struct {
+    int u;
+    int v;
+    int poids;
+} TripletArc;
+
+/* What a batch does with an arc that is repeated or already present
+   (the graph's arc counts as the first occurrence) */
+typedef enum {
+    DOUBLONS_GARDER_PREMIER, /* first weight wins */
+    DOUBLONS_POIDS_MIN,      /* smallest weight */
+    DOUBLONS_SOMME           /* weights added (saturates at INT_MAX) */
+} PolitiqueDoublons;
+
 /* Creation / destruction */
 GrapheValueListe *graphe_value_liste_creer(int capacite_initiale, int oriente);
 void graphe_value_liste_detruire(GrapheValueListe *g);
 
+/* Bulk construction, same lists as graphe_value_liste_ajouter_arc called
+   in array order (invalid arcs and weights <= 0 skipped), every list contiguous */
+GrapheValueListe *graphe_value_liste_depuis_arcs(int nb_sommets, int oriente, const int *src,
+                                                 const int *dst, const int *poids, int nb_arcs);
+
 /* Vertices */
 int  graphe_value_liste_ajouter_sommet(GrapheValueListe *g);
+/* The last vertex takes the index of v. With the predecessors enabled
+   only the lists of v, last and their neighbors are touched, but each
+   neighbor list of last is walked to rename it: O(sum of the degrees of
+   the neighbors of v and last). Otherwise every list is scanned (O(V+E)). */
 void graphe_value_liste_supprimer_sommet(GrapheValueListe *g, int v);
 
+/* Lazy removal with stable ids. Once enabled (predecessors are enabled
+   too), every vertex has an id that never changes: the current index
+   at activation, then the next unused id for each new vertex.
+   supprimer_sommet_differe only drops the arcs of v and marks it
+   removed; the removed vertices keep their index (isolated, counted by
+   the order) until compacter_sommets renumbers the others in O(V+E),
+   order kept, which happens by itself once a quarter of the indices
+   are removed: O(1 + E/V) per removal amortized, against the neighbor
+   list walks of supprimer_sommet on high degree neighborhoods. Indices
+   are only stable between two compactions, ids always are. */
+int  graphe_value_liste_activer_ids_stables(GrapheValueListe *g); /* 1 = ok */
+void graphe_value_liste_supprimer_sommet_differe(GrapheValueListe *g, int v);
+int  graphe_value_liste_compacter_sommets(GrapheValueListe *g); /* vertices dropped */
+int  graphe_value_liste_est_supprime(const GrapheValueListe *g, int v);
+int  graphe_value_liste_id_sommet(const GrapheValueListe *g, int v);   /* -1 if removed */
+int  graphe_value_liste_sommet_id(const GrapheValueListe *g, int id);  /* current index, -1 if removed */
+
 /* Edges / arcs */
 void graphe_value_liste_ajouter_arc(GrapheValueListe *g, int u, int v, int poids);
 void graphe_value_liste_supprimer_arc(GrapheValueListe *g, int u, int v);
 int  graphe_value_liste_existe_arc(GrapheValueListe *g, int u, int v);
+/* Batch insertion without duplicates: the arcs are grouped by source
+   (counting sort), merged with each other and with the arcs already in
+   the graph according to the policy, and the new ones are prepended in
+   one pass per list. (u, v) and (v, u) are the same edge in a non
+   oriented graph. Invalid arcs and weights <= 0 are skipped.
+   Returns the number of arcs (edges if non oriented) added, -1 if out
+   of memory. O(V + nb_arcs + degrees of the sources touched). */
+int  graphe_value_liste_ajouter_arcs(GrapheValueListe *g, const TripletArc *arcs, int nb_arcs,
+                                     PolitiqueDoublons politique);
 
 /* Weight operations */
 int  graphe_value_liste_obtenir_poids(GrapheValueListe *g, int u, int v, int *poids);
@@ -42,4 +109,17 @@ int graphe_value_liste_est_oriente(const GrapheValueListe *g);
 /* Helper to iterate neighbors */
 ArcValueListe *graphe_value_liste_voisins(const GrapheValueListe *g, int v);
 
+/* Predecessors: once enabled, in-degree counters and reverse lists are
+   kept up to date by every modification, so graphe_value_liste_degre_entrant
+   is O(1) and predecessors are iterated in O(in-degree). */
+int  graphe_value_liste_activer_predecesseurs(GrapheValueListe *g); /* 1 = ok */
+void graphe_value_liste_desactiver_predecesseurs(GrapheValueListe *g);
+int  graphe_value_liste_predecesseurs_actifs(const GrapheValueListe *g);
+ArcValueListe *graphe_value_liste_predecesseurs(const GrapheValueListe *g, int v); /* NULL if disabled */
+
+/* Memory: rebuild every list contiguously (vertex by vertex, order kept)
+   and read the node allocation counters */
+int  graphe_value_liste_compacter(GrapheValueListe *g); /* 1 = ok */
+void graphe_value_liste_stats_allocation(const GrapheValueListe *g, StatsPool *stats);
+
 #endif /* GRAPHE_VALUE_LISTE_H */
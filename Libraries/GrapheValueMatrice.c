@@ -1,35 +1,57 @@
 /* GrapheValueMatrice.c */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
 #include "GrapheValueMatrice.h"
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+static size_t taille_entree(TypePoids type) {
+    switch (type) {
+    case POIDS_UINT8:  return sizeof(uint8_t);
+    case POIDS_UINT16: return sizeof(uint16_t);
+    default:           return sizeof(int);
+    }
+}
+
+static int lire(const GrapheValueMatrice *g, int i, int j) {
+    size_t k = (size_t)i * g->capacite + j;
+    switch (g->type_poids) {
+    case POIDS_UINT8:  return ((const uint8_t *)g->weight)[k];
+    case POIDS_UINT16: return ((const uint16_t *)g->weight)[k];
+    default:           return ((const int *)g->weight)[k];
+    }
+}
 
-static int **allouer_matrice(int n) {
-    int **m = (int **)malloc(n * sizeof(int *));
-    if (!m) return NULL;
-    for (int i = 0; i < n; ++i) {
-        m[i] = (int *)calloc(n, sizeof(int)); /* initialized to 0 = no edge */
-        if (!m[i]) {
-            for (int j = 0; j < i; ++j) free(m[j]);
-            free(m);
-            return NULL;
-        }
+static void ecrire(GrapheValueMatrice *g, int i, int j, int poids) {
+    size_t k = (size_t)i * g->capacite + j;
+    switch (g->type_poids) {
+    case POIDS_UINT8:  ((uint8_t *)g->weight)[k] = (uint8_t)poids; break;
+    case POIDS_UINT16: ((uint16_t *)g->weight)[k] = (uint16_t)poids; break;
+    default:           ((int *)g->weight)[k] = poids; break;
     }
-    return m;
 }
 
-static void liberer_matrice(int **m, int n) {
-    if (!m) return;
-    for (int i = 0; i < n; ++i) free(m[i]);
-    free(m);
+static char *ligne(const GrapheValueMatrice *g, int i) {
+    return (char *)g->weight + (size_t)i * g->capacite * taille_entree(g->type_poids);
 }
 
+static void *allouer_matrice(int n, TypePoids type) {
+    /* initialized to 0 = no edge */
+    return calloc((size_t)n * n, taille_entree(type));
+}
+
+/* Rows keep their content, only the stride changes: one memcpy per row */
 static int redimensionner(GrapheValueMatrice *g, int nouvelle_capacite) {
-    int **nouvelle = allouer_matrice(nouvelle_capacite);
+    size_t taille = taille_entree(g->type_poids);
+    char *nouvelle = (char *)allouer_matrice(nouvelle_capacite, g->type_poids);
     if (!nouvelle) return 0;
     for (int i = 0; i < g->nb_sommets; ++i)
-        for (int j = 0; j < g->nb_sommets; ++j)
-            nouvelle[i][j] = g->weight[i][j];
-    liberer_matrice(g->weight, g->capacite);
+        memcpy(nouvelle + (size_t)i * nouvelle_capacite * taille, ligne(g, i),
+               (size_t)g->nb_sommets * taille);
+    free(g->weight);
     g->weight = nouvelle;
     g->capacite = nouvelle_capacite;
     return 1;
@@ -38,11 +60,17 @@ static int redimensionner(GrapheValueMatrice *g, int nouvelle_capacite) {
 /* PUBLIC API */
 
 GrapheValueMatrice *graphe_value_matrice_creer(int capacite_initiale, int oriente) {
+    return graphe_value_matrice_creer_type(capacite_initiale, oriente, POIDS_INT32);
+}
+
+GrapheValueMatrice *graphe_value_matrice_creer_type(int capacite_initiale, int oriente,
+                                                    TypePoids type_poids) {
+    if (type_poids != POIDS_UINT8 && type_poids != POIDS_UINT16) type_poids = POIDS_INT32;
     GrapheValueMatrice *g = (GrapheValueMatrice *)malloc(sizeof(GrapheValueMatrice));
     if (!g) return NULL;
     if (capacite_initiale <= 0) capacite_initiale = 1;
 
-    g->weight = allouer_matrice(capacite_initiale);
+    g->weight = allouer_matrice(capacite_initiale, type_poids);
     if (!g->weight) {
         free(g);
         return NULL;
@@ -50,15 +78,23 @@ GrapheValueMatrice *graphe_value_matrice_creer(int capacite_initiale, int orient
     g->nb_sommets = 0;
     g->capacite   = capacite_initiale;
     g->oriente    = oriente ? 1 : 0;
+    g->type_poids = type_poids;
     return g;
 }
 
 void graphe_value_matrice_detruire(GrapheValueMatrice *g) {
     if (!g) return;
-    liberer_matrice(g->weight, g->capacite);
+    free(g->weight);
     free(g);
 }
 
+/* Grow once before a burst of insertions instead of doubling repeatedly */
+int graphe_value_matrice_reserver(GrapheValueMatrice *g, int capacite) {
+    if (!g) return 0;
+    if (capacite <= g->capacite) return 1;
+    return redimensionner(g, capacite);
+}
+
 int graphe_value_matrice_ajouter_sommet(GrapheValueMatrice *g) {
     if (!g) return -1;
     if (g->nb_sommets == g->capacite) {
@@ -75,16 +111,15 @@ void graphe_value_matrice_supprimer_sommet(GrapheValueMatrice *g, int v) {
     if (v < 0 || v >= g->nb_sommets) return;
 
     int last = g->nb_sommets - 1;
+    size_t octets = (size_t)g->nb_sommets * taille_entree(g->type_poids);
     if (v != last) {
-        for (int j = 0; j < g->nb_sommets; ++j)
-            g->weight[v][j] = g->weight[last][j];
+        memcpy(ligne(g, v), ligne(g, last), octets);
         for (int i = 0; i < g->nb_sommets; ++i)
-            g->weight[i][v] = g->weight[i][last];
-    }
-    for (int j = 0; j < g->nb_sommets; ++j) {
-        g->weight[last][j] = 0;
-        g->weight[j][last] = 0;
+            ecrire(g, i, v, lire(g, i, last));
     }
+    memset(ligne(g, last), 0, octets);
+    for (int j = 0; j < g->nb_sommets; ++j)
+        ecrire(g, j, last, 0);
     g->nb_sommets--;
 }
 
@@ -92,29 +127,30 @@ void graphe_value_matrice_ajouter_arc(GrapheValueMatrice *g, int u, int v, int p
     if (!g) return;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return;
     if (poids <= 0) return; /* we assume strictly positive weights */
-    g->weight[u][v] = poids;
+    if (poids > graphe_value_matrice_poids_max(g)) return; /* does not fit the entry type */
+    ecrire(g, u, v, poids);
     if (!g->oriente)
-        g->weight[v][u] = poids;
+        ecrire(g, v, u, poids);
 }
 
 void graphe_value_matrice_supprimer_arc(GrapheValueMatrice *g, int u, int v) {
     if (!g) return;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return;
-    g->weight[u][v] = 0;
+    ecrire(g, u, v, 0);
     if (!g->oriente)
-        g->weight[v][u] = 0;
+        ecrire(g, v, u, 0);
 }
 
 int graphe_value_matrice_existe_arc(const GrapheValueMatrice *g, int u, int v) {
     if (!g) return 0;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return 0;
-    return g->weight[u][v] > 0;
+    return lire(g, u, v) > 0;
 }
 
 int graphe_value_matrice_obtenir_poids(const GrapheValueMatrice *g, int u, int v) {
     if (!g) return 0;
     if (u < 0 || v < 0 || u >= g->nb_sommets || v >= g->nb_sommets) return 0;
-    return g->weight[u][v]; /* 0 means no edge */
+    return lire(g, u, v); /* 0 means no edge */
 }
 
 void graphe_value_matrice_modifier_poids(GrapheValueMatrice *g, int u, int v, int nouveau_poids) {
@@ -123,10 +159,10 @@ void graphe_value_matrice_modifier_poids(GrapheValueMatrice *g, int u, int v, in
     if (nouveau_poids <= 0) {
         /* treat as removing edge */
         graphe_value_matrice_supprimer_arc(g, u, v);
-    } else {
-        g->weight[u][v] = nouveau_poids;
+    } else if (nouveau_poids <= graphe_value_matrice_poids_max(g)) {
+        ecrire(g, u, v, nouveau_poids);
         if (!g->oriente)
-            g->weight[v][u] = nouveau_poids;
+            ecrire(g, v, u, nouveau_poids);
     }
 }
 
@@ -139,7 +175,7 @@ int graphe_value_matrice_degre_sortant(const GrapheValueMatrice *g, int v) {
     if (!g || v < 0 || v >= g->nb_sommets) return 0;
     int deg = 0;
     for (int j = 0; j < g->nb_sommets; ++j)
-        if (g->weight[v][j] > 0) deg++;
+        if (lire(g, v, j) > 0) deg++;
     return deg;
 }
 
@@ -147,7 +183,7 @@ int graphe_value_matrice_degre_entrant(const GrapheValueMatrice *g, int v) {
     if (!g || v < 0 || v >= g->nb_sommets) return 0;
     int deg = 0;
     for (int i = 0; i < g->nb_sommets; ++i)
-        if (g->weight[i][v] > 0) deg++;
+        if (lire(g, i, v) > 0) deg++;
     return deg;
 }
 
@@ -159,3 +195,12 @@ int graphe_value_matrice_est_oriente(const GrapheValueMatrice *g) {
     if (!g) return 0;
     return g->oriente;
 }
+
+int graphe_value_matrice_poids_max(const GrapheValueMatrice *g) {
+    if (!g) return 0;
+    switch (g->type_poids) {
+    case POIDS_UINT8:  return UINT8_MAX;
+    case POIDS_UINT16: return UINT16_MAX;
+    default:           return INT_MAX;
+    }
+}
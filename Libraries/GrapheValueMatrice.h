@@ -4,20 +4,33 @@
 
 /* Graph with weights on arcs.
    We assume positive integer weights.
-   weight[i][j] = 0 means "no edge". */
+   weight(i, j) = 0 means "no edge".
+   The matrix is one flat row-major buffer whose row stride is capacite:
+   entry (i, j) is at index i * capacite + j. Entries are int by default,
+   or uint16 / uint8 when the graph is created with a narrower type. */
+
+typedef enum {
+    POIDS_INT32 = 0, /* weights 1 .. INT_MAX (default) */
+    POIDS_UINT16,    /* weights 1 .. 65535 */
+    POIDS_UINT8      /* weights 1 .. 255 */
+} TypePoids;
 
 typedef struct {
     int nb_sommets;
-    int capacite;
+    int capacite;         /* allocated rows, and row stride in entries */
     int oriente;
-    int **weight;  /* 0 = no edge, >0 = weight */
+    TypePoids type_poids; /* type of one entry */
+    void *weight;         /* capacite * capacite entries, 0 = no edge */
 } GrapheValueMatrice;
 
 /* Creation / destruction */
 GrapheValueMatrice *graphe_value_matrice_creer(int capacite_initiale, int oriente);
+GrapheValueMatrice *graphe_value_matrice_creer_type(int capacite_initiale, int oriente,
+                                                    TypePoids type_poids);
 void graphe_value_matrice_detruire(GrapheValueMatrice *g);
 
 /* Vertices */
+int  graphe_value_matrice_reserver(GrapheValueMatrice *g, int capacite); /* 1 = ok */
 int  graphe_value_matrice_ajouter_sommet(GrapheValueMatrice *g);
 void graphe_value_matrice_supprimer_sommet(GrapheValueMatrice *g, int v);
 
@@ -36,5 +49,6 @@ int graphe_value_matrice_degre_sortant(const GrapheValueMatrice *g, int v);
 int graphe_value_matrice_degre_entrant(const GrapheValueMatrice *g, int v);
 int graphe_value_matrice_degre(const GrapheValueMatrice *g, int v);
 int graphe_value_matrice_est_oriente(const GrapheValueMatrice *g);
+int graphe_value_matrice_poids_max(const GrapheValueMatrice *g); /* largest storable weight */
 
 #endif /* GRAPHE_VALUE_MATRICE_H */
@@ -0,0 +1,109 @@
+/* IndexVoisins.c */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "IndexVoisins.h"
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+#define VIDE    (-1)
+#define SUPPRIME (-2)
+
+/* Fibonacci hashing: consecutive ids are spread over the table */
+static int position(const IndexVoisins *idx, int cle) {
+    return (int)(((uint32_t)cle * 2654435769u) & (uint32_t)(idx->capacite - 1));
+}
+
+static EntreeIndex *allouer_entrees(int capacite) {
+    EntreeIndex *t = (EntreeIndex *)malloc((size_t)capacite * sizeof(EntreeIndex));
+    if (!t) return NULL;
+    for (int i = 0; i < capacite; ++i) {
+        t[i].cle = VIDE;
+        t[i].nb = 0;
+        t[i].lien = NULL;
+    }
+    return t;
+}
+
+/* Rehash into capacite slots, dropping the deleted ones */
+static int rehacher(IndexVoisins *idx, int capacite) {
+    EntreeIndex *t = allouer_entrees(capacite);
+    if (!t) return 0;
+    EntreeIndex *ancien = idx->entrees;
+    int ancienne_capacite = idx->capacite;
+    idx->entrees = t;
+    idx->capacite = capacite;
+    for (int i = 0; i < ancienne_capacite; ++i) {
+        if (ancien[i].cle < 0) continue;
+        int p = position(idx, ancien[i].cle);
+        while (t[p].cle != VIDE) p = (p + 1) & (capacite - 1);
+        t[p] = ancien[i];
+    }
+    idx->occupees = idx->taille;
+    free(ancien);
+    return 1;
+}
+
+/* PUBLIC API */
+
+IndexVoisins *index_voisins_creer(int nb_prevu) {
+    IndexVoisins *idx = (IndexVoisins *)malloc(sizeof(IndexVoisins));
+    if (!idx) return NULL;
+    int capacite = 16;
+    while (capacite < 2 * nb_prevu && capacite < (1 << 30)) capacite *= 2;
+    idx->entrees = allouer_entrees(capacite);
+    if (!idx->entrees) {
+        free(idx);
+        return NULL;
+    }
+    idx->capacite = capacite;
+    idx->taille = 0;
+    idx->occupees = 0;
+    idx->nb_arcs = 0;
+    return idx;
+}
+
+void index_voisins_detruire(IndexVoisins *idx) {
+    if (!idx) return;
+    free(idx->entrees);
+    free(idx);
+}
+
+EntreeIndex *index_voisins_chercher(const IndexVoisins *idx, int cle) {
+    if (!idx || cle < 0) return NULL;
+    int p = position(idx, cle);
+    while (idx->entrees[p].cle != VIDE) {
+        if (idx->entrees[p].cle == cle) return &idx->entrees[p];
+        p = (p + 1) & (idx->capacite - 1);
+    }
+    return NULL;
+}
+
+EntreeIndex *index_voisins_inserer(IndexVoisins *idx, int cle) {
+    if (!idx || cle < 0) return NULL;
+    EntreeIndex *e = index_voisins_chercher(idx, cle);
+    if (e) return e;
+    if (2 * (idx->occupees + 1) > idx->capacite) {
+        /* grow only if the live keys need it, otherwise just purge */
+        int capacite = 2 * (idx->taille + 1) > idx->capacite / 2 ? 2 * idx->capacite : idx->capacite;
+        if (!rehacher(idx, capacite)) return NULL;
+    }
+    int p = position(idx, cle);
+    while (idx->entrees[p].cle >= 0) p = (p + 1) & (idx->capacite - 1);
+    if (idx->entrees[p].cle == VIDE) idx->occupees++;
+    idx->taille++;
+    e = &idx->entrees[p];
+    e->cle = cle;
+    e->nb = 0;
+    e->lien = NULL;
+    return e;
+}
+
+void index_voisins_retirer(IndexVoisins *idx, EntreeIndex *e) {
+    if (!idx || !e || e->cle < 0) return;
+    idx->nb_arcs -= e->nb;
+    e->cle = SUPPRIME;
+    e->nb = 0;
+    e->lien = NULL;
+    idx->taille--;
+}
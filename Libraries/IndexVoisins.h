@@ -0,0 +1,41 @@
+/* IndexVoisins.h */
+#ifndef INDEX_VOISINS_H
+#define INDEX_VOISINS_H
+
+/* Open-addressing hash index over the adjacency list of one vertex
+   (linear probing, power-of-two table, load factor <= 1/2).
+   It maps a destination to the link that points to the first node going
+   there, so that a node can be found and unlinked from a singly linked
+   list in O(1) expected. The list libraries build one for a vertex whose
+   list is walked past INDEX_VOISINS_SEUIL nodes and drop it when the
+   degree falls back under half of it. */
+
+#define INDEX_VOISINS_SEUIL 64
+
+typedef struct {
+    int cle;    /* destination, or one of the markers of IndexVoisins.c */
+    int nb;     /* parallel arcs to cle */
+    void *lien; /* address of the pointer to the first node going to cle,
+                   NULL for the head of the list (the list array may move) */
+} EntreeIndex;
+
+typedef struct {
+    EntreeIndex *entrees;
+    int capacite; /* slots, power of two */
+    int taille;   /* distinct destinations */
+    int occupees; /* destinations + deleted slots */
+    int nb_arcs;  /* sum of nb */
+} IndexVoisins;
+
+/* Creation / destruction, room for nb_prevu destinations */
+IndexVoisins *index_voisins_creer(int nb_prevu);
+void index_voisins_detruire(IndexVoisins *idx);
+
+/* Entry of cle, NULL if absent */
+EntreeIndex *index_voisins_chercher(const IndexVoisins *idx, int cle);
+/* Entry of cle, created with nb = 0 if absent; NULL if out of memory.
+   The pointers returned earlier are invalidated. */
+EntreeIndex *index_voisins_inserer(IndexVoisins *idx, int cle);
+void index_voisins_retirer(IndexVoisins *idx, EntreeIndex *e);
+
+#endif /* INDEX_VOISINS_H */
@@ -0,0 +1,280 @@
+/* Instrumentation.c */
+#ifdef __linux__
+#define _GNU_SOURCE /* syscall() */
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "Instrumentation.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char *noms_stats[NB_STATS] = {
+    "arcs_parcourus", "relaxations", "tas_insertions", "tas_diminutions",
+    "tas_extractions", "allocations", "octets_alloues"
+};
+
+static const char *noms_materiels[NB_COMPTEURS_MATERIELS] = {
+    "cycles", "instructions", "defauts_llc", "defauts_branches"
+};
+
+/* Counters of one thread; the live ones are chained, the threads that
+   exited have been added to retires */
+typedef struct BlocThread {
+    long long compteurs[NB_STATS];
+    struct BlocThread *suivant;
+} BlocThread;
+
+static pthread_mutex_t verrou = PTHREAD_MUTEX_INITIALIZER;
+static BlocThread *blocs;
+static long long retires[NB_STATS];
+static StatsPhase phases[INSTRUMENTATION_PHASES_MAX];
+static int nb_phases;
+static pthread_key_t cle_thread;
+static pthread_once_t cle_creee = PTHREAD_ONCE_INIT;
+
+static int descripteurs[NB_COMPTEURS_MATERIELS] = { -1, -1, -1, -1 };
+static long long base_materiel[NB_COMPTEURS_MATERIELS];
+
+_Thread_local long long *instrumentation_local;
+
+double instrumentation_horloge(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* ---------- per-thread counters ---------- */
+
+static void retirer_bloc(void *p) {
+    BlocThread *b = (BlocThread *)p;
+    pthread_mutex_lock(&verrou);
+    for (int i = 0; i < NB_STATS; ++i) retires[i] += b->compteurs[i];
+    BlocThread **lien = &blocs;
+    while (*lien && *lien != b) lien = &(*lien)->suivant;
+    if (*lien) *lien = b->suivant;
+    pthread_mutex_unlock(&verrou);
+    free(b);
+}
+
+static void creer_cle(void) {
+    pthread_key_create(&cle_thread, retirer_bloc);
+}
+
+long long *instrumentation_compteurs_thread(void) {
+    static long long poubelle[NB_STATS]; /* out of memory: counts are lost */
+    if (instrumentation_local) return instrumentation_local;
+    BlocThread *b = (BlocThread *)calloc(1, sizeof(BlocThread));
+    if (!b) return poubelle;
+    pthread_once(&cle_creee, creer_cle);
+    pthread_mutex_lock(&verrou);
+    b->suivant = blocs;
+    blocs = b;
+    pthread_mutex_unlock(&verrou);
+    pthread_setspecific(cle_thread, b);
+    instrumentation_local = b->compteurs;
+    return instrumentation_local;
+}
+
+/* ---------- hardware counters ---------- */
+
+#ifdef __linux__
+static int ouvrir_compteur(CompteurMateriel c) {
+    static const unsigned long long configs[NB_COMPTEURS_MATERIELS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof attr;
+    attr.config = configs[c];
+    attr.disabled = 1;
+    attr.inherit = 1; /* threads created later are counted too */
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    return fd;
+}
+
+static long long lire_compteur(int fd) {
+    long long valeur = 0;
+    if (fd < 0 || read(fd, &valeur, sizeof valeur) != (ssize_t)sizeof valeur) return 0;
+    return valeur;
+}
+
+static void fermer_compteur(int fd) {
+    close(fd);
+}
+#else
+static int ouvrir_compteur(CompteurMateriel c) {
+    (void)c;
+    return -1;
+}
+static long long lire_compteur(int fd) {
+    (void)fd;
+    return 0;
+}
+static void fermer_compteur(int fd) {
+    (void)fd;
+}
+#endif
+
+static void lire_materiel(long long *valeurs) {
+    for (int c = 0; c < NB_COMPTEURS_MATERIELS; ++c) valeurs[c] = lire_compteur(descripteurs[c]);
+}
+
+int instrumentation_activer_materiel(void) {
+    int nb = 0;
+    for (int c = 0; c < NB_COMPTEURS_MATERIELS; ++c) {
+        if (descripteurs[c] < 0) descripteurs[c] = ouvrir_compteur((CompteurMateriel)c);
+        if (descripteurs[c] >= 0) nb++;
+        base_materiel[c] = lire_compteur(descripteurs[c]);
+    }
+    return nb;
+}
+
+void instrumentation_desactiver_materiel(void) {
+    for (int c = 0; c < NB_COMPTEURS_MATERIELS; ++c) {
+        if (descripteurs[c] >= 0) fermer_compteur(descripteurs[c]);
+        descripteurs[c] = -1;
+        base_materiel[c] = 0;
+    }
+}
+
+/* ---------- phases ---------- */
+
+InstrPhase instrumentation_phase_debut(const char *nom) {
+    InstrPhase p;
+    p.indice = -1;
+    pthread_mutex_lock(&verrou);
+    for (int i = 0; i < nb_phases; ++i) {
+        if (phases[i].nom == nom || !strcmp(phases[i].nom, nom)) {
+            p.indice = i;
+            break;
+        }
+    }
+    if (p.indice < 0 && nb_phases < INSTRUMENTATION_PHASES_MAX) {
+        p.indice = nb_phases++;
+        memset(&phases[p.indice], 0, sizeof(StatsPhase));
+        phases[p.indice].nom = nom;
+    }
+    pthread_mutex_unlock(&verrou);
+    lire_materiel(p.materiel);
+    p.debut = instrumentation_horloge();
+    return p;
+}
+
+void instrumentation_phase_fin(InstrPhase *p) {
+    double fin = instrumentation_horloge();
+    long long materiel[NB_COMPTEURS_MATERIELS];
+    lire_materiel(materiel);
+    if (p->indice < 0) return;
+    pthread_mutex_lock(&verrou);
+    StatsPhase *s = &phases[p->indice];
+    s->appels++;
+    s->secondes += fin - p->debut;
+    for (int c = 0; c < NB_COMPTEURS_MATERIELS; ++c) s->materiel[c] += materiel[c] - p->materiel[c];
+    pthread_mutex_unlock(&verrou);
+}
+
+/* ---------- counted allocations ---------- */
+
+static void compter_allocation(size_t taille) {
+    long long *c = instrumentation_compteurs_thread();
+    c[STAT_ALLOCATIONS]++;
+    c[STAT_OCTETS_ALLOUES] += (long long)taille;
+}
+
+void *instrumentation_malloc(size_t taille) {
+    compter_allocation(taille);
+    return malloc(taille);
+}
+
+void *instrumentation_calloc(size_t nb, size_t taille) {
+    compter_allocation(nb * taille);
+    return calloc(nb, taille);
+}
+
+void *instrumentation_realloc(void *p, size_t taille) {
+    compter_allocation(taille);
+    return realloc(p, taille);
+}
+
+void *instrumentation_aligned_alloc(size_t alignement, size_t taille) {
+    compter_allocation(taille);
+#ifdef _WIN32
+    return _aligned_malloc(taille, alignement);
+#else
+    return aligned_alloc(alignement, taille);
+#endif
+}
+
+/* ---------- query / reset ---------- */
+
+void instrumentation_lire(StatsGraphe *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof *stats);
+#ifdef GRAPHE_INSTRUMENTATION
+    stats->compilee = 1;
+#endif
+    pthread_mutex_lock(&verrou);
+    for (int i = 0; i < NB_STATS; ++i) stats->compteurs[i] = retires[i];
+    for (BlocThread *b = blocs; b; b = b->suivant)
+        for (int i = 0; i < NB_STATS; ++i) stats->compteurs[i] += b->compteurs[i];
+    stats->nb_phases = nb_phases;
+    memcpy(stats->phases, phases, (size_t)nb_phases * sizeof(StatsPhase));
+    pthread_mutex_unlock(&verrou);
+    for (int c = 0; c < NB_COMPTEURS_MATERIELS; ++c) {
+        stats->materiel_actif[c] = descripteurs[c] >= 0;
+        if (descripteurs[c] >= 0) stats->materiel[c] = lire_compteur(descripteurs[c]) - base_materiel[c];
+    }
+}
+
+void instrumentation_reinitialiser(void) {
+    pthread_mutex_lock(&verrou);
+    memset(retires, 0, sizeof retires);
+    for (BlocThread *b = blocs; b; b = b->suivant) memset(b->compteurs, 0, sizeof b->compteurs);
+    nb_phases = 0;
+    pthread_mutex_unlock(&verrou);
+    lire_materiel(base_materiel);
+}
+
+void instrumentation_afficher(const StatsGraphe *stats, FILE *f) {
+    if (!stats || !f) return;
+    if (!stats->compilee) fprintf(f, "(built without GRAPHE_INSTRUMENTATION)\n");
+    for (int i = 0; i < NB_STATS; ++i)
+        fprintf(f, "%-18s %14lld\n", noms_stats[i], stats->compteurs[i]);
+    for (int c = 0; c < NB_COMPTEURS_MATERIELS; ++c) {
+        if (stats->materiel_actif[c]) fprintf(f, "%-18s %14lld\n", noms_materiels[c], stats->materiel[c]);
+        else fprintf(f, "%-18s %14s\n", noms_materiels[c], "n/a");
+    }
+    for (int i = 0; i < stats->nb_phases; ++i) {
+        const StatsPhase *p = &stats->phases[i];
+        fprintf(f, "%-44s %8lld calls %12.3f ms", p->nom, p->appels, 1e3 * p->secondes);
+        for (int c = 0; c < NB_COMPTEURS_MATERIELS; ++c)
+            if (stats->materiel_actif[c]) fprintf(f, " %s %lld", noms_materiels[c], p->materiel[c]);
+        fprintf(f, "\n");
+    }
+}
+
+const char *instrumentation_nom_stat(CompteurStat c) {
+    return (int)c >= 0 && c < NB_STATS ? noms_stats[c] : "?";
+}
+
+const char *instrumentation_nom_materiel(CompteurMateriel c) {
+    return (int)c >= 0 && c < NB_COMPTEURS_MATERIELS ? noms_materiels[c] : "?";
+}
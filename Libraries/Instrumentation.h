@@ -0,0 +1,118 @@
+/* Instrumentation.h */
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/* Optional counters on the hot paths of the libraries and algorithms.
+   Everything below INSTR_* compiles to nothing unless the sources are
+   built with -DGRAPHE_INSTRUMENTATION; the functions always exist (and
+   report zeros) so that callers need no #ifdef.
+
+   Event counters are kept per thread, without atomics, and summed by
+   instrumentation_lire (the threads of parallele_executer fold theirs
+   in when they exit). Each algorithm of Algorithms/ times itself and
+   its main steps as named phases ("dijkstra_csr", "delta_stepping/gel",
+   ...). On Linux, instrumentation_activer_materiel opens cycle, LLC miss
+   and branch miss counters with perf_event_open for the calling thread
+   and the threads it creates afterwards; their values since the last
+   reset, and their deltas inside each phase, are reported as well. */
+
+typedef enum {
+    STAT_ARCS_PARCOURUS = 0, /* arcs looked at by a traversal */
+    STAT_RELAXATIONS,        /* tentative distances improved */
+    STAT_TAS_INSERTIONS,     /* FilePriorite insertions */
+    STAT_TAS_DIMINUTIONS,    /* FilePriorite decrease-key */
+    STAT_TAS_EXTRACTIONS,    /* FilePriorite extract-min */
+    STAT_ALLOCATIONS,        /* malloc / calloc / realloc in Libraries/ */
+    STAT_OCTETS_ALLOUES,     /* bytes requested by those calls */
+    NB_STATS
+} CompteurStat;
+
+typedef enum {
+    MATERIEL_CYCLES = 0,
+    MATERIEL_INSTRUCTIONS,
+    MATERIEL_DEFAUTS_LLC,     /* last level cache misses */
+    MATERIEL_DEFAUTS_BRANCHES,
+    NB_COMPTEURS_MATERIELS
+} CompteurMateriel;
+
+#define INSTRUMENTATION_PHASES_MAX 64
+
+typedef struct {
+    const char *nom;
+    long long appels;
+    double secondes;                           /* wall time, all calls */
+    long long materiel[NB_COMPTEURS_MATERIELS]; /* deltas, all calls */
+} StatsPhase;
+
+typedef struct {
+    int compilee;                               /* built with GRAPHE_INSTRUMENTATION */
+    long long compteurs[NB_STATS];
+    int nb_phases;
+    StatsPhase phases[INSTRUMENTATION_PHASES_MAX]; /* in order of first use */
+    int materiel_actif[NB_COMPTEURS_MATERIELS];    /* counter opened */
+    long long materiel[NB_COMPTEURS_MATERIELS];    /* since the last reset */
+} StatsGraphe;
+
+/* Query / reset (reset while no instrumented call is running) */
+void instrumentation_lire(StatsGraphe *stats);
+void instrumentation_reinitialiser(void);
+void instrumentation_afficher(const StatsGraphe *stats, FILE *f);
+const char *instrumentation_nom_stat(CompteurStat c);
+const char *instrumentation_nom_materiel(CompteurMateriel c);
+double instrumentation_horloge(void); /* wall clock in seconds, the one of the phases */
+
+/* Hardware counters; returns the number of counters opened (0 when
+   perf_event_open is missing or forbidden, see perf_event_paranoid) */
+int  instrumentation_activer_materiel(void);
+void instrumentation_desactiver_materiel(void);
+
+/* Used by the macros below */
+typedef struct {
+    int indice;
+    double debut;
+    long long materiel[NB_COMPTEURS_MATERIELS];
+} InstrPhase;
+
+long long *instrumentation_compteurs_thread(void);
+InstrPhase instrumentation_phase_debut(const char *nom);
+void instrumentation_phase_fin(InstrPhase *phase);
+void *instrumentation_malloc(size_t taille);
+void *instrumentation_calloc(size_t nb, size_t taille);
+void *instrumentation_realloc(void *p, size_t taille);
+void *instrumentation_aligned_alloc(size_t alignement, size_t taille);
+
+#ifdef GRAPHE_INSTRUMENTATION
+
+extern _Thread_local long long *instrumentation_local;
+
+/* this thread's counters */
+static inline long long *instr_compteurs(void) {
+    long long *c = instrumentation_local;
+    return c ? c : instrumentation_compteurs_thread();
+}
+
+#define INSTR_COMPTER(stat, n)   (instr_compteurs()[stat] += (n))
+#define INSTR_PHASE_DEBUT(h, nom) InstrPhase h = instrumentation_phase_debut(nom)
+#define INSTR_PHASE_FIN(h)       instrumentation_phase_fin(&(h))
+
+/* A library source that defines INSTRUMENTATION_ALLOCATIONS before
+   including this header has its allocations counted */
+#ifdef INSTRUMENTATION_ALLOCATIONS
+#define malloc(t)           instrumentation_malloc(t)
+#define calloc(n, t)        instrumentation_calloc(n, t)
+#define realloc(p, t)       instrumentation_realloc(p, t)
+#define aligned_alloc(a, t) instrumentation_aligned_alloc(a, t)
+#endif
+
+#else
+
+#define INSTR_COMPTER(stat, n)    ((void)0)
+#define INSTR_PHASE_DEBUT(h, nom) ((void)0)
+#define INSTR_PHASE_FIN(h)        ((void)0)
+
+#endif /* GRAPHE_INSTRUMENTATION */
+
+#endif /* INSTRUMENTATION_H */
@@ -0,0 +1,30 @@
+/* Octets.h */
+#ifndef OCTETS_H
+#define OCTETS_H
+
+#include <stdint.h>
+
+/* Little-endian integers in byte buffers, whatever the host byte order:
+   the on-disk layout of the binary graph and hierarchy files. */
+
+static inline void octets_poser_u32(unsigned char *p, uint32_t x) {
+    for (int i = 0; i < 4; ++i) p[i] = (unsigned char)(x >> (8 * i));
+}
+
+static inline void octets_poser_u64(unsigned char *p, uint64_t x) {
+    for (int i = 0; i < 8; ++i) p[i] = (unsigned char)(x >> (8 * i));
+}
+
+static inline uint32_t octets_lire_u32(const unsigned char *p) {
+    uint32_t x = 0;
+    for (int i = 0; i < 4; ++i) x |= (uint32_t)p[i] << (8 * i);
+    return x;
+}
+
+static inline uint64_t octets_lire_u64(const unsigned char *p) {
+    uint64_t x = 0;
+    for (int i = 0; i < 8; ++i) x |= (uint64_t)p[i] << (8 * i);
+    return x;
+}
+
+#endif /* OCTETS_H */
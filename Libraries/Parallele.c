@@ -0,0 +1,272 @@
+/* Parallele.c */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "Parallele.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/* Threads only start working once all of them exist, so a failed
+   pthread_create never leaves the others waiting on a barrier */
+typedef struct {
+    pthread_mutex_t verrou;
+    pthread_cond_t depart;
+    int etat; /* 0 = waiting, 1 = go, -1 = abort */
+} Portillon;
+
+typedef struct {
+    TacheParallele tache;
+    void *arg;
+    int id;
+    int nb;
+    Portillon *portillon;
+} ArgThread;
+
+static void *lancer(void *p) {
+    ArgThread *a = (ArgThread *)p;
+    Portillon *port = a->portillon;
+    pthread_mutex_lock(&port->verrou);
+    while (port->etat == 0)
+        pthread_cond_wait(&port->depart, &port->verrou);
+    int go = port->etat == 1;
+    pthread_mutex_unlock(&port->verrou);
+    if (go) a->tache(a->id, a->nb, a->arg);
+    return NULL;
+}
+
+/* PUBLIC API */
+
+int parallele_nb_threads_defaut(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int n = (int)info.dwNumberOfProcessors;
+#else
+    int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return n > 0 ? n : 1;
+}
+
+int parallele_resoudre_nb_threads(int nb_threads) {
+    return nb_threads > 0 ? nb_threads : parallele_nb_threads_defaut();
+}
+
+int parallele_prendre_bloc(int *compteur, int n, int taille_bloc, int *debut, int *fin) {
+    int d = __atomic_fetch_add(compteur, taille_bloc, __ATOMIC_RELAXED);
+    if (d >= n) return 0;
+    *debut = d;
+    *fin = d + taille_bloc < n ? d + taille_bloc : n;
+    return 1;
+}
+
+int parallele_executer(int nb_threads, TacheParallele tache, void *arg) {
+    if (!tache) return 0;
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+    if (nb_threads == 1) {
+        tache(0, 1, arg);
+        return 1;
+    }
+
+    pthread_t *threads = (pthread_t *)malloc(nb_threads * sizeof(pthread_t));
+    ArgThread *args = (ArgThread *)malloc(nb_threads * sizeof(ArgThread));
+    if (!threads || !args) {
+        free(threads);
+        free(args);
+        return 0;
+    }
+
+    Portillon port;
+    pthread_mutex_init(&port.verrou, NULL);
+    pthread_cond_init(&port.depart, NULL);
+    port.etat = 0;
+
+    int lances = 1;
+    for (int i = 0; i < nb_threads; ++i) {
+        args[i].tache = tache;
+        args[i].arg = arg;
+        args[i].id = i;
+        args[i].nb = nb_threads;
+        args[i].portillon = &port;
+    }
+    for (int i = 1; i < nb_threads; ++i) {
+        if (pthread_create(&threads[i], NULL, lancer, &args[i]) != 0) break;
+        lances++;
+    }
+    int ok = lances == nb_threads;
+
+    pthread_mutex_lock(&port.verrou);
+    port.etat = ok ? 1 : -1;
+    pthread_cond_broadcast(&port.depart);
+    pthread_mutex_unlock(&port.verrou);
+
+    if (ok) tache(0, nb_threads, arg);
+    for (int i = 1; i < lances; ++i)
+        pthread_join(threads[i], NULL);
+
+    pthread_cond_destroy(&port.depart);
+    pthread_mutex_destroy(&port.verrou);
+    free(threads);
+    free(args);
+    return ok;
+}
+
+int parallele_barriere_init(BarriereParallele *b, int nb) {
+    if (!b || nb <= 0) return 0;
+    if (pthread_mutex_init(&b->verrou, NULL) != 0) return 0;
+    if (pthread_cond_init(&b->cond, NULL) != 0) {
+        pthread_mutex_destroy(&b->verrou);
+        return 0;
+    }
+    b->nb = nb;
+    b->arrives = 0;
+    b->generation = 0;
+    return 1;
+}
+
+void parallele_barriere_attendre(BarriereParallele *b) {
+    pthread_mutex_lock(&b->verrou);
+    unsigned generation = b->generation;
+    if (++b->arrives == b->nb) {
+        b->arrives = 0;
+        b->generation++;
+        pthread_cond_broadcast(&b->cond);
+    } else {
+        while (generation == b->generation)
+            pthread_cond_wait(&b->cond, &b->verrou);
+    }
+    pthread_mutex_unlock(&b->verrou);
+}
+
+void parallele_barriere_detruire(BarriereParallele *b) {
+    if (!b) return;
+    pthread_cond_destroy(&b->cond);
+    pthread_mutex_destroy(&b->verrou);
+}
+
+/* ---------- Thread pool ---------- */
+
+struct PoolThreads {
+    int nb;
+    pthread_t *threads;   /* nb - 1 workers, the caller is thread 0 */
+    ArgThread *args;
+    pthread_mutex_t verrou;
+    pthread_cond_t travail; /* new task or stop */
+    pthread_cond_t termine; /* last worker done with the task */
+    TacheParallele tache;
+    void *arg;
+    unsigned generation;    /* tasks started so far */
+    int en_cours;           /* workers still on the current task */
+    int arret;
+};
+
+static void *travailleur(void *p) {
+    ArgThread *a = (ArgThread *)p;
+    PoolThreads *pool = (PoolThreads *)a->arg;
+    unsigned vue = 0;
+    pthread_mutex_lock(&pool->verrou);
+    for (;;) {
+        while (!pool->arret && pool->generation == vue)
+            pthread_cond_wait(&pool->travail, &pool->verrou);
+        if (pool->arret) break;
+        vue = pool->generation;
+        TacheParallele tache = pool->tache;
+        void *arg = pool->arg;
+        pthread_mutex_unlock(&pool->verrou);
+        tache(a->id, a->nb, arg);
+        pthread_mutex_lock(&pool->verrou);
+        if (--pool->en_cours == 0) pthread_cond_signal(&pool->termine);
+    }
+    pthread_mutex_unlock(&pool->verrou);
+    return NULL;
+}
+
+/* Stops and joins the first nb_lances workers */
+static void arreter(PoolThreads *p, int nb_lances) {
+    pthread_mutex_lock(&p->verrou);
+    p->arret = 1;
+    pthread_cond_broadcast(&p->travail);
+    pthread_mutex_unlock(&p->verrou);
+    for (int i = 1; i <= nb_lances; ++i)
+        pthread_join(p->threads[i], NULL);
+}
+
+PoolThreads *pool_threads_creer(int nb_threads) {
+    if (nb_threads <= 0) nb_threads = parallele_nb_threads_defaut();
+    PoolThreads *p = (PoolThreads *)calloc(1, sizeof(PoolThreads));
+    if (!p) return NULL;
+    p->nb = nb_threads;
+    p->threads = (pthread_t *)malloc(nb_threads * sizeof(pthread_t));
+    p->args = (ArgThread *)malloc(nb_threads * sizeof(ArgThread));
+    if (!p->threads || !p->args || pthread_mutex_init(&p->verrou, NULL) != 0) {
+        free(p->threads);
+        free(p->args);
+        free(p);
+        return NULL;
+    }
+    pthread_cond_init(&p->travail, NULL);
+    pthread_cond_init(&p->termine, NULL);
+
+    int lances = 0;
+    for (int i = 1; i < nb_threads; ++i) {
+        p->args[i].tache = NULL;
+        p->args[i].arg = p;
+        p->args[i].id = i;
+        p->args[i].nb = nb_threads;
+        p->args[i].portillon = NULL;
+        if (pthread_create(&p->threads[i], NULL, travailleur, &p->args[i]) != 0) break;
+        lances++;
+    }
+    if (lances != nb_threads - 1) {
+        arreter(p, lances);
+        pthread_cond_destroy(&p->termine);
+        pthread_cond_destroy(&p->travail);
+        pthread_mutex_destroy(&p->verrou);
+        free(p->threads);
+        free(p->args);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+void pool_threads_detruire(PoolThreads *p) {
+    if (!p) return;
+    arreter(p, p->nb - 1);
+    pthread_cond_destroy(&p->termine);
+    pthread_cond_destroy(&p->travail);
+    pthread_mutex_destroy(&p->verrou);
+    free(p->threads);
+    free(p->args);
+    free(p);
+}
+
+int pool_threads_taille(const PoolThreads *p) {
+    return p ? p->nb : parallele_nb_threads_defaut();
+}
+
+int pool_threads_executer(PoolThreads *p, TacheParallele tache, void *arg) {
+    if (!p) return parallele_executer(0, tache, arg);
+    if (!tache) return 0;
+    if (p->nb > 1) {
+        pthread_mutex_lock(&p->verrou);
+        p->tache = tache;
+        p->arg = arg;
+        p->en_cours = p->nb - 1;
+        p->generation++;
+        pthread_cond_broadcast(&p->travail);
+        pthread_mutex_unlock(&p->verrou);
+    }
+    tache(0, p->nb, arg);
+    if (p->nb > 1) {
+        pthread_mutex_lock(&p->verrou);
+        while (p->en_cours > 0)
+            pthread_cond_wait(&p->termine, &p->verrou);
+        pthread_mutex_unlock(&p->verrou);
+    }
+    return 1;
+}
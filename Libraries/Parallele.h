@@ -0,0 +1,64 @@
+/* Parallele.h */
+#ifndef PARALLELE_H
+#define PARALLELE_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+/* Minimal fork/join helper on top of POSIX threads.
+   tache(id, nb, arg) runs once on each of nb threads, id in 0 .. nb-1;
+   the calling thread takes id 0. */
+
+typedef void (*TacheParallele)(int id_thread, int nb_threads, void *arg);
+
+int parallele_nb_threads_defaut(void); /* online processors, at least 1 */
+int parallele_resoudre_nb_threads(int nb_threads); /* nb_threads, or the default when <= 0 */
+int parallele_executer(int nb_threads, TacheParallele tache, void *arg); /* 1 = ok */
+
+/* Threads pick blocks of [0, n) from a shared counter, so that a thread
+   stuck on a few costly items does not hold the others back: the next
+   [*debut, *fin) of at most taille_bloc items, 0 once all are taken */
+int parallele_prendre_bloc(int *compteur, int n, int taille_bloc, int *debut, int *fin);
+
+/* *cible = min(*cible, x) against concurrent writers (relaxed order) */
+static inline void parallele_min_atomique(int *cible, int x) {
+    int ancien = __atomic_load_n(cible, __ATOMIC_RELAXED);
+    while (x < ancien &&
+           !__atomic_compare_exchange_n(cible, &ancien, x, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+static inline void parallele_min_atomique_u64(uint64_t *cible, uint64_t x) {
+    uint64_t ancien = __atomic_load_n(cible, __ATOMIC_RELAXED);
+    while (x < ancien &&
+           !__atomic_compare_exchange_n(cible, &ancien, x, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+/* Reusable barrier for the nb threads of one parallele_executer call
+   (pthread_barrier_t is optional in POSIX and missing on some platforms) */
+typedef struct {
+    pthread_mutex_t verrou;
+    pthread_cond_t cond;
+    int nb;
+    int arrives;
+    unsigned generation;
+} BarriereParallele;
+
+int  parallele_barriere_init(BarriereParallele *b, int nb); /* 1 = ok */
+void parallele_barriere_attendre(BarriereParallele *b);
+void parallele_barriere_detruire(BarriereParallele *b);
+
+/* Persistent workers for callers that start many parallel tasks:
+   pool_threads_executer has the contract of parallele_executer but the
+   nb - 1 helper threads are created once and sleep between tasks.
+   One task at a time per pool. A NULL pool runs the task through
+   parallele_executer with one thread per processor. */
+typedef struct PoolThreads PoolThreads;
+
+PoolThreads *pool_threads_creer(int nb_threads); /* <= 0: one per processor, NULL on error */
+void pool_threads_detruire(PoolThreads *p);
+int  pool_threads_taille(const PoolThreads *p);   /* threads a task runs on, caller included */
+int  pool_threads_executer(PoolThreads *p, TacheParallele tache, void *arg); /* 1 = ok */
+
+#endif /* PARALLELE_H */
@@ -0,0 +1,100 @@
+/* PoolArcs.c */
+#include <stdio.h>
+#include <stdlib.h>
+#include "PoolArcs.h"
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+#define BLOC_MIN 64      /* nodes in the first block */
+#define BLOC_MAX 65536   /* nodes per block once the pool is large */
+
+/* Block header, padded so that the nodes that follow are suitably aligned */
+struct BlocPool {
+    union {
+        BlocPool *suivant;
+        long double alignement;
+        void *p;
+    } u;
+};
+
+static size_t arrondir(size_t taille) {
+    size_t a = sizeof(void *);
+    if (taille < a) taille = a; /* a released node stores the free-list link */
+    return (taille + a - 1) / a * a;
+}
+
+static int nouveau_bloc(PoolArcs *p, size_t nb) {
+    size_t octets = sizeof(BlocPool) + nb * p->taille_elem;
+    BlocPool *b = (BlocPool *)malloc(octets);
+    if (!b) return 0;
+    b->u.suivant = p->blocs;
+    p->blocs = b;
+    p->courant = (char *)(b + 1);
+    p->fin = p->courant + nb * p->taille_elem;
+    p->stats.appels_malloc++;
+    p->stats.octets += octets;
+    if (p->taille_bloc < BLOC_MAX) p->taille_bloc *= 2;
+    return 1;
+}
+
+/* PUBLIC API */
+
+void pool_arcs_init(PoolArcs *p, size_t taille_elem) {
+    if (!p) return;
+    p->taille_elem = arrondir(taille_elem);
+    p->taille_bloc = BLOC_MIN;
+    p->blocs = NULL;
+    p->courant = NULL;
+    p->fin = NULL;
+    p->libres = NULL;
+    p->stats.allocations = 0;
+    p->stats.liberations = 0;
+    p->stats.recyclages = 0;
+    p->stats.appels_malloc = 0;
+    p->stats.octets = 0;
+}
+
+void pool_arcs_vider(PoolArcs *p) {
+    if (!p) return;
+    BlocPool *b = p->blocs;
+    while (b) {
+        BlocPool *tmp = b;
+        b = b->u.suivant;
+        free(tmp);
+    }
+    p->blocs = NULL;
+    p->courant = NULL;
+    p->fin = NULL;
+    p->libres = NULL;
+    p->taille_bloc = BLOC_MIN;
+    p->stats.octets = 0;
+}
+
+void *pool_arcs_allouer(PoolArcs *p) {
+    if (!p) return NULL;
+    void *elem;
+    if (p->libres) {
+        elem = p->libres;
+        p->libres = *(void **)elem;
+        p->stats.recyclages++;
+    } else {
+        if (p->courant == p->fin && !nouveau_bloc(p, p->taille_bloc)) return NULL;
+        elem = p->courant;
+        p->courant += p->taille_elem;
+    }
+    p->stats.allocations++;
+    return elem;
+}
+
+void pool_arcs_liberer(PoolArcs *p, void *elem) {
+    if (!p || !elem) return;
+    *(void **)elem = p->libres;
+    p->libres = elem;
+    p->stats.liberations++;
+}
+
+int pool_arcs_reserver(PoolArcs *p, size_t nb) {
+    if (!p) return 0;
+    if ((size_t)(p->fin - p->courant) / p->taille_elem >= nb) return 1;
+    return nouveau_bloc(p, nb > p->taille_bloc ? nb : p->taille_bloc);
+}
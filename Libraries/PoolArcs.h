@@ -0,0 +1,44 @@
+/* PoolArcs.h */
+#ifndef POOL_ARCS_H
+#define POOL_ARCS_H
+
+#include <stddef.h>
+
+/* Slab allocator for fixed-size adjacency nodes.
+   Nodes are carved out of large blocks in allocation order, released
+   nodes go to a free list, and the whole pool is returned to the system
+   at once (one free per block, never one per node). */
+
+typedef struct BlocPool BlocPool;
+
+typedef struct {
+    long allocations;   /* nodes handed out */
+    long liberations;   /* nodes given back to the free list */
+    long recyclages;    /* allocations served from the free list */
+    long appels_malloc; /* blocks obtained from malloc */
+    size_t octets;      /* bytes currently reserved from malloc */
+} StatsPool;
+
+typedef struct {
+    size_t taille_elem;    /* bytes per node */
+    size_t taille_bloc;    /* nodes in the next block (grows geometrically) */
+    BlocPool *blocs;       /* all blocks, most recent first */
+    char *courant;         /* next unused node of the most recent block */
+    char *fin;             /* end of the most recent block */
+    void *libres;          /* free list threaded through released nodes */
+    StatsPool stats;
+} PoolArcs;
+
+/* Creation / destruction (the pool itself is usually embedded in a graph) */
+void pool_arcs_init(PoolArcs *p, size_t taille_elem);
+void pool_arcs_vider(PoolArcs *p); /* releases every node and block */
+
+/* Nodes */
+void *pool_arcs_allouer(PoolArcs *p);
+void  pool_arcs_liberer(PoolArcs *p, void *elem);
+
+/* Makes the next nb allocations contiguous (one block, in allocation
+   order) as long as the free list is empty; 1 = ok */
+int pool_arcs_reserver(PoolArcs *p, size_t nb);
+
+#endif /* POOL_ARCS_H */
@@ -0,0 +1,104 @@
+/* UnionFind.c */
+#include <stdio.h>
+#include <stdlib.h>
+#include "UnionFind.h"
+#define INSTRUMENTATION_ALLOCATIONS
+#include "Instrumentation.h"
+
+static int agrandir(UnionFind *uf, int capacite) {
+    int *parent = (int *)realloc(uf->parent, (size_t)capacite * sizeof(int));
+    if (!parent) return 0;
+    uf->parent = parent;
+    unsigned char *rang = (unsigned char *)realloc(uf->rang, (size_t)capacite);
+    if (!rang) return 0;
+    uf->rang = rang;
+    uf->capacite = capacite;
+    return 1;
+}
+
+/* PUBLIC API */
+
+UnionFind *union_find_creer(int nb) {
+    if (nb < 0) return NULL;
+    UnionFind *uf = (UnionFind *)malloc(sizeof(UnionFind));
+    if (!uf) return NULL;
+    uf->parent = NULL;
+    uf->rang = NULL;
+    uf->nb = 0;
+    uf->capacite = 0;
+    uf->nb_classes = 0;
+    if (!union_find_reinitialiser(uf, nb)) {
+        union_find_detruire(uf);
+        return NULL;
+    }
+    return uf;
+}
+
+void union_find_detruire(UnionFind *uf) {
+    if (!uf) return;
+    free(uf->parent);
+    free(uf->rang);
+    free(uf);
+}
+
+int union_find_reinitialiser(UnionFind *uf, int nb) {
+    if (!uf || nb < 0) return 0;
+    if (nb > uf->capacite && !agrandir(uf, nb > 0 ? nb : 1)) return 0;
+    for (int x = 0; x < nb; ++x) {
+        uf->parent[x] = x;
+        uf->rang[x] = 0;
+    }
+    uf->nb = nb;
+    uf->nb_classes = nb;
+    return 1;
+}
+
+int union_find_ajouter(UnionFind *uf) {
+    if (!uf) return -1;
+    if (uf->nb == uf->capacite && !agrandir(uf, uf->capacite > 0 ? 2 * uf->capacite : 16))
+        return -1;
+    int x = uf->nb++;
+    uf->parent[x] = x;
+    uf->rang[x] = 0;
+    uf->nb_classes++;
+    return x;
+}
+
+int union_find_trouver(UnionFind *uf, int x) {
+    if (!uf || x < 0 || x >= uf->nb) return -1;
+    int r = x;
+    while (uf->parent[r] != r) r = uf->parent[r];
+    /* second pass: every vertex of the path now points to the root */
+    while (uf->parent[x] != r) {
+        int suivant = uf->parent[x];
+        uf->parent[x] = r;
+        x = suivant;
+    }
+    return r;
+}
+
+int union_find_unir(UnionFind *uf, int a, int b) {
+    int ra = union_find_trouver(uf, a);
+    int rb = union_find_trouver(uf, b);
+    if (ra < 0 || rb < 0 || ra == rb) return 0;
+    /* the shallower tree goes under the deeper one */
+    if (uf->rang[ra] < uf->rang[rb]) {
+        int t = ra;
+        ra = rb;
+        rb = t;
+    }
+    uf->parent[rb] = ra;
+    if (uf->rang[ra] == uf->rang[rb]) uf->rang[ra]++;
+    uf->nb_classes--;
+    return 1;
+}
+
+int union_find_meme_classe(UnionFind *uf, int a, int b) {
+    int ra = union_find_trouver(uf, a);
+    return ra >= 0 && ra == union_find_trouver(uf, b);
+}
+
+int union_find_nb_classes(const UnionFind *uf) {
+    if (!uf) return 0;
+    return uf->nb_classes;
+}
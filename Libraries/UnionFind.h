@@ -0,0 +1,28 @@
+/* UnionFind.h */
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+/* Disjoint sets on 0 .. nb-1 with union by rank and path compression:
+   every operation is O(alpha(n)) amortized, i.e. constant in practice. */
+
+typedef struct {
+    int nb;            /* elements */
+    int capacite;
+    int nb_classes;    /* current number of sets */
+    int *parent;       /* parent[x] = x for a representative */
+    unsigned char *rang;
+} UnionFind;
+
+/* Creation / destruction, nb singletons */
+UnionFind *union_find_creer(int nb);
+void union_find_detruire(UnionFind *uf);
+int  union_find_reinitialiser(UnionFind *uf, int nb); /* back to nb singletons, 1 = ok */
+int  union_find_ajouter(UnionFind *uf);               /* new singleton, -1 if out of memory */
+
+/* Operations */
+int union_find_trouver(UnionFind *uf, int x); /* representative, -1 if out of range */
+int union_find_unir(UnionFind *uf, int a, int b); /* 1 if two sets were merged */
+int union_find_meme_classe(UnionFind *uf, int a, int b);
+int union_find_nb_classes(const UnionFind *uf);
+
+#endif /* UNION_FIND_H */